@@ -99,6 +99,7 @@
 
 static int system_has_forkfd(void);
 static int system_forkfd(int flags, pid_t *ppid, int *system);
+static int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system);
 static int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdwoptions, struct rusage *rusage);
 
 static int disable_fork_fallback(void)
@@ -764,6 +765,46 @@ err_free:
     freeInfo(header, info);
     return -1;
 }
+
+/**
+ * @brief vforkfd runs @a childFn in a child process and returns a file
+ * descriptor representing it
+ * @return a file descriptor, or -1 in case of failure
+ *
+ * vforkfd() works like forkfd(), except that instead of returning in the
+ * child process, it calls @a childFn with @a token as its only parameter and
+ * exits the child with that function's return value. It never returns
+ * @c FFD_CHILD_PROCESS.
+ *
+ * Where supported, the child shares the parent's memory and the calling thread
+ * is suspended until the child calls execve(2) or exits, like with vfork(2).
+ * This avoids copying the parent's page tables, which can be expensive for
+ * large processes. Therefore, @a childFn must only modify its own stack and
+ * must only call async-signal-safe functions. Signal handlers are reset to
+ * their default actions in the child before @a childFn runs.
+ *
+ * If the system does not support it, or if @c FFD_USE_FORK is passed in @a
+ * flags, this function falls back to forkfd() and calls @a childFn in the
+ * forked child.
+ */
+int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    int fd;
+    if (disable_fork_fallback())
+        flags &= ~FFD_USE_FORK;
+
+    if ((flags & FFD_USE_FORK) == 0) {
+        int system;
+        fd = system_vforkfd(flags, ppid, childFn, token, &system);
+        if (system || disable_fork_fallback())
+            return fd;
+    }
+
+    fd = forkfd(flags, ppid);
+    if (fd == FFD_CHILD_PROCESS)
+        _exit(childFn(token));
+    return fd;
+}
 #endif // FORKFD_NO_FORKFD
 
 #if _POSIX_SPAWN > 0 && !defined(FORKFD_NO_SPAWNFD)
@@ -880,6 +921,16 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     return -1;
 }
 
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    (void)flags;
+    (void)ppid;
+    (void)childFn;
+    (void)token;
+    *system = 0;
+    return -1;
+}
+
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int options, struct rusage *rusage)
 {
     (void)ffd;
@@ -85,6 +85,15 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     return ret;
 }
 
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    /* there's no pdvfork(2), so this can't share the address space */
+    int ret = system_forkfd(flags, ppid, system);
+    if (ret == FFD_CHILD_PROCESS)
+        _exit(childFn(token));
+    return ret;
+}
+
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdoptions, struct rusage *rusage)
 {
     pid_t pid;
@@ -36,6 +36,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
@@ -131,16 +132,33 @@ int system_has_forkfd()
     return ffd_atomic_load(&system_forkfd_state, FFD_ATOMIC_RELAXED) > 0;
 }
 
-int system_forkfd(int flags, pid_t *ppid, int *system)
+static int system_forkfd_availability(void)
 {
-    pid_t pid;
-    int pidfd;
-
     int state = ffd_atomic_load(&system_forkfd_state, FFD_ATOMIC_RELAXED);
     if (state == 0) {
         state = detect_clone_pidfd_support();
         ffd_atomic_store(&system_forkfd_state, state, FFD_ATOMIC_RELAXED);
     }
+    return state;
+}
+
+static int system_forkfd_pidfd_set_flags(int pidfd, int flags)
+{
+    if ((flags & FFD_CLOEXEC) == 0) {
+        /* pidfd defaults to O_CLOEXEC */
+        fcntl(pidfd, F_SETFD, 0);
+    }
+    if (flags & FFD_NONBLOCK)
+        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
+    return pidfd;
+}
+
+int system_forkfd(int flags, pid_t *ppid, int *system)
+{
+    pid_t pid;
+    int pidfd;
+
+    int state = system_forkfd_availability();
     if (state < 0) {
         *system = 0;
         return state;
@@ -160,13 +178,100 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     }
 
     /* parent process */
-    if ((flags & FFD_CLOEXEC) == 0) {
-        /* pidfd defaults to O_CLOEXEC */
-        fcntl(pidfd, F_SETFD, 0);
+    return system_forkfd_pidfd_set_flags(pidfd, flags);
+}
+
+struct vforkfd_arguments
+{
+    int (*childFn)(void *);
+    void *token;
+    sigset_t oldmask;
+};
+
+static int vforkfd_child(void *arg)
+{
+    const struct vforkfd_arguments *args = (const struct vforkfd_arguments *)arg;
+    int sig;
+
+    /* We share the parent's memory, so no handler the parent installed may
+     * run in this process. The handler table itself is our own copy. */
+    for (sig = 1; sig < _NSIG; ++sig) {
+        struct sigaction sa;
+        if (sigaction(sig, NULL, &sa) == 0 && sa.sa_handler != SIG_DFL && sa.sa_handler != SIG_IGN) {
+            sa.sa_handler = SIG_DFL;
+            sa.sa_flags = 0;
+            sigaction(sig, &sa, NULL);
+        }
     }
-    if (flags & FFD_NONBLOCK)
-        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
-    return pidfd;
+    sigprocmask(SIG_SETMASK, &args->oldmask, NULL);
+
+    _exit(args->childFn(args->token));
+}
+
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    /* the child runs on a stack of its own while we are suspended, with a
+     * guard page so an overflow faults instead of corrupting memory */
+    enum { ChildStackSize = 64 * 1024 };
+    size_t guardSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapSize = ChildStackSize + guardSize;
+    char *childStack;
+    struct vforkfd_arguments args;
+    sigset_t allsignals;
+    pid_t pid;
+    int pidfd;
+    int saved_errno;
+
+    int state = system_forkfd_availability();
+    if (state < 0) {
+        *system = 0;
+        return state;
+    }
+
+    *system = 1;
+    args.childFn = childFn;
+    args.token = token;
+
+    childStack = (char *)mmap(NULL, mapSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (childStack == MAP_FAILED)
+        return -1;
+#if defined(__hppa__)
+    /* the stack grows upwards */
+    if (mprotect(childStack + ChildStackSize, guardSize, PROT_NONE) == -1) {
+#else
+    if (mprotect(childStack, guardSize, PROT_NONE) == -1) {
+#endif
+        saved_errno = errno;
+        munmap(childStack, mapSize);
+        errno = saved_errno;
+        return -1;
+    }
+
+    /* block all signals, so none is delivered to the child before it has
+     * reset its handlers */
+    sigfillset(&allsignals);
+    pthread_sigmask(SIG_BLOCK, &allsignals, &args.oldmask);
+
+#if defined(__hppa__)
+    pid = clone(vforkfd_child, childStack, CLONE_PIDFD | CLONE_VM | CLONE_VFORK | SIGCHLD,
+                &args, &pidfd);
+#else
+    pid = clone(vforkfd_child, childStack + mapSize,
+                CLONE_PIDFD | CLONE_VM | CLONE_VFORK | SIGCHLD, &args, &pidfd);
+#endif
+    saved_errno = errno;
+    pthread_sigmask(SIG_SETMASK, &args.oldmask, NULL);
+
+    /* CLONE_VFORK: the child has exec'ed or exited by now */
+    munmap(childStack, mapSize);
+    errno = saved_errno;
+
+    if (pid < 0)
+        return pid;
+    if (ppid)
+        *ppid = pid;
+    return system_forkfd_pidfd_set_flags(pidfd, flags);
 }
 
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdoptions, struct rusage *rusage)
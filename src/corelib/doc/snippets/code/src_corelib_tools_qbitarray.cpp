@@ -191,3 +191,10 @@ ba.fill(true, 1, 2);            // ba: [ 0, 1, 0, 0 ]
 ba.fill(true, 1, 3);            // ba: [ 0, 1, 1, 0 ]
 ba.fill(true, 1, 4);            // ba: [ 0, 1, 1, 1 ]
 //! [15]
+
+//! [16]
+QBitArray ba(200);
+ba.setBit(3); ba.setBit(64); ba.setBit(199);
+for (qsizetype i = ba.findNextSetBit(); i != -1; i = ba.findNextSetBit(i + 1))
+    qDebug() << i;              // prints 3, 64, 199
+//! [16]
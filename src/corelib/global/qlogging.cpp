@@ -49,6 +49,8 @@
 #include "qvarlengtharray.h"
 #include "qdebug.h"
 #include "qmutex.h"
+#include "qwaitcondition.h"
+#include "qmath.h"
 #include <QtCore/private/qlocking_p.h>
 #include "qloggingcategory.h"
 #ifndef QT_BOOTSTRAPPED
@@ -1091,6 +1093,7 @@ struct QMessagePattern
         int backtraceDepth;
     };
     QList<BacktraceParams> backtraceArgs; // backtrace argumens in sequence of %{backtrace
+    QAtomicInteger<bool> hasBacktrace; // can be read without holding the mutex
 #endif
 
     bool fromEnvironment;
@@ -1268,6 +1271,9 @@ void QMessagePattern::setPattern(const QString &pattern)
 
     literals.reset(new std::unique_ptr<const char[]>[literalsVar.size() + 1]);
     std::move(literalsVar.begin(), literalsVar.end(), &literals[0]);
+#ifdef QLOGGING_HAVE_BACKTRACE
+    hasBacktrace.storeRelaxed(!backtraceArgs.isEmpty());
+#endif
 }
 
 #if defined(QLOGGING_HAVE_BACKTRACE) && !defined(QT_BOOTSTRAPPED)
@@ -1355,6 +1361,20 @@ static QString formatBacktraceForLogMessage(const QMessagePattern::BacktracePara
 
 Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
 
+// The state of the emitting thread at the time a message was logged, for
+// messages that get formatted later on (and on another thread)
+struct QMessageLogOrigin
+{
+    qint64 monotonicNSecs;
+    qint64 msecsSinceEpoch;
+    qint64 threadId;
+    quintptr qthread;
+    QString applicationName;
+};
+
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context,
+                                const QString &str, const QMessageLogOrigin *origin);
+
 /*!
     \relates <QtGlobal>
     \since 5.4
@@ -1370,6 +1390,12 @@ Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
     \sa qInstallMessageHandler(), qSetMessagePattern()
  */
 QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str)
+{
+    return formatLogMessage(type, context, str, nullptr);
+}
+
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context,
+                                const QString &str, const QMessageLogOrigin *origin)
 {
     QString message;
 
@@ -1389,6 +1415,8 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
 #ifdef QLOGGING_HAVE_BACKTRACE
     int backtraceArgsIdx = 0;
 #endif
+#else
+    Q_UNUSED(origin);
 #endif
 
     // we do not convert file, function, line literals to local encoding due to overhead
@@ -1435,13 +1463,14 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
         } else if (token == pidTokenC) {
             message.append(QString::number(QCoreApplication::applicationPid()));
         } else if (token == appnameTokenC) {
-            message.append(QCoreApplication::applicationName());
+            message.append(origin ? origin->applicationName : QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
-            message.append(QString::number(qt_gettid()));
+            message.append(QString::number(origin ? origin->threadId : qint64(qt_gettid())));
         } else if (token == qthreadptrTokenC) {
             message.append(QLatin1String("0x"));
-            message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
+            message.append(QString::number(origin ? qlonglong(origin->qthread)
+                                                  : qlonglong(QThread::currentThread()->currentThread()), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
             QMessagePattern::BacktraceParams backtraceParams = pattern->backtraceArgs.at(backtraceArgsIdx);
@@ -1452,18 +1481,22 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             QString timeFormat = pattern->timeArgs.at(timeArgsIdx);
             timeArgsIdx++;
             if (timeFormat == QLatin1String("process")) {
-                    quint64 ms = pattern->timer.elapsed();
+                    quint64 ms = origin ? origin->monotonicNSecs / (1000 * 1000) - pattern->timer.msecsSinceReference()
+                                        : pattern->timer.elapsed();
                     message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat ==  QLatin1String("boot")) {
                 // just print the milliseconds since the elapsed timer reference
                 // like the Linux kernel does
-                uint ms = QDeadlineTimer::current().deadline();
+                uint ms = origin ? origin->monotonicNSecs / (1000 * 1000) : QDeadlineTimer::current().deadline();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                const QDateTime now = origin ? QDateTime::fromMSecsSinceEpoch(origin->msecsSinceEpoch)
+                                             : QDateTime::currentDateTime();
+                if (timeFormat.isEmpty())
+                    message.append(now.toString(Qt::ISODate));
+                else
+                    message.append(now.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1733,8 +1766,374 @@ static bool wasm_default_message_handler(QtMsgType type,
 
 // --------------------------------------------------------------------------
 
+// ---------------------- Asynchronous stderr sink --------------------------
+
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_COMPILER_THREAD_LOCAL)
+#if QT_CONFIG(thread)
+#  define QLOGGING_HAVE_ASYNC_SINK
+#endif
+#endif
+
+#ifdef QLOGGING_HAVE_ASYNC_SINK
+
+/*
+    Opt-in (QT_LOGGING_ASYNC=1) replacement for writing to stderr on the
+    emitting thread. Every thread that logs gets its own bounded ring of
+    entries with a single producer (the thread itself) and a single consumer
+    (whoever holds drainMutex), so posting a message only copies the context
+    and a reference to the message string, without taking any lock. A writer
+    thread formats the entries with the message pattern, using the time and
+    thread information captured when the message was posted, and writes them
+    to stderr in batches. When a ring is full, messages are dropped and
+    counted; the number of dropped messages is reported by the writer.
+*/
+struct QAsyncLogRing
+{
+    struct Entry
+    {
+        QString message;
+        QString applicationName;
+        QVarLengthArray<char, 128> strings; // file, function and category
+        qint64 monotonicNSecs;
+        qint64 msecsSinceEpoch;
+        int line;
+        int file;
+        int function;
+        int category;
+        QtMsgType type;
+
+        int appendString(const char *str)
+        {
+            if (!str)
+                return -1;
+            const int offset = strings.size();
+            strings.append(str, int(strlen(str)) + 1);
+            return offset;
+        }
+        const char *string(int offset) const
+        {
+            return offset < 0 ? nullptr : strings.constData() + offset;
+        }
+    };
+
+    QAsyncLogRing(quint32 capacity, qint64 threadId, quintptr qthread)
+        : entries(new Entry[capacity]), mask(capacity - 1), threadId(threadId), qthread(qthread)
+    {}
+
+    const std::unique_ptr<Entry[]> entries;
+    const quint32 mask;
+    const qint64 threadId;
+    const quintptr qthread;
+    QAtomicInteger<quint32> head = 0;       // written by the producer only
+    QAtomicInteger<quint32> tail = 0;       // written by the consumer only
+    QAtomicInteger<quint32> dropped = 0;    // written by the producer only
+    QAtomicInteger<quint32> droppedReported = 0; // written by the consumer only
+    QAtomicInteger<bool> finished = false;  // set once the producer thread exits
+};
+
+static void flushAsyncLog();
+
+static thread_local bool asyncLogRingReleased = false;
+static thread_local bool asyncLogDraining = false;
+
+struct QAsyncLogRingHolder
+{
+    ~QAsyncLogRingHolder()
+    {
+        if (ring)
+            ring->finished.storeRelease(true);
+        asyncLogRingReleased = true;
+    }
+    std::shared_ptr<QAsyncLogRing> ring;
+};
+
+class QAsyncLogSink
+{
+public:
+    QAsyncLogSink();
+    ~QAsyncLogSink();
+
+    bool post(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    void flush();
+
+private:
+    class Writer : public QThread
+    {
+    public:
+        explicit Writer(QAsyncLogSink *sink) : sink(sink) {}
+        void run() override { sink->run(); }
+        QAsyncLogSink *sink;
+    };
+
+    QAsyncLogRing *currentRing();
+    void wakeWriter();
+    bool hasPendingEntries();
+    void drain();
+    void run();
+
+    const quint32 capacity;
+
+    QBasicMutex registryMutex;
+    std::vector<std::shared_ptr<QAsyncLogRing>> rings; // protected by registryMutex
+
+    QBasicMutex drainMutex;
+    // the following are protected by drainMutex
+    std::vector<std::pair<QAsyncLogRing *, quint32>> drainedRings; // ring and its head
+    std::vector<std::pair<QAsyncLogRing *, QAsyncLogRing::Entry *>> pending;
+    QByteArray output;
+
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    bool quit = false; // protected by wakeMutex
+    QAtomicInteger<bool> writerIdle = false;
+
+    Writer writer;
+};
+
+static quint32 asyncLogRingCapacity()
+{
+    int size = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC_BUFFER_SIZE");
+    if (size <= 0)
+        size = 1024;
+    return qNextPowerOfTwo(quint32(qBound(16, size, 1 << 20) - 1));
+}
+
+QAsyncLogSink::QAsyncLogSink()
+    : capacity(asyncLogRingCapacity()), writer(this)
+{
+    writer.setObjectName(QStringLiteral("Qt logging"));
+    writer.start();
+
+    // don't keep the messages queued while the application shuts down
+    qAddPostRoutine(flushAsyncLog);
+}
+
+QAsyncLogSink::~QAsyncLogSink()
+{
+    {
+        QMutexLocker locker(&wakeMutex);
+        quit = true;
+        wakeCondition.wakeOne();
+    }
+    writer.wait();
+    flush();
+}
+
+QAsyncLogRing *QAsyncLogSink::currentRing()
+{
+    // messages logged from thread_local destructors of this thread, after
+    // the holder is gone, are written synchronously
+    if (asyncLogRingReleased)
+        return nullptr;
+
+    static thread_local QAsyncLogRingHolder holder;
+    if (Q_UNLIKELY(!holder.ring)) {
+        holder.ring = std::make_shared<QAsyncLogRing>(capacity, qint64(qt_gettid()),
+                                                      quintptr(QThread::currentThread()));
+        const auto locker = qt_scoped_lock(registryMutex);
+        rings.push_back(holder.ring);
+    }
+    return holder.ring.get();
+}
+
+bool QAsyncLogSink::post(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+#ifdef QLOGGING_HAVE_BACKTRACE
+    // the backtrace can only be taken on the emitting thread
+    QMessagePattern *pattern = qMessagePattern();
+    if (!pattern || pattern->hasBacktrace.loadRelaxed())
+        return false;
+#endif
+
+    QAsyncLogRing *ring = currentRing();
+    if (!ring)
+        return false;
+
+    const quint32 head = ring->head.loadRelaxed();
+    if (head - ring->tail.loadAcquire() > ring->mask) {
+        // the writer reports the drop even if nothing else gets logged
+        ring->dropped.fetchAndAddOrdered(1);
+        wakeWriter();
+        return true;
+    }
+
+    QAsyncLogRing::Entry &entry = ring->entries[head & ring->mask];
+    entry.message = message;
+    entry.applicationName = QCoreApplication::applicationName();
+    entry.strings.clear();
+    entry.file = entry.appendString(context.file);
+    entry.function = entry.appendString(context.function);
+    entry.category = entry.appendString(context.category);
+    entry.line = context.line;
+    entry.type = type;
+    entry.monotonicNSecs = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    entry.msecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+
+    // Publish the entry with a full barrier, so that either we see the writer
+    // going idle, or the writer sees the entry before it starts to wait.
+    ring->head.fetchAndStoreOrdered(head + 1);
+    wakeWriter();
+    return true;
+}
+
+void QAsyncLogSink::wakeWriter()
+{
+    if (writerIdle.loadAcquire()) {
+        QMutexLocker locker(&wakeMutex);
+        wakeCondition.wakeOne();
+    }
+}
+
+bool QAsyncLogSink::hasPendingEntries()
+{
+    const auto locker = qt_scoped_lock(registryMutex);
+    for (const auto &ring : rings) {
+        if (ring->head.loadAcquire() != ring->tail.loadRelaxed()
+                || ring->dropped.loadAcquire() != ring->droppedReported.loadRelaxed()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QAsyncLogSink::flush()
+{
+    // the writer itself may log while formatting; those messages stay queued
+    if (asyncLogDraining)
+        return;
+    const auto locker = qt_scoped_lock(drainMutex);
+    drain();
+}
+
+void QAsyncLogSink::drain()
+{
+    asyncLogDraining = true;
+    const auto resetDraining = qScopeGuard([] { asyncLogDraining = false; });
+
+    drainedRings.clear();
+    {
+        const auto locker = qt_scoped_lock(registryMutex);
+        for (const auto &ring : rings)
+            drainedRings.emplace_back(ring.get(), ring->head.loadAcquire());
+    }
+
+    // The entries of one ring are in order; merge the rings by time.
+    pending.clear();
+    quint32 droppedCount = 0;
+    for (const auto &[ring, head] : drainedRings) {
+        for (quint32 i = ring->tail.loadRelaxed(); i != head; ++i)
+            pending.emplace_back(ring, &ring->entries[i & ring->mask]);
+        const quint32 dropped = ring->dropped.loadRelaxed();
+        droppedCount += dropped - ring->droppedReported.loadRelaxed();
+        ring->droppedReported.storeRelaxed(dropped);
+    }
+    if (pending.empty() && !droppedCount)
+        return;
+    std::stable_sort(pending.begin(), pending.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.second->monotonicNSecs < rhs.second->monotonicNSecs;
+    });
+
+    output.clear();
+    for (const auto &p : pending) {
+        QAsyncLogRing::Entry *entry = p.second;
+        const QMessageLogContext context(entry->string(entry->file), entry->line,
+                                         entry->string(entry->function),
+                                         entry->string(entry->category));
+        const QMessageLogOrigin origin = { entry->monotonicNSecs, entry->msecsSinceEpoch,
+                                           p.first->threadId, p.first->qthread,
+                                           std::move(entry->applicationName) };
+        const QString formattedMessage = formatLogMessage(entry->type, context, entry->message, &origin);
+        entry->message.clear();
+
+        // print nothing if message pattern didn't apply / was empty.
+        // (still print empty lines, e.g. because message itself was empty)
+        if (formattedMessage.isNull())
+            continue;
+        output += formattedMessage.toLocal8Bit();
+        output += '\n';
+    }
+    if (droppedCount) {
+        const QMessageLogContext context(nullptr, 0, nullptr, "qt.core.logging");
+        const QString formattedMessage = qFormatLogMessage(QtWarningMsg, context,
+                QStringLiteral("Dropped %1 messages because the asynchronous logging buffer was full")
+                        .arg(droppedCount));
+        if (!formattedMessage.isNull()) {
+            output += formattedMessage.toLocal8Bit();
+            output += '\n';
+        }
+    }
+    if (!output.isEmpty()) {
+        fwrite(output.constData(), 1, output.size(), stderr);
+        fflush(stderr);
+    }
+
+    // hand the entries back to the producers
+    for (const auto &[ring, head] : drainedRings)
+        ring->tail.storeRelease(head);
+
+    const auto locker = qt_scoped_lock(registryMutex);
+    rings.erase(std::remove_if(rings.begin(), rings.end(), [](const auto &ring) {
+        return ring->finished.loadAcquire()
+                && ring->head.loadAcquire() == ring->tail.loadRelaxed()
+                && ring->dropped.loadRelaxed() == ring->droppedReported.loadRelaxed();
+    }), rings.end());
+}
+
+void QAsyncLogSink::run()
+{
+    forever {
+        flush();
+
+        QMutexLocker locker(&wakeMutex);
+        if (quit)
+            break;
+        // Producers check writerIdle after publishing, and we check for
+        // entries after setting it, so one of us sees the other.
+        writerIdle.fetchAndStoreOrdered(true);
+        if (!hasPendingEntries())
+            wakeCondition.wait(&wakeMutex);
+        writerIdle.storeRelaxed(false);
+    }
+}
+
+Q_GLOBAL_STATIC(QAsyncLogSink, qAsyncLogSink)
+
+static QAsyncLogSink *asyncLogSink()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC");
+    return enabled ? qAsyncLogSink() : nullptr;
+}
+
+#endif // QLOGGING_HAVE_ASYNC_SINK
+
+/*!
+    \internal
+
+    Writes out all messages that the asynchronous sink has queued so far.
+*/
+static void flushAsyncLog()
+{
+#ifdef QLOGGING_HAVE_ASYNC_SINK
+    if (qAsyncLogSink.exists()) {
+        if (QAsyncLogSink *sink = qAsyncLogSink())
+            sink->flush();
+    }
+#endif
+}
+
+// --------------------------------------------------------------------------
+
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
 {
+#ifdef QLOGGING_HAVE_ASYNC_SINK
+    if (QAsyncLogSink *sink = asyncLogSink()) {
+        if (type != QtFatalMsg && sink->post(type, context, message))
+            return;
+        // keep the order of the messages
+        sink->flush();
+    }
+#endif
+
     QString formattedMessage = qFormatLogMessage(type, context, message);
 
     // print nothing if message pattern didn't apply / was empty.
@@ -1844,6 +2243,9 @@ static void qt_message_print(const QString &message)
 
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message)
 {
+    // messages that were made fatal by QT_FATAL_WARNINGS may still be queued
+    flushAsyncLog();
+
 #if defined(Q_CC_MSVC) && defined(QT_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
     wchar_t contextFileL[256];
     // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
@@ -1968,6 +2370,18 @@ void qErrnoWarning(int code, const char *msg, ...)
     output under X11 or to the debugger under Windows. If it is a
     fatal message, the application aborts immediately.
 
+    If the \c QT_LOGGING_ASYNC environment variable is set to \c 1, the
+    default message handler does not write to \c stderr on the thread
+    that logs the message. Instead, each thread queues its messages in a
+    buffer of its own, and a separate thread formats them according to the
+    message pattern and writes them out. The buffer holds 1024 messages per
+    thread unless \c QT_LOGGING_ASYNC_BUFFER_SIZE specifies otherwise;
+    messages logged while it is full are dropped, and the number of dropped
+    messages is reported. Queued messages are written out before a fatal
+    message, before the message handler or pattern changes, and when the
+    application exits. Messages that are sent to a structured logging
+    backend, such as systemd's journal, are not affected.
+
     Only one message handler can be defined, since this is usually
     done on an application-wide basis to control debug output.
 
@@ -2050,6 +2464,7 @@ void qErrnoWarning(int code, const char *msg, ...)
 
 QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 {
+    flushAsyncLog();
     const auto old = messageHandler.fetchAndStoreOrdered(h);
     if (old)
         return old;
@@ -2059,6 +2474,9 @@ QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 
 void qSetMessagePattern(const QString &pattern)
 {
+    // queued messages are formatted with the pattern that was set when they were logged
+    flushAsyncLog();
+
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
 
     if (!qMessagePattern()->fromEnvironment)
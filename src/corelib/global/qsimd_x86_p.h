@@ -117,7 +117,7 @@ QT_BEGIN_NAMESPACE
 #define CpuFeatureAVX512CD                          (Q_UINT64_C(1) << 24)
 #define QT_FUNCTION_TARGET_STRING_AVX512CD          "avx512cd"
 #define CpuFeatureSHA                               (Q_UINT64_C(1) << 25)
-#define QT_FUNCTION_TARGET_STRING_SHA               "sha"
+#define QT_FUNCTION_TARGET_STRING_SHA               "sha,sse4.1"
 #define CpuFeatureAVX512BW                          (Q_UINT64_C(1) << 26)
 #define QT_FUNCTION_TARGET_STRING_AVX512BW          "avx512bw"
 #define CpuFeatureAVX512VL                          (Q_UINT64_C(1) << 27)
@@ -96,6 +96,10 @@
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#endif
 #if QT_CONFIG(regularexpression)
 #include <QtCore/qregularexpression.h>
 #endif
@@ -121,13 +125,17 @@ public:
     }
 };
 
+class QDirWalk;
+
 class QDirIteratorPrivate
 {
 public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                        QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
+                        QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true,
+                        QDirWalk *walk = nullptr, int depth = 0);
 
     void advance();
+    bool hasNext() const;
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
@@ -155,17 +163,60 @@ public:
 
     // Loop protection
     QDuplicateTracker<QString> visitedLinks;
+
+    // Set when used by QDirIterator::walk(), which lists subdirectories
+    // concurrently instead of pushing them onto the stacks above.
+    QDirWalk *walk;
+    int depth;
 };
 
+#if QT_CONFIG(thread)
+class QDirWalk
+{
+public:
+    QDirWalk(const QStringList &nameFilters, QDir::Filters filters,
+             QDirIterator::IteratorFlags flags, int maxDepth,
+             const std::function<void(const QFileInfoList &)> &receiver)
+        : nameFilters(nameFilters), filters(filters), flags(flags), maxDepth(maxDepth),
+          receiver(receiver)
+    {
+        // Listing directories is bound by file system latency rather than
+        // by the CPU, so use a few more threads than there are cores.
+        pool.setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+    }
+
+    void run(const QString &path);
+    void descend(const QFileInfo &dir, int depth);
+
+private:
+    void list(const QFileSystemEntry &dir, int depth);
+    void deliver(QFileInfoList &batch);
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags flags;
+    const int maxDepth;
+    const std::function<void(const QFileInfoList &)> &receiver;
+
+    QThreadPool pool;
+    QMutex receiverMutex;
+    QMutex visitedMutex;
+    QSet<QString> visitedLinks;
+};
+#endif
+
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
+                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine,
+                                         QDirWalk *walk, int depth)
     : dirEntry(entry)
       , nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
       , filters(QDir::NoFilter == _filters ? QDir::AllEntries : _filters)
       , iteratorFlags(flags)
+      , walk(walk)
+      , depth(depth)
 {
 #if QT_CONFIG(regularexpression)
     nameRegExps.reserve(nameFilters.size());
@@ -265,9 +316,12 @@ void QDirIteratorPrivate::advance()
             // Find the next valid iterator that matches the filters.
             QFileSystemIterator *it;
             while (it = nativeIterators.top(), it->advance(nextEntry, nextMetaData)) {
+                // Resolve the name before copying the entry into the QFileInfo,
+                // so that the path is only converted from the native encoding once.
+                const QString fileName = nextEntry.fileName();
                 QFileInfo info(new QFileInfoPrivate(nextEntry, nextMetaData));
 
-                if (entryMatches(nextEntry.fileName(), info))
+                if (entryMatches(fileName, info))
                     return;
                 nextMetaData = QFileSystemMetaData();
             }
@@ -282,6 +336,21 @@ void QDirIteratorPrivate::advance()
     nextFileInfo = QFileInfo();
 }
 
+/*!
+    \internal
+*/
+bool QDirIteratorPrivate::hasNext() const
+{
+    if (engine)
+        return !fileEngineIterators.isEmpty();
+    else
+#ifndef QT_NO_FILESYSTEMITERATOR
+        return !nativeIterators.isEmpty();
+#else
+        return false;
+#endif
+}
+
 /*!
     \internal
  */
@@ -308,6 +377,13 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
         return;
 
+#if QT_CONFIG(thread)
+    if (walk) {
+        walk->descend(fileInfo, depth + 1);
+        return;
+    }
+#endif
+
     pushDirectory(fileInfo);
 }
 
@@ -509,14 +585,7 @@ QString QDirIterator::next()
 */
 bool QDirIterator::hasNext() const
 {
-    if (d->engine)
-        return !d->fileEngineIterators.isEmpty();
-    else
-#ifndef QT_NO_FILESYSTEMITERATOR
-        return !d->nativeIterators.isEmpty();
-#else
-        return false;
-#endif
+    return d->hasNext();
 }
 
 /*!
@@ -562,4 +631,90 @@ QString QDirIterator::path() const
     return d->dirEntry.filePath();
 }
 
+#if QT_CONFIG(thread)
+void QDirWalk::run(const QString &path)
+{
+    if (flags & QDirIterator::FollowSymlinks)
+        visitedLinks.insert(QFileInfo(path).canonicalFilePath());
+    list(QFileSystemEntry(path), 0);
+    pool.waitForDone();
+}
+
+void QDirWalk::descend(const QFileInfo &dir, int depth)
+{
+    if (maxDepth >= 0 && depth > maxDepth)
+        return;
+
+    if (flags & QDirIterator::FollowSymlinks) {
+        // Stop link loops; the walk is shared by all threads
+        const QString canonicalPath = dir.canonicalFilePath();
+        QMutexLocker locker(&visitedMutex);
+        if (visitedLinks.contains(canonicalPath))
+            return;
+        visitedLinks.insert(canonicalPath);
+    }
+
+    const QFileSystemEntry entry(dir.filePath());
+    pool.start([this, entry, depth]() { list(entry, depth); });
+}
+
+void QDirWalk::list(const QFileSystemEntry &dir, int depth)
+{
+    enum { BatchSize = 512 };
+
+    QDirIteratorPrivate it(dir, nameFilters, filters, flags, true, this, depth);
+    QFileInfoList batch;
+    batch.reserve(BatchSize);
+    while (it.hasNext()) {
+        it.advance();
+        batch.append(it.currentFileInfo);
+        if (batch.size() == BatchSize)
+            deliver(batch);
+    }
+    deliver(batch);
+}
+
+void QDirWalk::deliver(QFileInfoList &batch)
+{
+    if (batch.isEmpty())
+        return;
+    {
+        QMutexLocker locker(&receiverMutex);
+        receiver(batch);
+    }
+    batch.clear();
+}
+
+/*!
+    \since 6.0
+
+    Lists the contents of the directory \a path, using \a nameFilters,
+    \a filters and \a flags in the same way as a QDirIterator constructed
+    with them would, but lists the directories of the tree concurrently.
+
+    If \a flags contains Subdirectories, the walk descends at most
+    \a maxDepth levels below \a path; pass -1 for no limit. A \a maxDepth
+    of 0 only lists \a path itself.
+
+    The entries found are passed to \a receiver in batches. The order of the
+    entries, both within and across batches, is unspecified. \a receiver is
+    called from the threads doing the listing, but never from two threads at
+    the same time. The function returns once the whole tree has been listed
+    and all batches have been delivered.
+
+    This function is meant for trees that are too large to be walked
+    efficiently one directory at a time, such as when indexing a file system
+    on storage that handles many requests in parallel.
+
+    \sa QDirIterator(), QThreadPool
+*/
+void QDirIterator::walk(const QString &path, const QStringList &nameFilters,
+                        QDir::Filters filters, IteratorFlags flags, int maxDepth,
+                        const std::function<void(const QFileInfoList &)> &receiver)
+{
+    QDirWalk walk(nameFilters, filters, flags, maxDepth, receiver);
+    walk.run(path);
+}
+#endif // QT_CONFIG(thread)
+
 QT_END_NAMESPACE
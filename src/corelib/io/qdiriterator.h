@@ -42,6 +42,8 @@
 
 #include <QtCore/qdir.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QDirIteratorPrivate;
@@ -76,6 +78,12 @@ public:
     QFileInfo fileInfo() const;
     QString path() const;
 
+#if QT_CONFIG(thread)
+    static void walk(const QString &path, const QStringList &nameFilters,
+                     QDir::Filters filters, IteratorFlags flags, int maxDepth,
+                     const std::function<void(const QFileInfoList &)> &receiver);
+#endif
+
 private:
     Q_DISABLE_COPY(QDirIterator)
 
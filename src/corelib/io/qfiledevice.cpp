@@ -42,6 +42,19 @@
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
 
+#if defined(Q_OS_LINUX) && !defined(QT_BOOTSTRAPPED)
+#include <sys/sendfile.h>
+#endif
+
+#if QT_CONFIG(future)
+#include <qfuture.h>
+#include <qthreadpool.h>
+#include <private/qbytearray_p.h>
+#ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
+#endif
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -528,6 +541,31 @@ bool QFileDevicePrivate::putCharHelper(char c)
 #endif
 }
 
+/*!
+    \internal
+*/
+qintptr QFileDevicePrivate::nativeWriteDescriptor()
+{
+    Q_Q(QFileDevice);
+    if (openMode & QIODevice::Text)
+        return -1;
+    // Seeking flushes the write buffer, drops read-ahead data and moves the
+    // descriptor's offset to pos(), where direct writes must go.
+    if (isSequential() ? !q->flush() : !q->seek(pos))
+        return -1;
+    return q->handle();
+}
+
+/*!
+    \internal
+*/
+void QFileDevicePrivate::nativeDataWritten(qint64 size)
+{
+    Q_Q(QFileDevice);
+    if (!isSequential())
+        q->seek(pos + size);
+}
+
 /*!
   \reimp
 */
@@ -805,6 +843,328 @@ bool QFileDevice::setFileTime(const QDateTime &newDate, QFileDevice::FileTime fi
     return true;
 }
 
+#if defined(Q_OS_LINUX) && !defined(QT_BOOTSTRAPPED)
+// Moves up to \a size bytes starting at \a offset in \a in to the current
+// position of \a out without copying them through user space. Sets
+// \a retryBuffered if the caller should carry on with a buffered copy.
+static qint64 sendFileData(int in, qint64 offset, int out, qint64 size, bool *retryBuffered)
+{
+    // sendfile(2) is limited in the kernel to 2G - 4k
+    const qint64 SendfileSize = 0x7ffff000;
+
+    qint64 done = 0;
+    *retryBuffered = false;
+    while (done < size) {
+        off64_t off = offset + done;
+        const ssize_t n = ::sendfile64(out, in, &off, size_t(qMin(size - done, SendfileSize)));
+        if (n > 0) {
+            done += n;
+        } else if (n == 0) {
+            break; // end of file
+        } else if (errno != EINTR) {
+            // EAGAIN: a non-blocking socket is full; anything else on the
+            // first call: this pair of descriptors is not supported.
+            *retryBuffered = errno == EAGAIN || errno == EWOULDBLOCK || done == 0;
+            break;
+        }
+    }
+    return done;
+}
+#endif
+
+/*!
+    \enum QFileDevice::TransferOption
+    \since 6.0
+
+    This enum describes options for transferTo().
+
+    \value NoTransferOptions    No options.
+    \value DirectTransferOption Where the platform supports it, write to the
+    native descriptor of the target device directly, without calling its
+    QIODevice::write().
+*/
+
+/*!
+    \since 6.0
+
+    Transfers at most \a maxSize bytes from the current position of this
+    file to \a target, and returns the number of bytes transferred, or -1
+    if an error occurred before anything could be transferred. If \a maxSize
+    is negative, everything up to the end of the file is transferred. The
+    position of this file is advanced by the number of bytes transferred.
+
+    By default, the data is copied through a buffer with read() and
+    QIODevice::write(). If \a options contains DirectTransferOption, and on
+    Linux, \a target is a file or a connected TCP or local socket, the data
+    is moved with sendfile() instead and never copied into this process. Any
+    data that \a target still buffers is written out first. This bypasses
+    QIODevice::write() and writeData(), so only pass DirectTransferOption if
+    \a target is of a class that does not reimplement writeData(), or whose
+    reimplementation only passes the data on unchanged. For anything the
+    kernel does not accept, the data is copied through a buffer as usual.
+
+    When \a target is a non-blocking socket, the kernel only accepts as much
+    data as fits into the socket's send buffer; the rest is handed to
+    QIODevice::write() and therefore buffered in memory. Servers sending
+    large files should call this function repeatedly with a moderate
+    \a maxSize, for instance each time QIODevice::bytesWritten() is emitted.
+    Data written directly to a socket does not cause bytesWritten() to be
+    emitted.
+
+    \sa QFile::copy()
+*/
+qint64 QFileDevice::transferTo(QIODevice *target, qint64 maxSize, TransferOptions options)
+{
+    Q_D(QFileDevice);
+    if (!target) {
+        qWarning("QFileDevice::transferTo: Called with null target");
+        return -1;
+    }
+    if (!isOpen() || !isReadable()) {
+        qWarning("QFileDevice::transferTo: File not open for reading");
+        return -1;
+    }
+    if (!target->isOpen() || !target->isWritable()) {
+        qWarning("QFileDevice::transferTo: Target device not open for writing");
+        return -1;
+    }
+    if (maxSize < 0)
+        maxSize = std::numeric_limits<qint64>::max();
+
+    qint64 transferred = 0;
+#if defined(Q_OS_LINUX) && !defined(QT_BOOTSTRAPPED)
+    const int in = handle();
+    if ((options & DirectTransferOption) && in != -1 && !isSequential() && !(openMode() & Text)
+            && (!isWritable() || flush())) {
+        auto targetd = static_cast<QIODevicePrivate *>(QObjectPrivate::get(target));
+        const qintptr out = targetd->nativeWriteDescriptor();
+        if (out != -1) {
+            const qint64 start = pos();
+            bool retryBuffered;
+            transferred = sendFileData(in, start, int(out), maxSize, &retryBuffered);
+            if (transferred) {
+                targetd->nativeDataWritten(transferred);
+                seek(start + transferred);
+            }
+            if (!retryBuffered)
+                return transferred;
+        }
+    }
+#else
+    Q_UNUSED(options);
+#endif
+
+    char buffer[QIODEVICE_BUFFERSIZE];
+    while (transferred < maxSize) {
+        const qint64 r = read(buffer, qMin<qint64>(sizeof buffer, maxSize - transferred));
+        if (r <= 0)
+            return (r < 0 && !transferred) ? -1 : transferred;
+        const qint64 w = target->write(buffer, r);
+        if (w > 0)
+            transferred += w;
+        if (w < r) {
+            // keep what the target did not take, to be read again; a sequential
+            // file cannot seek back to it
+            const qint64 left = r - qMax<qint64>(w, 0);
+            if (d->transactionStarted && isSequential()) {
+                d->transactionPos -= left; // still in the buffer
+            } else {
+                memcpy(d->buffer.reserveFront(left), buffer + r - left, size_t(left));
+                if (!isSequential())
+                    d->pos -= left;
+            }
+            return (w < 0 && !transferred) ? -1 : transferred;
+        }
+    }
+    return transferred;
+}
+
+#if QT_CONFIG(future)
+namespace {
+// Blocking file I/O gets its own pool, so that waiting for a slow disk or
+// network file system never starves the tasks in the global pool.
+class QFileIoThreadPool : public QThreadPool
+{
+public:
+    QFileIoThreadPool()
+    {
+        setMaxThreadCount(qBound(2, QThread::idealThreadCount(), 8));
+    }
+};
+}
+Q_GLOBAL_STATIC(QFileIoThreadPool, fileIoThreadPool)
+
+#ifdef Q_OS_UNIX
+static QByteArray positionalRead(int fd, qint64 offset, qint64 maxSize)
+{
+    // Callers may pass a huge maxSize to read everything, so don't allocate
+    // it up front: size the buffer for what the file holds, and grow it in
+    // steps if the file turns out to be longer, like those in /proc.
+    const qint64 ChunkSize = 64 * 1024;
+    qint64 expected = 0;
+    QT_STATBUF st;
+    if (QT_FSTAT(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > offset)
+        expected = st.st_size - offset;
+
+    QByteArray buffer;
+    qint64 total = 0;
+    while (total < maxSize) {
+        if (total == buffer.size()) {
+            const qint64 step = total < expected ? expected - total : ChunkSize;
+            buffer.resize(qMin(maxSize, total + step));
+        }
+        ssize_t r;
+        EINTR_LOOP(r, ::pread(fd, buffer.data() + total, size_t(buffer.size() - total),
+                              QT_OFF_T(offset + total)));
+        if (r <= 0)
+            break;
+        total += r;
+    }
+    buffer.truncate(total);
+    return buffer;
+}
+
+static qint64 positionalWrite(int fd, qint64 offset, const QByteArray &data)
+{
+    qint64 total = 0;
+    while (total < data.size()) {
+        ssize_t r;
+        EINTR_LOOP(r, ::pwrite(fd, data.constData() + total, size_t(data.size() - total),
+                               QT_OFF_T(offset + total)));
+        // like QFSFileEngine, give up if nothing was written, so that this
+        // cannot spin forever
+        if (r <= 0)
+            return total ? total : -1;
+        total += r;
+    }
+    return total;
+}
+#endif // Q_OS_UNIX
+
+/*!
+    \since 6.0
+
+    Starts reading at most \a maxSize bytes from position \a offset in the
+    file and returns a QFuture that yields the data once it is available.
+    The returned data is shorter than \a maxSize if the end of the file is
+    reached or an error occurs.
+
+    For files with a native handle (see handle()), the read is performed on
+    a dedicated thread pool with positional I/O, so the calling thread never
+    blocks on the disk. The read neither uses nor changes the current
+    position of the device, and any data buffered by write() is flushed
+    before the read is started. Other files, such as those in the Qt
+    resource system, are read synchronously and the returned future is
+    already finished.
+
+    The file may be closed or destroyed while the read is in progress.
+
+    \sa writeAsync(), map()
+*/
+QFuture<QByteArray> QFileDevice::readAsync(qint64 offset, qint64 maxSize)
+{
+    if (!isOpen() || !isReadable()) {
+        qWarning("QFileDevice::readAsync: File not open for reading");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFileDevice::readAsync: Called with negative offset or size");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    maxSize = qMin<qint64>(maxSize, MaxByteArraySize - 1);
+
+    if (isWritable())
+        flush();
+
+#ifdef Q_OS_UNIX
+    // Work on a duplicate of the descriptor, so that the file can be closed
+    // (and its descriptor reused) while the read is still pending.
+    const int fd = handle() == -1 ? -1 : qt_safe_dup(handle());
+    if (fd != -1) {
+        QFutureInterface<QByteArray> promise;
+        promise.reportStarted();
+        fileIoThreadPool()->start([promise, fd, offset, maxSize]() mutable {
+            promise.reportResult(positionalRead(fd, offset, maxSize));
+            qt_safe_close(fd);
+            promise.reportFinished();
+        });
+        return promise.future();
+    }
+#endif
+
+    // read() allocates maxSize bytes up front
+    if (!isSequential())
+        maxSize = qBound<qint64>(0, size() - offset, maxSize);
+    QByteArray data;
+    if (maxSize > 0) {
+        const qint64 oldPos = pos();
+        if (seek(offset))
+            data = read(maxSize);
+        seek(oldPos);
+    }
+    return QtFuture::makeReadyFuture(std::move(data));
+}
+
+/*!
+    \since 6.0
+
+    Starts writing \a data to the file at position \a offset and returns a
+    QFuture that yields the number of bytes written, or -1 if an error
+    occurred before anything could be written.
+
+    For files with a native handle (see handle()), the write is performed
+    on a dedicated thread pool with positional I/O, so the calling thread
+    never blocks on the disk. The write neither uses nor changes the
+    current position of the device. Data buffered by write() is flushed
+    before the write is started. On Unix, if the file was opened with
+    QIODevice::Append, the data is appended regardless of \a offset. Other
+    files are written synchronously and the returned future is already
+    finished.
+
+    \note The data is not read back through the device's own read buffer;
+    reading data written with this function through read() at the same
+    time gives undefined results.
+
+    \sa readAsync()
+*/
+QFuture<qint64> QFileDevice::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if (!isOpen() || !isWritable()) {
+        qWarning("QFileDevice::writeAsync: File not open for writing");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+    if (offset < 0) {
+        qWarning("QFileDevice::writeAsync: Called with negative offset");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+
+    flush();
+
+#ifdef Q_OS_UNIX
+    const int fd = handle() == -1 ? -1 : qt_safe_dup(handle());
+    if (fd != -1) {
+        QFutureInterface<qint64> promise;
+        promise.reportStarted();
+        fileIoThreadPool()->start([promise, fd, offset, data]() mutable {
+            promise.reportResult(positionalWrite(fd, offset, data));
+            qt_safe_close(fd);
+            promise.reportFinished();
+        });
+        return promise.future();
+    }
+#endif
+
+    const qint64 oldPos = pos();
+    qint64 written = -1;
+    if (seek(offset)) {
+        written = write(data);
+        flush();
+    }
+    seek(oldPos);
+    return QtFuture::makeReadyFuture(written);
+}
+#endif // QT_CONFIG(future)
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
@@ -47,6 +47,9 @@ QT_BEGIN_NAMESPACE
 
 class QDateTime;
 class QFileDevicePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 class Q_CORE_EXPORT QFileDevice : public QIODevice
 {
@@ -130,6 +133,20 @@ public:
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
 
+    enum TransferOption {
+        NoTransferOptions = 0,
+        DirectTransferOption = 0x0001
+    };
+    Q_DECLARE_FLAGS(TransferOptions, TransferOption)
+
+    qint64 transferTo(QIODevice *target, qint64 maxSize = -1,
+                      TransferOptions options = NoTransferOptions);
+
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
 protected:
     QFileDevice();
 #ifdef QT_NO_QOBJECT
@@ -150,6 +167,7 @@ private:
 Q_DECLARE_OPERATORS_FOR_FLAGS(QFileDevice::Permissions)
 Q_DECLARE_OPERATORS_FOR_FLAGS(QFileDevice::FileHandleFlags)
 Q_DECLARE_OPERATORS_FOR_FLAGS(QFileDevice::MemoryMapFlags)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QFileDevice::TransferOptions)
 
 QT_END_NAMESPACE
 
@@ -72,6 +72,8 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    qintptr nativeWriteDescriptor() override;
+    void nativeDataWritten(qint64 size) override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
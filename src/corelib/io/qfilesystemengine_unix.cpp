@@ -617,6 +617,15 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 #else
     Q_UNUSED(entry);
 #endif
+
+#if !defined(Q_OS_DARWIN) && !defined(UF_HIDDEN)
+    // Without file flags, only the name decides whether the entry is hidden
+    // (see fillMetaData()); record that now, so that filtering hidden files
+    // does not need another round trip through the file system engine.
+    if (entry.d_name[0] == '.')
+        entryFlags |= QFileSystemMetaData::HiddenAttribute;
+    knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
+#endif
 }
 
 //static
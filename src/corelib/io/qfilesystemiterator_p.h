@@ -66,6 +66,9 @@
 #if !defined(Q_OS_WIN)
 #include <QtCore/qscopedpointer.h>
 #endif
+#if defined(Q_OS_LINUX)
+#include <memory>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -90,6 +93,12 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(Q_OS_LINUX)
+    int dirFd;
+    std::unique_ptr<char[]> buffer;
+    qsizetype bufferPos;
+    qsizetype bufferEnd;
+    int lastError;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
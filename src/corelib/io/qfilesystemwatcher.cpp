@@ -88,7 +88,7 @@ QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createNativeEngine(QObject
 }
 
 QFileSystemWatcherPrivate::QFileSystemWatcherPrivate()
-    : native(nullptr), poller(nullptr)
+    : native(nullptr), poller(nullptr), latencyTimer(nullptr), latency(0)
 {
 }
 
@@ -105,6 +105,10 @@ void QFileSystemWatcherPrivate::init()
                          SIGNAL(directoryChanged(QString,bool)),
                          q,
                          SLOT(_q_directoryChanged(QString,bool)));
+        QObject::connect(native, &QFileSystemWatcherEngine::pathsChanged,
+                         q, [this] (const QStringList &p) { _q_pathsChanged(p); });
+        QObject::connect(native, &QFileSystemWatcherEngine::recursivePathRemoved,
+                         q, [this] (const QString &p) { _q_recursivePathRemoved(p); });
 #if defined(Q_OS_WIN)
         QObject::connect(static_cast<QWindowsFileSystemWatcherEngine *>(native),
                          &QWindowsFileSystemWatcherEngine::driveLockForRemoval,
@@ -162,6 +166,44 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+void QFileSystemWatcherPrivate::_q_pathsChanged(const QStringList &paths)
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "paths changed" << paths;
+    for (const QString &path : paths)
+        pendingChanges.insert(path);
+    if (pendingChanges.isEmpty())
+        return;
+
+    if (!latencyTimer) {
+        latencyTimer = new QTimer(q);
+        latencyTimer->setSingleShot(true);
+        QObject::connect(latencyTimer, &QTimer::timeout,
+                         q, [this] { flushPendingChanges(); });
+    }
+    // don't restart a running timer: a steady stream of changes must not
+    // postpone delivery beyond the configured latency
+    if (!latencyTimer->isActive())
+        latencyTimer->start(latency);
+}
+
+void QFileSystemWatcherPrivate::_q_recursivePathRemoved(const QString &path)
+{
+    qCDebug(lcWatcher) << "recursively watched directory removed" << path;
+    recursiveDirectories.removeAll(path);
+}
+
+void QFileSystemWatcherPrivate::flushPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    if (pendingChanges.isEmpty())
+        return;
+    QStringList paths(pendingChanges.cbegin(), pendingChanges.cend());
+    pendingChanges.clear();
+    paths.sort();
+    emit q->pathsChanged(paths, QFileSystemWatcher::QPrivateSignal());
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::_q_winDriveLockForRemoval(const QString &path)
@@ -251,6 +293,20 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     \endlist
     \endlist
 
+    \section1 Watching Directory Trees
+
+    Large directory trees are better watched with addRecursivePath().
+    The watcher then keeps track of subdirectories as they are created,
+    moved and removed, and reports changes anywhere below the watched
+    directory through the pathsChanged() signal. Changes are coalesced:
+    all paths changed within latency() milliseconds of the first change
+    are delivered together in one signal emission.
+
+    Recursive watching is currently only supported on Linux, where it
+    uses a dedicated inotify instance. The per-user inotify watch limit
+    (\c{/proc/sys/fs/inotify/max_user_watches}) still applies to the
+    total number of directories watched.
+
     \sa QFile, QDir
 */
 
@@ -489,6 +545,127 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa directories()
 */
 
+/*!
+    \since 6.0
+
+    Watches the directory \a path and all directories below it.
+    Directories created inside the tree later on are watched
+    automatically, and directories removed or moved out of the tree
+    are no longer watched.
+
+    Changes are reported through the pathsChanged() signal rather than
+    through directoryChanged() or fileChanged(). The reported paths are
+    built from \a path after cleaning it with QDir::cleanPath().
+
+    Returns \c true if the watch was successful. Returns \c false if
+    \a path is not a directory, is already watched recursively, or if
+    the platform does not support recursive watches.
+
+    \sa removeRecursivePath(), recursiveDirectories(), setLatency()
+*/
+bool QFileSystemWatcher::addRecursivePath(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+    if (path.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePath: path is empty");
+        return false;
+    }
+    qCDebug(lcWatcher) << "adding recursively" << path;
+    if (!d->native)
+        return false;
+    return d->native->addRecursivePaths(QStringList(path), &d->recursiveDirectories).isEmpty();
+}
+
+/*!
+    \since 6.0
+
+    Stops watching the directory tree rooted at \a path, which must
+    have been added with addRecursivePath().
+
+    Returns \c true if the watch was successfully removed.
+
+    \sa addRecursivePath()
+*/
+bool QFileSystemWatcher::removeRecursivePath(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+    if (path.isEmpty()) {
+        qWarning("QFileSystemWatcher::removeRecursivePath: path is empty");
+        return false;
+    }
+    qCDebug(lcWatcher) << "removing recursively" << path;
+    if (!d->native)
+        return false;
+    return d->native->removeRecursivePaths(QStringList(path), &d->recursiveDirectories).isEmpty();
+}
+
+/*!
+    \since 6.0
+
+    Returns the list of directory trees that are being watched
+    recursively.
+
+    \sa addRecursivePath()
+*/
+QStringList QFileSystemWatcher::recursiveDirectories() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->recursiveDirectories;
+}
+
+/*!
+    \since 6.0
+
+    Sets the maximum delay, in milliseconds, between a change below a
+    recursively watched directory and the emission of pathsChanged()
+    reporting it to \a msecs. Further changes arriving within that
+    time are merged into the same emission.
+
+    The default latency is 0, which delivers the changes collected by
+    the time control returns to the event loop.
+
+    \sa latency(), pathsChanged()
+*/
+void QFileSystemWatcher::setLatency(int msecs)
+{
+    Q_D(QFileSystemWatcher);
+    d->latency = qMax(0, msecs);
+}
+
+/*!
+    \since 6.0
+
+    Returns the delay, in milliseconds, used to coalesce changes below
+    recursively watched directories.
+
+    \sa setLatency()
+*/
+int QFileSystemWatcher::latency() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->latency;
+}
+
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &paths)
+    \since 6.0
+
+    This signal is emitted with the sorted list of \a paths that were
+    created, modified, moved or removed below a directory added with
+    addRecursivePath(). Each path is reported once per emission, no
+    matter how many times it changed.
+
+    A recursively watched directory that is itself removed or moved
+    away is reported one last time and then dropped from
+    recursiveDirectories().
+
+    If the system dropped events because too many changes happened at
+    once, the roots of all watched trees are reported, and the receiver
+    should rescan them.
+
+    \sa setLatency(), directoryChanged()
+*/
+
 QStringList QFileSystemWatcher::directories() const
 {
     Q_D(const QFileSystemWatcher);
@@ -67,9 +67,17 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addRecursivePath(const QString &path);
+    bool removeRecursivePath(const QString &path);
+    QStringList recursiveDirectories() const;
+
+    void setLatency(int msecs);
+    int latency() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
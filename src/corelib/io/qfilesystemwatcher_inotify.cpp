@@ -44,12 +44,16 @@
 #include "private/qsystemerror_p.h"
 
 #include <qdebug.h>
+#include <qdir.h>
+#include <qdiriterator.h>
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
 #include <qsocketnotifier.h>
 #include <qvarlengtharray.h>
 
+#include <algorithm>
+
 #if defined(Q_OS_LINUX)
 #include <sys/syscall.h>
 #include <sys/ioctl.h>
@@ -233,17 +237,22 @@ static inline int inotify_init1(int flags)
 
 QT_BEGIN_NAMESPACE
 
-QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+static int qt_inotify_init()
 {
     int fd = -1;
 #if defined(IN_CLOEXEC)
     fd = inotify_init1(IN_CLOEXEC);
 #endif
-    if (fd == -1) {
+    if (fd == -1)
         fd = inotify_init();
-        if (fd == -1)
-            return nullptr;
-    }
+    return fd;
+}
+
+QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+{
+    int fd = qt_inotify_init();
+    if (fd == -1)
+        return nullptr;
     return new QInotifyFileSystemWatcherEngine(fd, parent);
 }
 
@@ -263,6 +272,11 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
         inotify_rm_watch(inotifyFd, id < 0 ? -id : id);
 
     ::close(inotifyFd);
+
+    if (recursiveFd != -1) {
+        delete recursiveNotifier;
+        ::close(recursiveFd);
+    }
 }
 
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
@@ -422,6 +436,201 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     }
 }
 
+static bool isInTree(const QString &path, const QString &root)
+{
+    return path.startsWith(root)
+            && (path.size() == root.size() || path.at(root.size()) == QLatin1Char('/')
+                || root.endsWith(QLatin1Char('/')));
+}
+
+QStringList QInotifyFileSystemWatcherEngine::addRecursivePaths(const QStringList &paths,
+                                                               QStringList *recursiveDirectories)
+{
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        const QString root = QDir::cleanPath(path);
+        auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
+        if (recursiveRoots.contains(root) || !QFileInfo(root).isDir())
+            continue;
+
+        if (recursiveFd == -1) {
+            recursiveFd = qt_inotify_init();
+            if (recursiveFd == -1) {
+                qErrnoWarning("inotify_init() failed:");
+                continue;
+            }
+            recursiveNotifier = new QSocketNotifier(recursiveFd, QSocketNotifier::Read, this);
+            connect(recursiveNotifier, &QSocketNotifier::activated,
+                    this, &QInotifyFileSystemWatcherEngine::readFromRecursiveInotify);
+        }
+
+        if (!watchTree(root, nullptr))
+            continue;
+
+        sg.dismiss();
+        recursiveRoots.append(root);
+        recursiveDirectories->append(root);
+    }
+    return unhandled;
+}
+
+QStringList QInotifyFileSystemWatcherEngine::removeRecursivePaths(const QStringList &paths,
+                                                                  QStringList *recursiveDirectories)
+{
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        const QString root = QDir::cleanPath(path);
+        if (!recursiveRoots.removeOne(root)) {
+            unhandled.push_back(path);
+            continue;
+        }
+        unwatchTree(root, true);
+        recursiveDirectories->removeAll(root);
+    }
+    return unhandled;
+}
+
+int QInotifyFileSystemWatcherEngine::addRecursiveWatch(const QString &dir)
+{
+    const int wd = inotify_add_watch(recursiveFd, QFile::encodeName(dir),
+                                     0
+                                     | IN_ATTRIB
+                                     | IN_MODIFY
+                                     | IN_MOVE
+                                     | IN_CREATE
+                                     | IN_DELETE
+                                     | IN_DELETE_SELF
+                                     | IN_MOVE_SELF
+                                     | IN_ONLYDIR
+                                     | IN_DONT_FOLLOW);
+    if (wd >= 0) {
+        // adding an already watched directory returns its existing wd,
+        // possibly under a new name after a move inside the tree
+        recursiveWatches.insert(wd, dir);
+    }
+    return wd;
+}
+
+// Watches \a root and all directories below it. The subdirectories found
+// are added to \a changed, as they may have gained entries before their
+// watch was in place.
+bool QInotifyFileSystemWatcherEngine::watchTree(const QString &root, QSet<QString> *changed)
+{
+    if (addRecursiveWatch(root) < 0) {
+        if (errno != ENOENT)
+            qErrnoWarning("inotify_add_watch(%ls) failed:", qUtf16Printable(root));
+        return false;
+    }
+
+    QDirIterator it(root, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString dir = it.next();
+        if (addRecursiveWatch(dir) < 0) {
+            if (errno == ENOSPC) {
+                // the watch limit is reached: every further directory
+                // would fail the same way
+                qErrnoWarning("inotify_add_watch(%ls) failed:", qUtf16Printable(dir));
+                break;
+            }
+            continue;
+        }
+        if (changed)
+            changed->insert(dir);
+    }
+    return true;
+}
+
+// Stops watching \a root and all directories below it. With \a keepWatched,
+// directories still inside another watched tree remain watched.
+void QInotifyFileSystemWatcherEngine::unwatchTree(const QString &root, bool keepWatched)
+{
+    auto it = recursiveWatches.begin();
+    while (it != recursiveWatches.end()) {
+        const QString &dir = it.value();
+        const auto coveredByOtherRoot = [&dir](const QString &r) { return isInTree(dir, r); };
+        if (isInTree(dir, root)
+                && (!keepWatched || std::none_of(recursiveRoots.cbegin(), recursiveRoots.cend(), coveredByOtherRoot))) {
+            inotify_rm_watch(recursiveFd, it.key());
+            it = recursiveWatches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void QInotifyFileSystemWatcherEngine::readFromRecursiveInotify()
+{
+    int buffSize = 0;
+    ioctl(recursiveFd, FIONREAD, (char *) &buffSize);
+    QVarLengthArray<char, 4096> buffer(buffSize);
+    buffSize = read(recursiveFd, buffer.data(), buffSize);
+    if (buffSize <= 0)
+        return;
+    const char *at = buffer.data();
+    const char * const end = at + buffSize;
+
+    // coalesce the whole read into a single batch
+    QSet<QString> changed;
+    while (at < end) {
+        const inotify_event *event = reinterpret_cast<const inotify_event *>(at);
+        at += sizeof(inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW) {
+            // events were dropped, so every tree needs to be rescanned
+            for (const QString &root : qAsConst(recursiveRoots))
+                changed.insert(root);
+            continue;
+        }
+
+        const auto it = recursiveWatches.constFind(event->wd);
+        if (it == recursiveWatches.cend())
+            continue; // already unwatched
+        const QString dir = it.value();
+
+        if (event->mask & IN_IGNORED) {
+            // the kernel dropped the watch: the directory was deleted,
+            // or its file system unmounted
+            recursiveWatches.remove(event->wd);
+            changed.insert(dir);
+            if (recursiveRoots.removeOne(dir))
+                emit recursivePathRemoved(dir);
+            continue;
+        }
+
+        if ((event->mask & IN_MOVE_SELF) && recursiveRoots.contains(dir)) {
+            // a watched root moved away, its old path no longer exists
+            recursiveRoots.removeOne(dir);
+            unwatchTree(dir, true);
+            changed.insert(dir);
+            emit recursivePathRemoved(dir);
+            continue;
+        }
+
+        if (event->len == 0) {
+            changed.insert(dir);
+            continue;
+        }
+
+        QString path = dir;
+        path += QLatin1Char('/');
+        path += QFile::decodeName(event->name);
+        if (event->mask & IN_ISDIR) {
+            // a directory leaving the tree is unwatched; when it is just
+            // renamed inside the tree, IN_MOVED_TO follows and watches it
+            // again under its new name
+            if (event->mask & IN_MOVED_FROM)
+                unwatchTree(path, false);
+            else if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                watchTree(path, &changed);
+        }
+        changed.insert(std::move(path));
+    }
+
+    if (!changed.isEmpty())
+        emit pathsChanged(QStringList(changed.cbegin(), changed.cend()));
+}
+
 template <typename Hash, typename Key>
 typename Hash::const_iterator
 find_last_in_equal_range(const Hash &c, const Key &key)
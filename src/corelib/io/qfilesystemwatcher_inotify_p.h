@@ -57,6 +57,7 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qsocketnotifier.h>
 
 QT_BEGIN_NAMESPACE
@@ -72,12 +73,18 @@ public:
 
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    QStringList addRecursivePaths(const QStringList &paths, QStringList *recursiveDirectories) override;
+    QStringList removeRecursivePaths(const QStringList &paths, QStringList *recursiveDirectories) override;
 
 private Q_SLOTS:
     void readFromInotify();
+    void readFromRecursiveInotify();
 
 private:
     QString getPathFromID(int id) const;
+    bool watchTree(const QString &root, QSet<QString> *changed);
+    void unwatchTree(const QString &root, bool keepWatched);
+    int addRecursiveWatch(const QString &dir);
 
 private:
     QInotifyFileSystemWatcherEngine(int fd, QObject *parent);
@@ -85,6 +92,13 @@ private:
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+
+    // recursive watches use their own inotify instance, so that their
+    // watch descriptors and masks don't interfere with the ones above
+    int recursiveFd = -1;
+    QSocketNotifier *recursiveNotifier = nullptr;
+    QHash<int, QString> recursiveWatches; // wd -> directory
+    QStringList recursiveRoots;
 };
 
 
@@ -59,9 +59,12 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -84,10 +87,28 @@ public:
     virtual QStringList removePaths(const QStringList &paths,
                                     QStringList *files,
                                     QStringList *directories) = 0;
+    // watches the directory trees rooted at \a paths, appending the
+    // roots it could watch to \a recursiveDirectories; engines without
+    // recursive support return all \a paths unhandled
+    virtual QStringList addRecursivePaths(const QStringList &paths,
+                                          QStringList *recursiveDirectories)
+    {
+        Q_UNUSED(recursiveDirectories);
+        return paths;
+    }
+    virtual QStringList removeRecursivePaths(const QStringList &paths,
+                                             QStringList *recursiveDirectories)
+    {
+        Q_UNUSED(recursiveDirectories);
+        return paths;
+    }
 
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    // one batch of paths changed below recursively watched directories
+    void pathsChanged(const QStringList &paths);
+    void recursivePathRemoved(const QString &path);
 };
 
 class QFileSystemWatcherPrivate : public QObjectPrivate
@@ -103,10 +124,19 @@ public:
 
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
+    QStringList recursiveDirectories;
+
+    // changes below recursiveDirectories, delivered at most every latency msecs
+    QSet<QString> pendingChanges;
+    QTimer *latencyTimer;
+    int latency;
 
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
+    void _q_pathsChanged(const QStringList &paths);
+    void _q_recursivePathRemoved(const QString &path);
+    void flushPendingChanges();
 
 #if defined(Q_OS_WIN)
     void _q_winDriveLockForRemoval(const QString &);
@@ -1824,6 +1824,30 @@ qint64 QIODevicePrivate::peek(char *data, qint64 maxSize)
     return read(data, maxSize, true);
 }
 
+/*!
+    \internal
+
+    Returns a native descriptor that QFileDevice::transferTo() may write to
+    directly, bypassing this device, or -1 if there is none. Devices only
+    return a descriptor if writing to it is equivalent to calling write(),
+    so there must be no pending data in their own buffers.
+*/
+qintptr QIODevicePrivate::nativeWriteDescriptor()
+{
+    return -1;
+}
+
+/*!
+    \internal
+
+    Called after \a size bytes were written directly to the descriptor
+    returned by nativeWriteDescriptor().
+*/
+void QIODevicePrivate::nativeDataWritten(qint64 size)
+{
+    Q_UNUSED(size);
+}
+
 /*!
     \internal
 */
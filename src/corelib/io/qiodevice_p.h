@@ -183,6 +183,10 @@ public:
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
+
+    // support for QFileDevice::transferTo()
+    virtual qintptr nativeWriteDescriptor();
+    virtual void nativeDataWritten(qint64 size);
     void write(const char *data, qint64 size);
 
 #ifdef QT_NO_QOBJECT
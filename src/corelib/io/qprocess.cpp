@@ -1558,6 +1558,10 @@ std::function<void(void)> QProcess::childProcessModifier() const
     "async-signal-safe" is advised). Most of the Qt API is unsafe inside this
     callback, including qDebug(), and may lead to deadlocks.
 
+    \note Without a modifier, QProcess on Linux starts the child with
+    \c{vfork()} semantics, which is considerably faster for processes using a
+    lot of memory. Setting a modifier makes it use a full \c{fork()}.
+
     \sa childProcessModifier()
 */
 void QProcess::setChildProcessModifier(const std::function<void(void)> &modifier)
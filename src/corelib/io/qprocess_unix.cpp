@@ -353,6 +353,21 @@ static char **_q_dupEnvironment(const QProcessEnvironmentPrivate::Map &environme
     return envp;
 }
 
+struct ExecChildArguments
+{
+    QProcessPrivate *d;
+    const char *workingDir;
+    char **argv;
+    char **envp;
+
+    static int run(void *token)
+    {
+        auto args = static_cast<ExecChildArguments *>(token);
+        args->d->execChild(args->workingDir, args->argv, args->envp);
+        return -1;
+    }
+};
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -452,7 +467,18 @@ void QProcessPrivate::startProcess()
 #endif
 
     pid_t childPid;
-    forkfd = ::forkfd(ffdflags , &childPid);
+    if (childProcessModifier) {
+        // the modifier may run arbitrary code, so it needs a full copy of
+        // our address space
+        forkfd = ::forkfd(ffdflags , &childPid);
+    } else {
+        // execChild() only runs async-signal-safe code and modifies nothing
+        // but its stack, so the child can share our memory until it execs
+        // instead of copying our page tables, which is costly for a large
+        // parent process
+        ExecChildArguments args = { this, workingDirPtr, argv, envp };
+        forkfd = ::vforkfd(ffdflags, &childPid, &ExecChildArguments::run, &args);
+    }
     int lastForkErrno = errno;
     if (forkfd != FFD_CHILD_PROCESS) {
         // Parent process.
@@ -531,6 +557,9 @@ struct ChildError
     char function[8];
 };
 
+// Runs in the child process. Unless a childProcessModifier is set, the child
+// shares our memory until it execs, so this must not modify anything but
+// local variables.
 void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp)
 {
     ::signal(SIGPIPE, SIG_DFL);         // reset the signal that we ignored
@@ -585,7 +614,6 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
 report_errno:
     error.code = errno;
     qt_safe_write(childStartedPipe[1], &error, sizeof(error));
-    childStartedPipe[1] = -1;
 }
 
 bool QProcessPrivate::processStarted(QString *errorMessage)
@@ -42,6 +42,8 @@
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
 #include "qset.h"
+#include "qcache.h"
+#include "qmutex.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
 #include "qlocale.h"
@@ -146,12 +148,20 @@ private:
     uint hash(int node) const;
     QString name(int node) const;
     short flags(int node) const;
+
+    // maps the full path of every reachable node to the first node with its
+    // name, and the end of its sibling range; built on the first lookup
+    struct IndexEntry { qint32 node; qint32 end; };
+    typedef QHash<QString, IndexEntry> NodeIndex;
+    mutable QAtomicPointer<NodeIndex> nodeIndex;
+    const NodeIndex *index() const;
+    void indexChildren(NodeIndex *index, const QString &path, int node) const;
 public:
     mutable QAtomicInt ref;
 
     inline QResourceRoot(): tree(nullptr), names(nullptr), payloads(nullptr), version(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
-    virtual ~QResourceRoot() { }
+    virtual ~QResourceRoot();
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
     QResource::Compression compressionAlgo(int node)
@@ -181,9 +191,39 @@ protected:
         names = n;
         payloads = d;
         version = v;
+        delete nodeIndex.fetchAndStoreRelaxed(nullptr);
     }
 };
 
+// Decompressed contents of recently used compressed resources, so that
+// opening the same resource again doesn't decompress it again
+struct QResourceCacheKey
+{
+    const QResourceRoot *root;
+    const uchar *data;
+
+    friend bool operator==(const QResourceCacheKey &lhs, const QResourceCacheKey &rhs) noexcept
+    { return lhs.root == rhs.root && lhs.data == rhs.data; }
+};
+
+static size_t qHash(const QResourceCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.root, key.data);
+}
+
+struct QResourceDecompressionCache
+{
+    enum {
+        MaxCost = 8 * 1024 * 1024,
+        // bigger entries aren't worth evicting everything else for
+        MaxEntryCost = MaxCost / 16
+    };
+
+    QBasicMutex mutex;
+    QCache<QResourceCacheKey, QByteArray> cache { MaxCost };
+};
+Q_GLOBAL_STATIC(QResourceDecompressionCache, decompressionCache)
+
 static QString cleanPath(const QString &_path)
 {
     QString path = QDir::cleanPath(_path);
@@ -701,8 +741,9 @@ const uchar *QResource::data() const
     compressed. If the resource is a directory or an error occurs while
     decompressing, a null QByteArray is returned.
 
-    \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    \note If the data was compressed, this function has to decompress it. The
+    results for small resources are kept in a bounded cache shared by the whole
+    process, so that repeated calls for them are cheap.
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -720,13 +761,26 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+    const QResourceCacheKey key = { d->related.first(), d->data };
+    const bool cacheable = n <= QResourceDecompressionCache::MaxEntryCost;
+    if (cacheable) {
+        const auto locker = qt_scoped_lock(decompressionCache->mutex);
+        if (const QByteArray *cached = decompressionCache->cache.object(key))
+            return *cached;
+    }
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
-    if (n < 0)
+    if (n < 0) {
         result.clear();
-    else
+    } else {
         result.truncate(n);
+        if (cacheable) {
+            const auto locker = qt_scoped_lock(decompressionCache->mutex);
+            decompressionCache->cache.insert(key, new QByteArray(result), qMax(n, qint64(1)));
+        }
+    }
     return result;
 }
 
@@ -771,6 +825,21 @@ QStringList QResource::children() const
     return d->children;
 }
 
+QResourceRoot::~QResourceRoot()
+{
+    delete nodeIndex.loadRelaxed();
+
+    // our data may be unmapped now, and our address reused by another root
+    if (decompressionCache.exists()) {
+        const auto locker = qt_scoped_lock(decompressionCache->mutex);
+        const auto keys = decompressionCache->cache.keys();
+        for (const QResourceCacheKey &key : keys) {
+            if (key.root == this)
+                decompressionCache->cache.remove(key);
+        }
+    }
+}
+
 inline uint QResourceRoot::hash(int node) const
 {
     if (!node) // root
@@ -823,6 +892,41 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
     if (path == QLatin1String("/"))
         return 0;
 
+    // paths as produced by cleanPath() can be looked up directly
+    if (path.startsWith(QLatin1Char('/')) && !path.endsWith(QLatin1Char('/'))
+            && !path.contains(QLatin1String("//"))) {
+        const NodeIndex *idx = index();
+        const auto it = idx->constFind(path);
+        if (it == idx->cend())
+            return -1;
+
+        // pick the best localization among the nodes of that name
+        const QStringView segment = QStringView(path).mid(path.lastIndexOf(QLatin1Char('/')) + 1);
+        const uint h = hash(it->node);
+        int node = -1;
+        for (int sub_node = it->node; sub_node < it->end && hash(sub_node) == h; ++sub_node) {
+            if (name(sub_node) != segment)
+                continue;
+            int offset = findOffset(sub_node) + 4; // jump past name
+            const qint16 flags = qFromBigEndian<qint16>(tree + offset);
+            offset += 2;
+            if (flags & Directory)
+                return sub_node;
+
+            const qint16 country = qFromBigEndian<qint16>(tree + offset);
+            offset += 2;
+            const qint16 language = qFromBigEndian<qint16>(tree + offset);
+            if (country == locale.country() && language == locale.language()) {
+                return sub_node;
+            } else if ((country == QLocale::AnyCountry && language == locale.language())
+                       || (country == QLocale::AnyCountry && language == QLocale::C
+                           && node == -1)) {
+                node = sub_node;
+            }
+        }
+        return node;
+    }
+
     // the root node is always first
     qint32 child_count = qFromBigEndian<qint32>(tree + 6);
     qint32 child       = qFromBigEndian<qint32>(tree + 10);
@@ -924,6 +1028,44 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
 #endif
     return node;
 }
+
+const QResourceRoot::NodeIndex *QResourceRoot::index() const
+{
+    if (const NodeIndex *idx = nodeIndex.loadAcquire())
+        return idx;
+
+    NodeIndex *idx = new NodeIndex;
+    indexChildren(idx, QString(), 0);
+    if (!nodeIndex.testAndSetOrdered(nullptr, idx)) {
+        // another thread was faster
+        delete idx;
+        return nodeIndex.loadAcquire();
+    }
+    return idx;
+}
+
+void QResourceRoot::indexChildren(NodeIndex *idx, const QString &path, int node) const
+{
+    int offset = findOffset(node) + 4; // jump past name
+    const qint16 flags = qFromBigEndian<qint16>(tree + offset);
+    offset += 2;
+    if (!(flags & Directory))
+        return;
+
+    const qint32 child_count = qFromBigEndian<qint32>(tree + offset);
+    offset += 4;
+    const qint32 child = qFromBigEndian<qint32>(tree + offset);
+    for (int sub_node = child; sub_node < child + child_count; ++sub_node) {
+        QString subPath = path + QLatin1Char('/') + name(sub_node);
+        // only the first node of a given name is searched for children,
+        // the others are localizations of it
+        if (idx->contains(subPath))
+            continue;
+        idx->insert(subPath, { sub_node, child + child_count });
+        indexChildren(idx, subPath, sub_node);
+    }
+}
+
 short QResourceRoot::flags(int node) const
 {
     if (node == -1)
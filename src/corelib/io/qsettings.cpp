@@ -69,6 +69,10 @@
 #include "qlockfile.h"
 #endif
 
+#ifdef QT_QSETTINGS_BACKGROUND_SYNC
+#include "qthreadpool.h"
+#endif
+
 #ifdef Q_OS_VXWORKS
 #  include <ioLib.h>
 #endif
@@ -131,6 +135,17 @@ Q_GLOBAL_STATIC(ConfFileCache, unusedCacheFunc)
 Q_GLOBAL_STATIC(PathHash, pathHashFunc)
 Q_GLOBAL_STATIC(CustomFormatVector, customFormatVectorFunc)
 
+#ifdef QT_QSETTINGS_BACKGROUND_SYNC
+namespace {
+// A single thread, so that the writes of one file cannot overtake each other
+struct QSettingsSyncThreadPool : public QThreadPool
+{
+    QSettingsSyncThreadPool() { setMaxThreadCount(1); }
+};
+}
+Q_GLOBAL_STATIC(QSettingsSyncThreadPool, settingsSyncThreadPool)
+#endif
+
 static QBasicMutex settingsGlobalMutex;
 
 static QSettings::Format globalDefaultFormat = QSettings::NativeFormat;
@@ -1301,9 +1316,60 @@ void QConfFileSettingsPrivate::sync()
 
 void QConfFileSettingsPrivate::flush()
 {
+#ifdef QT_QSETTINGS_BACKGROUND_SYNC
+    if (backgroundSync) {
+        scheduleBackgroundSync();
+        return;
+    }
+#endif
     sync();
 }
 
+#ifdef QT_QSETTINGS_BACKGROUND_SYNC
+/*
+    Writes the changes of all files on the sync thread. A file that is
+    already waiting there is not queued again: the changes made in the
+    meantime are part of the same write.
+*/
+void QConfFileSettingsPrivate::scheduleBackgroundSync()
+{
+    QThreadPool *pool = settingsSyncThreadPool();
+    if (!pool) {
+        // The pool is gone while static data is being destroyed, so write the changes now
+        sync();
+        return;
+    }
+
+    for (auto confFile : qAsConst(confFiles)) {
+        {
+            const auto locker = qt_scoped_lock(confFile->mutex);
+            if (confFile->backgroundSyncScheduled
+                || (confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty())) {
+                continue;
+            }
+            confFile->backgroundSyncScheduled = true;
+        }
+        // Keep the file, and with it the changes, alive until the write is done
+        confFile->ref.ref();
+        const QSettings::Format fmt = format;
+        const bool atomic = atomicSyncOnly;
+        pool->start([confFile, fmt, atomic]() {
+            {
+                const auto locker = qt_scoped_lock(confFile->mutex);
+                confFile->backgroundSyncScheduled = false;
+            }
+            // Loading the shared file syncs it
+            QSettings settings(confFile->name, fmt);
+            confFile->ref.deref(); // settings holds its own reference now
+            if (!atomic) {
+                settings.setAtomicSyncRequired(false);
+                settings.sync();
+            }
+        });
+    }
+}
+#endif
+
 QString QConfFileSettingsPrivate::fileName() const
 {
     if (confFiles.isEmpty())
@@ -2863,6 +2929,50 @@ void QSettings::setAtomicSyncRequired(bool enable)
     d->atomicSyncOnly = enable;
 }
 
+/*!
+    \since 6.0
+
+    Returns \c true if QSettings writes changes to permanent storage on a
+    background thread; otherwise returns \c false.
+
+    The default is \c false.
+
+    \sa setBackgroundSyncEnabled(), sync()
+*/
+bool QSettings::isBackgroundSyncEnabled() const
+{
+    Q_D(const QSettings);
+    return d->backgroundSync;
+}
+
+/*!
+    \since 6.0
+
+    Configures whether the changes made through this QSettings object are
+    written to permanent storage on a background thread. If \a enable is
+    \c true, the writes that would otherwise happen from the event loop and in
+    the destructor are queued instead, so that neither blocks on the file
+    system. Changes made while a write is still queued are merged into it,
+    which makes this mode a good fit for applications that store small
+    changes often.
+
+    The changes are immediately visible to all QSettings objects in the
+    application that refer to the same file, as usual. Calling sync()
+    still writes the changes and reloads the settings on the calling thread,
+    and reports errors through status(); errors of background writes are
+    not reported.
+
+    This setting only has an effect for settings stored in files, which
+    excludes QSettings::NativeFormat on Windows and Apple platforms.
+
+    \sa isBackgroundSyncEnabled(), sync(), setAtomicSyncRequired()
+*/
+void QSettings::setBackgroundSyncEnabled(bool enable)
+{
+    Q_D(QSettings);
+    d->backgroundSync = enable;
+}
+
 /*!
     Appends \a prefix to the current group.
 
@@ -150,6 +150,9 @@ public:
     bool isAtomicSyncRequired() const;
     void setAtomicSyncRequired(bool enable);
 
+    bool isBackgroundSyncEnabled() const;
+    void setBackgroundSyncEnabled(bool enable);
+
     void beginGroup(const QString &prefix);
     void endGroup();
     QString group() const;
@@ -74,6 +74,10 @@ QT_BEGIN_NAMESPACE
 // used in testing framework
 #define QSETTINGS_P_H_VERSION 3
 
+#if QT_CONFIG(thread) && !defined(QT_NO_QOBJECT) && !defined(QT_BOOTSTRAPPED) && !defined(Q_OS_WASM)
+#define QT_QSETTINGS_BACKGROUND_SYNC
+#endif
+
 #ifdef QT_QSETTINGS_ALWAYS_CASE_SENSITIVE_AND_FORGET_ORIGINAL_KEY_ORDER
 static const Qt::CaseSensitivity IniCaseSensitivity = Qt::CaseSensitive;
 
@@ -168,6 +172,7 @@ public:
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
+    bool backgroundSyncScheduled = false;
 
 private:
 #ifdef Q_DISABLE_COPY
@@ -247,6 +252,7 @@ protected:
     bool fallbacks;
     bool pendingChanges;
     bool atomicSyncOnly = true;
+    bool backgroundSync = false;
     mutable QSettings::Status status;
 };
 
@@ -274,6 +280,10 @@ public:
     bool isWritable() const override;
     QString fileName() const override;
 
+#ifdef QT_QSETTINGS_BACKGROUND_SYNC
+    void scheduleBackgroundSync();
+#endif
+
     bool readIniFile(const QByteArray &data, UnparsedSettingsMap *unparsedIniSections);
     static bool readIniSection(const QSettingsKey &section, const QByteArray &data,
                                ParsedSettingsMap *settingsMap);
@@ -41,6 +41,7 @@ HEADERS += \
         kernel/qassociativeiterable.h \
         kernel/qsharedmemory.h \
         kernel/qsharedmemory_p.h \
+        kernel/qsharedmemorychannel.h \
         kernel/qsystemsemaphore.h \
         kernel/qsystemsemaphore_p.h \
         kernel/qfunctions_p.h \
@@ -78,6 +79,7 @@ SOURCES += \
         kernel/qsequentialiterable.cpp \
         kernel/qassociativeiterable.cpp \
         kernel/qsharedmemory.cpp \
+        kernel/qsharedmemorychannel.cpp \
         kernel/qsystemsemaphore.cpp \
         kernel/qpointer.cpp \
         kernel/qmath.cpp \
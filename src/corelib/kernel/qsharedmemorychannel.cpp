@@ -0,0 +1,1088 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsharedmemorychannel.h"
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include "qcoreapplication.h"
+#include "qsharedmemory.h"
+#include "qdeadlinetimer.h"
+#include "qthread.h"
+#include "private/qiodevice_p.h"
+
+#ifdef Q_OS_WIN
+#  include <qt_windows.h>
+#else
+#  include <errno.h>
+#  include <signal.h>
+#endif
+
+#if defined(Q_OS_LINUX) && !defined(QT_LINUXBASE)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <limits.h>
+#  include <time.h>
+#  include <unistd.h>
+#  define QSHAREDMEMORYCHANNEL_USE_FUTEX
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+enum : quint32 {
+    ChannelMagic = 0x514d4348,      // "QMCH"
+    ChannelVersion = 2,
+    RecordHeaderSize = sizeof(quint32),
+    MinimumCapacity = 64,
+    MaximumCapacity = 1U << 30,
+    MaximumEndpoints = 16,
+    YieldCount = 8,
+    LivenessCheckInterval = 250     // milliseconds
+};
+
+/*
+    The endpoints attached to one side of the channel. Each endpoint holds a
+    slot with its process id, so that the others can tell when it died
+    without detaching. With several endpoints on a side, \c lock serializes
+    them; it holds the slot number plus one of the endpoint that owns it.
+*/
+struct Endpoints
+{
+    QBasicAtomicInt attached;
+    QBasicAtomicInt everAttached;
+    QBasicAtomicInt lock;
+    QBasicAtomicInt lockWaiters;
+    QBasicAtomicInt pids[MaximumEndpoints];
+};
+
+/*
+    The control block at the start of the shared memory segment. The ring
+    buffer follows it. Positions are free-running 32-bit counters; the
+    capacity is a power of two, so they index the ring modulo capacity and
+    differences between them stay correct across wrap-around.
+
+    Each side writes only to its own cache line, so the producer and the
+    consumer do not contend unless one of them has to sleep.
+*/
+struct ChannelHeader
+{
+    QBasicAtomicInteger<quint32> magic;
+    quint32 version;
+    quint32 capacity;
+    quint32 options;
+
+    // written by the producer
+    alignas(64) QBasicAtomicInteger<quint32> writePos;
+    QBasicAtomicInteger<quint32> bytesWritten;
+
+    // written by the consumer; readRecordEnd is where the record that is
+    // being read ends, and readRecordEndBytes what bytesRead will be there
+    alignas(64) QBasicAtomicInteger<quint32> readPos;
+    QBasicAtomicInteger<quint32> bytesRead;
+    QBasicAtomicInteger<quint32> readRecordEnd;
+    QBasicAtomicInteger<quint32> readRecordEndBytes;
+
+    // bumped by the producer, waited on by the consumer
+    alignas(64) QBasicAtomicInt dataSequence;
+    QBasicAtomicInt dataWaiters;
+
+    // bumped by the consumer, waited on by the producer
+    alignas(64) QBasicAtomicInt spaceSequence;
+    QBasicAtomicInt spaceWaiters;
+
+    alignas(64) Endpoints writers;
+    alignas(64) Endpoints readers;
+};
+static_assert(sizeof(ChannelHeader) % 64 == 0);
+} // unnamed namespace
+
+#ifdef QSHAREDMEMORYCHANNEL_USE_FUTEX
+// Unlike QtLinuxFutex, these must not use FUTEX_PRIVATE_FLAG: the futex word
+// lives in memory shared with another process.
+static void futexWait(QBasicAtomicInt &futex, int expectedValue, qint64 nsecs)
+{
+    struct timespec ts;
+    struct timespec *timeout = nullptr;
+    if (nsecs >= 0) {
+        ts.tv_sec = nsecs / (1000 * 1000 * 1000);
+        ts.tv_nsec = nsecs % (1000 * 1000 * 1000);
+        timeout = &ts;
+    }
+    syscall(__NR_futex, reinterpret_cast<int *>(&futex), FUTEX_WAIT, expectedValue,
+            timeout, nullptr, 0);
+}
+
+static void futexWake(QBasicAtomicInt &futex)
+{
+    syscall(__NR_futex, reinterpret_cast<int *>(&futex), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#else
+// No cross-process wait primitive: poll.
+static void futexWait(QBasicAtomicInt &futex, int expectedValue, qint64 nsecs)
+{
+    if (futex.loadAcquire() != expectedValue)
+        return;
+    const qint64 MaximumSleep = 500 * 1000;
+    QThread::usleep(ulong((nsecs < 0 ? MaximumSleep : qMin(nsecs, MaximumSleep)) / 1000));
+}
+
+static void futexWake(QBasicAtomicInt &)
+{
+}
+#endif
+
+// A process that has exited but not been reaped by its parent yet still
+// counts as alive.
+static bool processIsAlive(int pid)
+{
+    if (pid == int(QCoreApplication::applicationPid()))
+        return true;
+#ifdef Q_OS_WIN
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, DWORD(pid));
+    if (!process)
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return ::kill(pid_t(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+class QSharedMemoryChannelPrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QSharedMemoryChannel)
+
+public:
+    bool attach(QIODevice::OpenMode mode);
+    void detach();
+
+    bool claimSlot(Endpoints &side, int limit);
+    void reapDeadEndpoints(Endpoints &side);
+    void lock(Endpoints &side);
+    void unlock(Endpoints &side);
+
+    void copyIn(quint32 pos, const void *data, quint32 len);
+    void copyOut(quint32 pos, void *data, quint32 len) const;
+
+    bool writeRecord(const char *data, quint32 len, QDeadlineTimer deadline);
+    bool nextRecord();
+    bool takeRecord();
+    void consume(quint32 len);
+    void publishRead();
+    void setCorrupted();
+
+    template <typename Condition>
+    bool waitFor(QBasicAtomicInt &sequence, QBasicAtomicInt &waiters, Condition condition,
+                 QDeadlineTimer deadline);
+    void notify(QBasicAtomicInt &sequence, QBasicAtomicInt &waiters);
+
+    bool dataAvailable() const;
+    bool peerClosed() const;
+    Endpoints &peers() const { return producer ? header->readers : header->writers; }
+    bool sharedWriters() const { return options & QSharedMemoryChannel::MultipleWriters; }
+    bool sharedReaders() const { return options & QSharedMemoryChannel::MultipleReaders; }
+
+    QSharedMemory memory;
+    ChannelHeader *header = nullptr;
+    uchar *ring = nullptr;
+    quint32 capacity = 0;
+    QSharedMemoryChannel::ChannelOptions options;
+    int slot = -1;
+    bool producer = false;
+    bool corrupted = false;
+
+    // producer side
+    quint32 writePos = 0;
+    quint32 cachedReadPos = 0;
+    quint32 bytesWritten = 0;
+
+    // consumer side
+    quint32 readPos = 0;
+    quint32 recordRemaining = 0;
+    quint32 bytesRead = 0;
+
+    // with several readers, a record is taken out of the ring as a whole
+    QByteArray pendingMessage;
+    qsizetype pendingOffset = 0;
+    bool messagePending = false;
+};
+
+bool QSharedMemoryChannelPrivate::dataAvailable() const
+{
+    if (corrupted)
+        return false;
+    if (recordRemaining || messagePending)
+        return true;
+    return header->writePos.loadAcquire() != header->readPos.loadAcquire();
+}
+
+// The peer side has reached the end of the stream once every endpoint that
+// attached to it has closed the channel or died.
+bool QSharedMemoryChannelPrivate::peerClosed() const
+{
+    const Endpoints &side = peers();
+    return side.everAttached.loadAcquire() && side.attached.loadAcquire() == 0;
+}
+
+bool QSharedMemoryChannelPrivate::claimSlot(Endpoints &side, int limit)
+{
+    int count = side.attached.loadAcquire();
+    do {
+        if (count >= limit)
+            return false;
+    } while (!side.attached.testAndSetOrdered(count, count + 1, count));
+
+    // A slot is released before the count drops, so there is a free one.
+    const int pid = int(QCoreApplication::applicationPid());
+    for (int i = 0; ; i = (i + 1) % MaximumEndpoints) {
+        if (side.pids[i].testAndSetOrdered(0, pid)) {
+            slot = i;
+            break;
+        }
+    }
+    side.everAttached.storeRelease(1);
+    return true;
+}
+
+// Releases the slots, and the lock, of endpoints whose process has died.
+void QSharedMemoryChannelPrivate::reapDeadEndpoints(Endpoints &side)
+{
+    bool reaped = false;
+    for (int i = 0; i < int(MaximumEndpoints); ++i) {
+        const int pid = side.pids[i].loadAcquire();
+        if (!pid || processIsAlive(pid))
+            continue;
+        // release the lock before the slot, so that it is not inherited by
+        // the next endpoint to take the slot
+        if (side.lock.testAndSetOrdered(i + 1, 0) && side.lockWaiters.loadAcquire())
+            futexWake(side.lock);
+        if (side.pids[i].testAndSetOrdered(pid, 0)) {
+            side.attached.fetchAndSubOrdered(1);
+            reaped = true;
+        }
+    }
+    if (reaped) {
+        notify(header->dataSequence, header->dataWaiters);
+        notify(header->spaceSequence, header->spaceWaiters);
+    }
+}
+
+void QSharedMemoryChannelPrivate::lock(Endpoints &side)
+{
+    const int token = slot + 1;
+    for (quint32 i = 0; i < YieldCount; ++i) {
+        if (side.lock.testAndSetAcquire(0, token))
+            return;
+        QThread::yieldCurrentThread();
+    }
+
+    QDeadlineTimer livenessCheck(LivenessCheckInterval);
+    for (;;) {
+        side.lockWaiters.fetchAndAddOrdered(1);
+        const int owner = side.lock.fetchAndAddOrdered(0);
+        const bool locked = owner == 0 && side.lock.testAndSetOrdered(0, token);
+        if (owner != 0)
+            futexWait(side.lock, owner, livenessCheck.remainingTimeNSecs());
+        side.lockWaiters.fetchAndSubOrdered(1);
+        if (locked)
+            return;
+        if (livenessCheck.hasExpired()) {
+            reapDeadEndpoints(side);
+            livenessCheck.setRemainingTime(LivenessCheckInterval);
+        }
+    }
+}
+
+void QSharedMemoryChannelPrivate::unlock(Endpoints &side)
+{
+    side.lock.fetchAndStoreOrdered(0);
+    if (side.lockWaiters.fetchAndAddOrdered(0))
+        futexWake(side.lock);
+}
+
+void QSharedMemoryChannelPrivate::copyIn(quint32 pos, const void *data, quint32 len)
+{
+    const quint32 offset = pos & (capacity - 1);
+    const quint32 first = qMin(len, capacity - offset);
+    memcpy(ring + offset, data, first);
+    memcpy(ring, static_cast<const char *>(data) + first, len - first);
+}
+
+void QSharedMemoryChannelPrivate::copyOut(quint32 pos, void *data, quint32 len) const
+{
+    const quint32 offset = pos & (capacity - 1);
+    const quint32 first = qMin(len, capacity - offset);
+    memcpy(data, ring + offset, first);
+    memcpy(static_cast<char *>(data) + first, ring, len - first);
+}
+
+/*
+    The wake-up protocol: a side that wants to sleep registers in \a waiters,
+    samples \a sequence, and only then re-checks \a condition. The other side
+    publishes its position, bumps \a sequence and only then looks at
+    \a waiters. With sequentially consistent operations on both words,
+    either the sleeper sees the new position or the waker sees the sleeper,
+    and FUTEX_WAIT refuses to sleep once \a sequence has moved on.
+
+    A peer that dies never wakes us up, so sleeps are bounded by the
+    liveness check interval, after which dead peers are detached.
+*/
+template <typename Condition>
+bool QSharedMemoryChannelPrivate::waitFor(QBasicAtomicInt &sequence, QBasicAtomicInt &waiters,
+                                          Condition condition, QDeadlineTimer deadline)
+{
+    if (condition())
+        return true;
+
+    // The other side is usually in the middle of producing or consuming
+    // more; give it a chance to finish before paying for a sleep and a
+    // wake-up system call.
+    for (quint32 i = 0; i < YieldCount && !deadline.hasExpired(); ++i) {
+        QThread::yieldCurrentThread();
+        if (condition())
+            return true;
+    }
+
+    QDeadlineTimer livenessCheck(LivenessCheckInterval);
+    for (;;) {
+        waiters.fetchAndAddOrdered(1);
+        const int current = sequence.fetchAndAddOrdered(0);
+        const bool done = condition();
+        if (!done && !deadline.hasExpired()) {
+            qint64 nsecs = livenessCheck.remainingTimeNSecs();
+            if (!deadline.isForever())
+                nsecs = qMin(nsecs, deadline.remainingTimeNSecs());
+            futexWait(sequence, current, nsecs);
+        }
+        waiters.fetchAndSubOrdered(1);
+        if (done)
+            return true;
+        if (deadline.hasExpired())
+            return condition();
+        if (livenessCheck.hasExpired()) {
+            reapDeadEndpoints(peers());
+            livenessCheck.setRemainingTime(LivenessCheckInterval);
+        }
+    }
+}
+
+void QSharedMemoryChannelPrivate::notify(QBasicAtomicInt &sequence, QBasicAtomicInt &waiters)
+{
+    sequence.fetchAndAddOrdered(1);
+    if (waiters.fetchAndAddOrdered(0))
+        futexWake(sequence);
+}
+
+bool QSharedMemoryChannelPrivate::writeRecord(const char *data, quint32 len,
+                                              QDeadlineTimer deadline)
+{
+    const bool shared = sharedWriters();
+    if (shared) {
+        lock(header->writers);
+        writePos = header->writePos.loadRelaxed();
+        bytesWritten = header->bytesWritten.loadRelaxed();
+        cachedReadPos = header->readPos.loadAcquire();
+    }
+
+    const quint32 needed = RecordHeaderSize + len;
+    bool ok = true;
+    if (capacity - (writePos - cachedReadPos) < needed) {
+        const auto hasSpace = [&] {
+            cachedReadPos = header->readPos.loadAcquire();
+            return capacity - (writePos - cachedReadPos) >= needed || peerClosed();
+        };
+        if (!waitFor(header->spaceSequence, header->spaceWaiters, hasSpace, deadline)) {
+            errorString = QSharedMemoryChannel::tr("Timed out waiting for the reader");
+            ok = false;
+        }
+    }
+    if (ok && peerClosed()) {
+        errorString = QSharedMemoryChannel::tr("The reader has closed the channel");
+        ok = false;
+    }
+    if (ok && writePos - cachedReadPos > capacity) {
+        errorString = QSharedMemoryChannel::tr("The channel is corrupt");
+        ok = false;
+    }
+
+    if (ok) {
+        copyIn(writePos, &len, RecordHeaderSize);
+        copyIn(writePos + RecordHeaderSize, data, len);
+        writePos += needed;
+        bytesWritten += len;
+        header->writePos.storeRelease(writePos);
+        header->bytesWritten.storeRelease(bytesWritten);
+        notify(header->dataSequence, header->dataWaiters);
+    }
+    if (shared)
+        unlock(header->writers);
+    return ok;
+}
+
+void QSharedMemoryChannelPrivate::setCorrupted()
+{
+    corrupted = true;
+    errorString = QSharedMemoryChannel::tr("The channel is corrupt");
+}
+
+// Consumes the header of the next record, if there is one. The record
+// length comes from memory the other processes can write to, so it must
+// fit into what the writer has published.
+bool QSharedMemoryChannelPrivate::nextRecord()
+{
+    Q_ASSERT(recordRemaining == 0);
+    if (corrupted)
+        return false;
+    const quint32 available = header->writePos.loadAcquire() - readPos;
+    if (available == 0)
+        return false;
+
+    quint32 length = 0;
+    if (available > capacity || available < RecordHeaderSize) {
+        setCorrupted();
+        return false;
+    }
+    copyOut(readPos, &length, RecordHeaderSize);
+    if (length > available - RecordHeaderSize) {
+        setCorrupted();
+        return false;
+    }
+
+    readPos += RecordHeaderSize;
+    recordRemaining = length;
+    // lets the next reader skip the rest of the record if this one dies
+    header->readRecordEndBytes.storeRelaxed(bytesRead + length);
+    header->readRecordEnd.storeRelease(readPos + length);
+    return true;
+}
+
+// With several readers, takes the next record out of the ring as a whole.
+bool QSharedMemoryChannelPrivate::takeRecord()
+{
+    Q_ASSERT(!messagePending);
+    lock(header->readers);
+    readPos = header->readPos.loadRelaxed();
+    bytesRead = header->bytesRead.loadRelaxed();
+    const bool taken = nextRecord();
+    if (taken) {
+        pendingMessage = QByteArray(recordRemaining, Qt::Uninitialized);
+        copyOut(readPos, pendingMessage.data(), recordRemaining);
+        consume(recordRemaining);
+        publishRead();
+        pendingOffset = 0;
+        messagePending = true;
+    }
+    unlock(header->readers);
+    return taken;
+}
+
+void QSharedMemoryChannelPrivate::consume(quint32 len)
+{
+    readPos += len;
+    recordRemaining -= len;
+    bytesRead += len;
+}
+
+void QSharedMemoryChannelPrivate::publishRead()
+{
+    header->readPos.storeRelease(readPos);
+    header->bytesRead.storeRelease(bytesRead);
+    notify(header->spaceSequence, header->spaceWaiters);
+}
+
+bool QSharedMemoryChannelPrivate::attach(QIODevice::OpenMode mode)
+{
+    Q_Q(QSharedMemoryChannel);
+    const auto fail = [this](const QString &message) {
+        errorString = message;
+        header = nullptr;
+        memory.detach();
+        return false;
+    };
+
+    header = static_cast<ChannelHeader *>(memory.data());
+    if (memory.size() < qsizetype(sizeof(ChannelHeader))
+            || header->magic.loadAcquire() != ChannelMagic
+            || header->version != ChannelVersion) {
+        return fail(QSharedMemoryChannel::tr("%1: not a channel").arg(memory.key()));
+    }
+    const quint32 ringSize = header->capacity;
+    if (ringSize < MinimumCapacity || ringSize > MaximumCapacity || (ringSize & (ringSize - 1))
+            || memory.size() < qsizetype(sizeof(ChannelHeader) + ringSize)) {
+        return fail(QSharedMemoryChannel::tr("%1: invalid channel capacity %2")
+                    .arg(memory.key()).arg(ringSize));
+    }
+
+    producer = mode & QIODevice::WriteOnly;
+    options = QSharedMemoryChannel::ChannelOptions(QFlag(int(header->options
+            & (QSharedMemoryChannel::MultipleWriters | QSharedMemoryChannel::MultipleReaders))));
+    Endpoints &side = producer ? header->writers : header->readers;
+    const bool shared = producer ? sharedWriters() : sharedReaders();
+    reapDeadEndpoints(side);
+    if (!claimSlot(side, shared ? int(MaximumEndpoints) : 1)) {
+        if (shared) {
+            return fail(producer
+                    ? QSharedMemoryChannel::tr("%1: the channel has too many writers").arg(memory.key())
+                    : QSharedMemoryChannel::tr("%1: the channel has too many readers").arg(memory.key()));
+        }
+        return fail(producer
+                ? QSharedMemoryChannel::tr("%1: the channel already has a writer").arg(memory.key())
+                : QSharedMemoryChannel::tr("%1: the channel already has a reader").arg(memory.key()));
+    }
+
+    ring = reinterpret_cast<uchar *>(header + 1);
+    capacity = ringSize;
+    corrupted = false;
+    writePos = header->writePos.loadAcquire();
+    bytesWritten = header->bytesWritten.loadAcquire();
+    cachedReadPos = header->readPos.loadAcquire();
+    readPos = cachedReadPos;
+    bytesRead = header->bytesRead.loadAcquire();
+    recordRemaining = 0;
+
+    if (!producer && !shared) {
+        // the previous reader died in the middle of a record: skip the rest
+        const quint32 recordEnd = header->readRecordEnd.loadAcquire();
+        if (recordEnd != readPos && recordEnd - readPos <= writePos - readPos) {
+            readPos = recordEnd;
+            bytesRead = header->readRecordEndBytes.loadRelaxed();
+            publishRead();
+        }
+    }
+
+    // the channel is used for message I/O as well, so QIODevice must not
+    // read ahead into its own buffer
+    return q->QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+void QSharedMemoryChannelPrivate::detach()
+{
+    if (!header)
+        return;
+    Endpoints &side = producer ? header->writers : header->readers;
+    if (!producer && !sharedReaders() && !corrupted) {
+        // don't leave the next reader in the middle of a record
+        consume(recordRemaining);
+        publishRead();
+    }
+    side.pids[slot].storeRelease(0);
+    side.attached.fetchAndSubOrdered(1);
+    slot = -1;
+    notify(header->dataSequence, header->dataWaiters);
+    notify(header->spaceSequence, header->spaceWaiters);
+    header = nullptr;
+    ring = nullptr;
+    pendingMessage.clear();
+    messagePending = false;
+    memory.detach();
+}
+
+/*!
+    \class QSharedMemoryChannel
+    \inmodule QtCore
+    \since 6.0
+    \brief The QSharedMemoryChannel class transfers data between processes
+    through a ring buffer in shared memory.
+
+    \ingroup io
+
+    QSharedMemoryChannel is a one-way channel from writers to readers, which
+    may live in different processes or in different threads of the same
+    process. Data is copied once into a ring buffer in a QSharedMemory
+    segment and once out of it, and a single writer and a single reader
+    synchronize without locks, so a channel moves data at close to memory
+    bandwidth. Compared to QLocalSocket, there is no kernel involvement at
+    all while both sides keep up with each other.
+
+    One side creates the channel with create(), giving the capacity of the
+    ring buffer; the other side opens it with open() using the same key.
+    Whichever side opens the channel in QIODevice::WriteOnly mode is a
+    writer, the one in QIODevice::ReadOnly mode is a reader. By default,
+    there can be at most one of each at a time. If the channel is created
+    with the MultipleWriters or MultipleReaders option, up to 16 writers or
+    readers, respectively, can be attached; they take turns through a lock
+    in the shared segment. Each message then goes to exactly one of the
+    readers. For a bidirectional connection, use one channel per direction.
+
+    The channel can be used as a byte stream through the QIODevice API, or
+    with writeMessage() and readMessage(), which preserve message
+    boundaries. Every write() is also a message, so the two can be mixed:
+    readMessage() returns the rest of a message that read() has only
+    partially consumed. With several writers, messages are not interleaved,
+    but a large write() may be split into several messages.
+
+    write() and writeMessage() block while the ring buffer is full. Reading
+    never blocks; waitForReadyRead() sleeps until a writer has written
+    something. On Linux, sleeping and waking use futexes in the shared
+    segment; on other platforms the waiting side polls. The channel does not
+    emit readyRead() or bytesWritten(), as nothing in the event loop watches
+    the shared memory; it is meant to be used from threads that can block.
+
+    When all endpoints of one side have closed the channel, the other side
+    notices: writes fail once the readers are gone, and a reader gets the
+    end of the stream once it has read everything written before the
+    writers closed. The channel also notices, within a fraction of a second,
+    when the process of an endpoint exits without closing it, so that the
+    other side does not block forever and a new endpoint can take its place.
+    This relies on process IDs, so all processes using a channel must see
+    the same process IDs, and a process that has exited only counts as gone
+    once its parent has reaped it.
+
+    The reader validates what it finds in the shared segment. If a message
+    is inconsistent with what the writer published, reading fails with an
+    error, as the segment has been corrupted by a faulty or hostile process.
+
+    \sa QSharedMemory, QLocalSocket
+*/
+
+/*!
+    \enum QSharedMemoryChannel::ChannelOption
+
+    This enum describes how many endpoints can be attached to a channel.
+
+    \value NoChannelOptions At most one writer and one reader.
+    \value MultipleWriters Up to 16 writers, which write one message at a time.
+    \value MultipleReaders Up to 16 readers, each of which reads whole
+           messages. A message that read() has only partially consumed is
+           kept by that reader.
+*/
+
+/*!
+    Constructs a channel with the given \a parent. Call setKey() before
+    create() or open().
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(QObject *parent)
+    : QIODevice(*new QSharedMemoryChannelPrivate, parent)
+{
+}
+
+/*!
+    Constructs a channel for the shared memory segment identified by
+    \a key, with the given \a parent.
+
+    \sa setKey()
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(const QString &key, QObject *parent)
+    : QIODevice(*new QSharedMemoryChannelPrivate, parent)
+{
+    setKey(key);
+}
+
+/*!
+    Closes the channel and destroys the object.
+*/
+QSharedMemoryChannel::~QSharedMemoryChannel()
+{
+    close();
+}
+
+/*!
+    Sets the key of the shared memory segment used by the channel to
+    \a key. This closes the channel if it is open.
+
+    \sa QSharedMemory::setKey()
+*/
+void QSharedMemoryChannel::setKey(const QString &key)
+{
+    Q_D(QSharedMemoryChannel);
+    close();
+    d->memory.setKey(key);
+}
+
+/*!
+    Returns the key of the channel's shared memory segment.
+*/
+QString QSharedMemoryChannel::key() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->memory.key();
+}
+
+/*!
+    Creates the channel with a ring buffer of at least \a capacity bytes
+    and the given \a options, and opens it in \a mode, which must be either
+    QIODevice::ReadOnly or QIODevice::WriteOnly. The capacity is rounded up
+    to a power of two.
+
+    Returns \c true on success. Returns \c false and sets errorString() if
+    the shared memory segment cannot be created, for instance because it
+    already exists.
+
+    \sa open()
+*/
+bool QSharedMemoryChannel::create(qsizetype capacity, OpenMode mode, ChannelOptions options)
+{
+    Q_D(QSharedMemoryChannel);
+    if (isOpen()) {
+        qWarning("QSharedMemoryChannel::create: The channel is already open");
+        return false;
+    }
+    if ((mode & ReadWrite) != ReadOnly && (mode & ReadWrite) != WriteOnly) {
+        setErrorString(tr("A channel is opened either for reading or for writing"));
+        return false;
+    }
+    if (capacity <= 0 || capacity > qsizetype(MaximumCapacity)) {
+        setErrorString(tr("Invalid capacity %1").arg(capacity));
+        return false;
+    }
+
+    const quint32 ringSize = qMax(quint32(MinimumCapacity), qNextPowerOfTwo(quint32(capacity - 1)));
+    if (!d->memory.create(qsizetype(sizeof(ChannelHeader)) + ringSize)) {
+        setErrorString(d->memory.errorString());
+        return false;
+    }
+
+    auto header = static_cast<ChannelHeader *>(d->memory.data());
+    memset(static_cast<void *>(header), 0, sizeof(ChannelHeader));
+    header->version = ChannelVersion;
+    header->capacity = ringSize;
+    header->options = quint32(int(options));
+    header->magic.storeRelease(ChannelMagic);
+    return d->attach(mode);
+}
+
+/*!
+    Opens an existing channel in \a mode, which must be either
+    QIODevice::ReadOnly or QIODevice::WriteOnly.
+
+    Returns \c true on success. Returns \c false and sets errorString() if
+    there is no valid channel with this key, or if it already has as many
+    readers or writers, respectively, as its options() allow.
+
+    \sa create()
+*/
+bool QSharedMemoryChannel::open(OpenMode mode)
+{
+    Q_D(QSharedMemoryChannel);
+    if (isOpen()) {
+        qWarning("QSharedMemoryChannel::open: The channel is already open");
+        return false;
+    }
+    if ((mode & ReadWrite) != ReadOnly && (mode & ReadWrite) != WriteOnly) {
+        setErrorString(tr("A channel is opened either for reading or for writing"));
+        return false;
+    }
+    if (!d->memory.attach()) {
+        setErrorString(d->memory.errorString());
+        return false;
+    }
+    return d->attach(mode);
+}
+
+/*!
+    Closes the channel and detaches from the shared memory segment. The
+    segment is destroyed once no endpoint is attached to it anymore.
+
+    If this was the only reader, the rest of a partially read message is
+    discarded.
+*/
+void QSharedMemoryChannel::close()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!isOpen())
+        return;
+    QIODevice::close();
+    d->detach();
+}
+
+/*!
+    Returns the size of the channel's ring buffer in bytes, or 0 if the
+    channel is not open. A single message can be at most capacity() - 4
+    bytes long.
+*/
+qsizetype QSharedMemoryChannel::capacity() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header ? d->capacity : 0;
+}
+
+/*!
+    Returns the options the channel was created with, or NoChannelOptions
+    if the channel is not open.
+
+    \sa create()
+*/
+QSharedMemoryChannel::ChannelOptions QSharedMemoryChannel::options() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header ? d->options : NoChannelOptions;
+}
+
+/*!
+    \reimp
+
+    Always returns \c true.
+*/
+bool QSharedMemoryChannel::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+
+    For a reader, returns the number of bytes written to the channel and
+    not read yet.
+*/
+qint64 QSharedMemoryChannel::bytesAvailable() const
+{
+    Q_D(const QSharedMemoryChannel);
+    if (!d->header || d->producer)
+        return QIODevice::bytesAvailable();
+    qint64 available = quint32(d->header->bytesWritten.loadAcquire()
+                               - d->header->bytesRead.loadAcquire());
+    if (d->messagePending)
+        available += d->pendingMessage.size() - d->pendingOffset;
+    return available + QIODevice::bytesAvailable();
+}
+
+/*!
+    \reimp
+
+    For a writer, returns the number of bytes written to the channel that
+    no reader has read yet.
+*/
+qint64 QSharedMemoryChannel::bytesToWrite() const
+{
+    Q_D(const QSharedMemoryChannel);
+    if (!d->header || !d->producer)
+        return 0;
+    return quint32(d->header->bytesWritten.loadAcquire() - d->header->bytesRead.loadAcquire());
+}
+
+/*!
+    \reimp
+
+    Blocks until there is data to read, the writers have closed the
+    channel, or \a msecs milliseconds have passed. If \a msecs is -1, this
+    function does not time out.
+
+    Returns \c true if data is available for reading; otherwise returns
+    \c false.
+*/
+bool QSharedMemoryChannel::waitForReadyRead(int msecs)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || d->producer)
+        return false;
+    const auto readyOrClosed = [d] {
+        return d->dataAvailable() || d->peerClosed() || d->corrupted;
+    };
+    d->waitFor(d->header->dataSequence, d->header->dataWaiters, readyOrClosed,
+               QDeadlineTimer(msecs));
+    return d->dataAvailable();
+}
+
+/*!
+    \reimp
+
+    Blocks until a reader has read some of the data still in the channel,
+    or \a msecs milliseconds have passed. If \a msecs is -1, this function
+    does not time out.
+
+    Returns \c false if there was no unread data, the readers have closed
+    the channel, or the operation timed out; otherwise returns \c true.
+*/
+bool QSharedMemoryChannel::waitForBytesWritten(int msecs)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || !d->producer)
+        return false;
+    const quint32 start = d->header->readPos.loadAcquire();
+    if (start == d->header->writePos.loadAcquire())
+        return false;
+    const auto progressOrClosed = [d, start] {
+        return d->header->readPos.loadAcquire() != start || d->peerClosed();
+    };
+    d->waitFor(d->header->spaceSequence, d->header->spaceWaiters, progressOrClosed,
+               QDeadlineTimer(msecs));
+    return d->header->readPos.loadAcquire() != start;
+}
+
+/*!
+    Writes \a message to the channel as a single message, blocking while
+    there is not enough space in the ring buffer.
+
+    Returns \c true on success. Returns \c false if the channel is not open
+    for writing, the message is larger than capacity() - 4 bytes, or the
+    readers have closed the channel.
+
+    \sa readMessage()
+*/
+bool QSharedMemoryChannel::writeMessage(const QByteArray &message)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || !d->producer) {
+        qWarning("QSharedMemoryChannel::writeMessage: The channel is not open for writing");
+        return false;
+    }
+    if (message.size() > qsizetype(d->capacity - RecordHeaderSize)) {
+        setErrorString(tr("Message of %1 bytes does not fit into the channel").arg(message.size()));
+        return false;
+    }
+    return d->writeRecord(message.constData(), quint32(message.size()), QDeadlineTimer::Forever);
+}
+
+/*!
+    Returns the next message from the channel, or the rest of it if
+    read() has consumed part of it already. Returns a null QByteArray if
+    there is no message, or if the channel is corrupt; an empty message is
+    returned as an empty, but not null, QByteArray.
+
+    This function does not block; use waitForReadyRead() to wait for a
+    message.
+
+    \sa writeMessage(), hasPendingMessages()
+*/
+QByteArray QSharedMemoryChannel::readMessage()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || d->producer) {
+        qWarning("QSharedMemoryChannel::readMessage: The channel is not open for reading");
+        return QByteArray();
+    }
+
+    if (d->sharedReaders()) {
+        if (!d->messagePending && !d->takeRecord())
+            return QByteArray();
+        QByteArray message = std::move(d->pendingMessage);
+        if (d->pendingOffset)
+            message.remove(0, d->pendingOffset);
+        d->pendingMessage = QByteArray();
+        d->messagePending = false;
+        return message;
+    }
+
+    if (d->recordRemaining == 0 && !d->nextRecord())
+        return QByteArray();
+    QByteArray message(d->recordRemaining, Qt::Uninitialized);
+    d->copyOut(d->readPos, message.data(), d->recordRemaining);
+    d->consume(d->recordRemaining);
+    d->publishRead();
+    return message;
+}
+
+/*!
+    Returns \c true if the channel is open for reading and there is a
+    message, or the rest of one, to read.
+
+    \sa readMessage()
+*/
+bool QSharedMemoryChannel::hasPendingMessages() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header && !d->producer && d->dataAvailable();
+}
+
+/*!
+    \reimp
+*/
+qint64 QSharedMemoryChannel::readData(char *data, qint64 maxlen)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || d->corrupted)
+        return -1;
+
+    // check for the end of the stream first: everything the writers wrote
+    // before closing is published by then
+    const bool closed = d->peerClosed();
+    qint64 total = 0;
+    if (d->sharedReaders()) {
+        while (total < maxlen && (d->messagePending || d->takeRecord())) {
+            const qint64 chunk = qMin(d->pendingMessage.size() - d->pendingOffset, maxlen - total);
+            memcpy(data + total, d->pendingMessage.constData() + d->pendingOffset, chunk);
+            d->pendingOffset += chunk;
+            total += chunk;
+            if (d->pendingOffset == d->pendingMessage.size()) {
+                d->pendingMessage = QByteArray();
+                d->messagePending = false;
+            }
+        }
+    } else {
+        bool consumed = false;
+        while (total < maxlen) {
+            if (d->recordRemaining == 0) {
+                if (!d->nextRecord())
+                    break;
+                consumed = true;
+                continue;
+            }
+            const quint32 chunk = quint32(qMin(qint64(d->recordRemaining), maxlen - total));
+            d->copyOut(d->readPos, data + total, chunk);
+            d->consume(chunk);
+            total += chunk;
+        }
+        if (total || consumed)
+            d->publishRead();
+    }
+    if (total == 0 && (closed || d->corrupted))
+        return -1;
+    return total;
+}
+
+/*!
+    \reimp
+
+    Blocks while the ring buffer is full. Writes larger than a quarter of
+    the capacity are split, so that a reader can start on the first part
+    while the rest is being written.
+*/
+qint64 QSharedMemoryChannel::writeData(const char *data, qint64 len)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header)
+        return -1;
+    const qint64 maxChunk = d->capacity / 4;
+    qint64 written = 0;
+    while (written < len) {
+        const quint32 chunk = quint32(qMin(maxChunk, len - written));
+        if (!d->writeRecord(data + written, chunk, QDeadlineTimer::Forever))
+            return written ? written : -1;
+        written += chunk;
+    }
+    return written;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qsharedmemorychannel.cpp"
+
+#endif // QT_NO_SHAREDMEMORY
@@ -154,7 +154,28 @@ void QMimeDatabasePrivate::loadProviders()
         };
         const auto it = std::find_if(currentProviders.begin(), currentProviders.end(), isInternal);
         if (it == currentProviders.end()) {
-            m_providers.push_back(Providers::value_type(new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase)));
+            std::unique_ptr<QMimeProviderBase> provider;
+#if defined(QT_USE_MMAP)
+            // Parsing the XML takes a while, so reuse what an earlier process compiled from it.
+            // This writes to the user's cache directory, so only do it when asked to.
+            const QString cacheDir = qEnvironmentVariableIntValue("QT_BUILTIN_MIME_CACHE") > 0
+                    && qEnvironmentVariableIsEmpty("QT_NO_MIME_CACHE")
+                    ? QMimeXMLProvider::internalDatabaseCacheDirectory() : QString();
+            if (!cacheDir.isEmpty()) {
+                provider.reset(new QMimeBinaryProvider(this, cacheDir, QMimeBinaryProvider::InternalDatabase));
+                if (!provider->isValid())
+                    provider.reset();
+            }
+#endif
+            if (!provider) {
+                auto xmlProvider = new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase);
+                provider.reset(xmlProvider);
+#if defined(QT_USE_MMAP)
+                if (!cacheDir.isEmpty())
+                    xmlProvider->writeCache(cacheDir);
+#endif
+            }
+            m_providers.push_back(std::move(provider));
         } else {
             m_providers.push_back(std::move(*it));
         }
@@ -228,7 +249,12 @@ void QMimeDatabasePrivate::loadMimeTypePrivate(QMimeTypePrivate &mimePrivate)
         return; // invalid mimetype
     if (!mimePrivate.loaded) { // XML provider sets loaded=true, binary provider does this on demand
         Q_ASSERT(mimePrivate.fromCache);
-        QMimeBinaryProvider::loadMimeTypePrivate(mimePrivate);
+        for (const auto &provider : providers()) {
+            if (provider->mimeTypeForName(mimePrivate.name).isValid()) {
+                provider->loadMimeTypePrivate(mimePrivate);
+                break;
+            }
+        }
     }
 }
 
@@ -474,6 +500,11 @@ bool QMimeDatabasePrivate::inherits(const QString &mime, const QString &parent)
     in the above example. Make sure to run this command when installing the MIME type
     definition file.
 
+    When Qt uses its own copy of the database on a Unix system and the environment
+    variable \c QT_BUILTIN_MIME_CACHE is set to \c 1, Qt compiles that copy into such
+    a cache the first time, and stores it below QStandardPaths::GenericCacheLocation.
+    Setting the environment variable \c QT_NO_MIME_CACHE disables both caches.
+
     \threadsafe
 
     \snippet code/src_corelib_mimetype_qmimedatabase.cpp 0
@@ -337,6 +337,48 @@ QByteArray QMimeMagicRule::mask() const
     return result;
 }
 
+template <typename T>
+static QByteArray numberToBytes(quint32 number)
+{
+    const T value(number);
+    return QByteArray(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+static QByteArray numberToBytes(QMimeMagicRule::Type type, quint32 number)
+{
+    switch (type) {
+    case QMimeMagicRule::Byte:
+        return numberToBytes<quint8>(number);
+    case QMimeMagicRule::Host16:
+    case QMimeMagicRule::Big16:
+    case QMimeMagicRule::Little16:
+        return numberToBytes<quint16>(number);
+    case QMimeMagicRule::Host32:
+    case QMimeMagicRule::Big32:
+    case QMimeMagicRule::Little32:
+        return numberToBytes<quint32>(number);
+    default:
+        break;
+    }
+    return QByteArray();
+}
+
+// Numbers were converted to host byte order in the constructor, so their
+// in-memory representation is what matchNumber() compares against.
+QByteArray QMimeMagicRule::matchValue() const
+{
+    if (m_type == String)
+        return m_pattern;
+    return numberToBytes(m_type, m_number);
+}
+
+QByteArray QMimeMagicRule::matchMask() const
+{
+    if (m_type == String)
+        return m_mask;
+    return numberToBytes(m_type, m_numberMask);
+}
+
 bool QMimeMagicRule::matches(const QByteArray &data) const
 {
     const bool ok = m_matchFunction && (this->*m_matchFunction)(data);
@@ -90,6 +90,10 @@ public:
     int endPos() const { return m_endPos; }
     QByteArray mask() const;
 
+    // The value and mask in the form matchSubstring() compares them
+    QByteArray matchValue() const;
+    QByteArray matchMask() const;
+
     bool isValid() const { return m_matchFunction != nullptr; }
 
     bool matches(const QByteArray &data) const;
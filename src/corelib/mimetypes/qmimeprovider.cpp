@@ -49,11 +49,14 @@
 #include <QBuffer>
 #include <QDir>
 #include <QFile>
+#include <QSaveFile>
 #include <QByteArrayMatcher>
 #include <QDebug>
 #include <QDateTime>
 #include <QtEndian>
 
+#include <algorithm>
+
 #if QT_CONFIG(mimetype_database)
 #  if defined(Q_CC_MSVC)
 #    pragma section(".qtmimedatabase", read, shared)
@@ -96,6 +99,12 @@ QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString
     ensureLoaded();
 }
 
+QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString &directory, InternalDatabaseEnum)
+    : QMimeProviderBase(db, directory), m_mimetypeListLoaded(false), m_internalDatabase(true)
+{
+    ensureLoaded();
+}
+
 struct QMimeBinaryProvider::CacheFile
 {
     CacheFile(const QString &fileName);
@@ -169,7 +178,7 @@ bool QMimeBinaryProvider::isValid()
 
 bool QMimeBinaryProvider::isInternalDatabase() const
 {
-    return false;
+    return m_internalDatabase;
 }
 
 // Position of the "list offsets" values, at the beginning of the mime.cache file
@@ -310,8 +319,11 @@ bool QMimeBinaryProvider::matchSuffixTree(QMimeGlobMatchResult &result, QMimeBin
                     const int weight = flagsAndWeight & 0xff;
                     const bool caseSensitive = flagsAndWeight & 0x100;
                     if (caseSensitiveCheck || !caseSensitive) {
+                        // Only "*.foo" patterns give a known suffix, like in QMimeGlobPatternList::match()
+                        const bool isSimplePattern = fileName.at(charPos + 1) == QLatin1Char('.');
                         result.addMatch(QLatin1String(mimeType), weight,
-                                        QLatin1Char('*') + QStringView{fileName}.mid(charPos + 1), fileName.size() - charPos - 2);
+                                        QLatin1Char('*') + QStringView{fileName}.mid(charPos + 1),
+                                        isSimplePattern ? fileName.size() - charPos - 2 : 0);
                         success = true;
                     }
                 }
@@ -359,12 +371,17 @@ void QMimeBinaryProvider::findByMagic(const QByteArray &data, int *accuracyPtr,
 
     for (int i = 0; i < numMatches; ++i) {
         const int off = firstMatchOffset + i * 16;
+        const int priority = m_cacheFile->getUint32(off);
+        // The list is sorted by priority, so nothing after this can beat
+        // what an earlier provider already found
+        if (priority <= *accuracyPtr)
+            return;
         const int numMatchlets = m_cacheFile->getUint32(off + 8);
         const int firstMatchletOffset = m_cacheFile->getUint32(off + 12);
         if (matchMagicRule(m_cacheFile, numMatchlets, firstMatchletOffset, data)) {
             const int mimeTypeOffset = m_cacheFile->getUint32(off + 4);
             const char *mimeType = m_cacheFile->getCharStar(mimeTypeOffset);
-            *accuracyPtr = m_cacheFile->getUint32(off);
+            *accuracyPtr = priority;
             // Return the first match. We have no rules for conflicting magic data...
             // (mime.cache itself is sorted, but what about local overrides with a lower prio?)
             candidate = mimeTypeForNameUnchecked(QLatin1String(mimeType));
@@ -495,6 +512,12 @@ void QMimeBinaryProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
 #else
     if (data.loaded)
         return;
+    if (m_internalDatabase) {
+        if (!m_internalXmlProvider)
+            m_internalXmlProvider.reset(new QMimeXMLProvider(m_db, QMimeXMLProvider::InternalDatabase));
+        m_internalXmlProvider->loadMimeTypePrivate(data);
+        return;
+    }
     data.loaded = true;
     // load comment and globPatterns
 
@@ -862,4 +885,332 @@ void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
     m_magicMatchers.append(matcher);
 }
 
+void QMimeXMLProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
+{
+    // Called for types listed by a binary provider, e.g. the cache of the internal database
+    data.loaded = true;
+    const QMimeType mime = m_nameMimeTypeMap.value(data.name);
+    if (mime.isValid()) {
+        data.localeComments = mime.d->localeComments;
+        data.globPatterns = mime.d->globPatterns;
+    }
+}
+
+QString QMimeXMLProvider::internalDatabaseCacheDirectory()
+{
+#if QT_CONFIG(mimetype_database)
+    const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheLocation.isEmpty())
+        return QString();
+    // One directory per version of the database, of the cache format written by writeCache()
+    // and byte order, so that different Qt builds and hosts can share the location. Bump the
+    // format version whenever writeCache() changes what it writes.
+    enum { CacheFormatVersion = 1 };
+    const size_t key = qHashBits(mimetype_database, sizeof(mimetype_database));
+    return cacheLocation + QLatin1String("/qtmimedatabase/")
+            + QString::number(CacheFormatVersion)
+            + (QSysInfo::ByteOrder == QSysInfo::BigEndian ? QLatin1String("-be-") : QLatin1String("-le-"))
+            + QString::number(key, 16);
+#else
+    return QString();
+#endif
+}
+
+namespace {
+// Assembles a file in the mime.cache format of shared-mime-info, as read by QMimeBinaryProvider.
+// Tables are reserved first and filled in afterwards, so that the strings and nested tables
+// they refer to can simply be appended.
+class QMimeCacheWriter
+{
+public:
+    quint32 size() const { return quint32(m_data.size()); }
+
+    quint32 reserve(int bytes)
+    {
+        const quint32 offset = size();
+        m_data.append(bytes, '\0');
+        return offset;
+    }
+
+    void setUint32(quint32 offset, quint32 value)
+    {
+        qToBigEndian(value, m_data.data() + offset);
+    }
+
+    quint32 addBytes(const QByteArray &bytes)
+    {
+        const quint32 offset = size();
+        m_data += bytes;
+        // keep the tables aligned
+        m_data.append((4 - m_data.size() % 4) % 4, '\0');
+        return offset;
+    }
+
+    quint32 addString(const QString &str)
+    {
+        const QByteArray latin1 = str.toLatin1();
+        quint32 &offset = m_strings[latin1];
+        if (!offset)
+            offset = addBytes(QByteArray(latin1.constData(), latin1.size() + 1));
+        return offset;
+    }
+
+    QByteArray m_data;
+
+private:
+    QHash<QByteArray, quint32> m_strings;
+};
+
+struct QMimeCacheGlob
+{
+    QString pattern;
+    QString mimeType;
+    quint32 flagsAndWeight;
+};
+
+// Writes the children of the suffix tree node for the first 'depth' characters shared by
+// [begin, end), and returns their number and offset
+static QPair<quint32, quint32> writeSuffixTreeChildren(QMimeCacheWriter &writer,
+                                                       const QList<QMimeCacheGlob>::const_iterator begin,
+                                                       const QList<QMimeCacheGlob>::const_iterator end,
+                                                       int depth)
+{
+    // The suffixes ending here sort first, which is also where the mime type entries must go
+    auto it = begin;
+    while (it != end && it->pattern.size() == depth)
+        ++it;
+    quint32 count = quint32(it - begin);
+    for (auto next = it; next != end; ++count) {
+        const QChar ch = next->pattern.at(depth);
+        next = std::find_if(next, end, [&](const QMimeCacheGlob &glob) { return glob.pattern.at(depth) != ch; });
+    }
+
+    const quint32 offset = writer.reserve(12 * count);
+    quint32 off = offset;
+    for (auto leaf = begin; leaf != it; ++leaf, off += 12) {
+        writer.setUint32(off + 4, writer.addString(leaf->mimeType));
+        writer.setUint32(off + 8, leaf->flagsAndWeight);
+    }
+    while (it != end) {
+        const QChar ch = it->pattern.at(depth);
+        const auto groupEnd = std::find_if(it, end, [&](const QMimeCacheGlob &glob) { return glob.pattern.at(depth) != ch; });
+        const auto children = writeSuffixTreeChildren(writer, it, groupEnd, depth + 1);
+        writer.setUint32(off, ch.unicode());
+        writer.setUint32(off + 4, children.first);
+        writer.setUint32(off + 8, children.second);
+        off += 12;
+        it = groupEnd;
+    }
+    return qMakePair(count, offset);
+}
+
+static quint32 writeGlobList(QMimeCacheWriter &writer, const QList<QMimeCacheGlob> &globs)
+{
+    const quint32 offset = writer.reserve(4 + 12 * globs.size());
+    writer.setUint32(offset, globs.size());
+    quint32 off = offset + 4;
+    for (const QMimeCacheGlob &glob : globs) {
+        writer.setUint32(off, writer.addString(glob.pattern));
+        writer.setUint32(off + 4, writer.addString(glob.mimeType));
+        writer.setUint32(off + 8, glob.flagsAndWeight);
+        off += 12;
+    }
+    return offset;
+}
+
+// Writes a sorted list of (key, value) string pairs, as used for aliases and icons
+static quint32 writeStringMap(QMimeCacheWriter &writer, const QMap<QByteArray, QString> &map)
+{
+    const quint32 offset = writer.reserve(4 + 8 * map.size());
+    writer.setUint32(offset, map.size());
+    quint32 off = offset + 4;
+    for (auto it = map.cbegin(), end = map.cend(); it != end; ++it, off += 8) {
+        writer.setUint32(off, writer.addString(QString::fromLatin1(it.key())));
+        writer.setUint32(off + 4, writer.addString(it.value()));
+    }
+    return offset;
+}
+
+static bool isCacheableMagicRule(const QMimeMagicRule &rule)
+{
+    // Rules that can never match would also fail their whole subtree
+    return rule.isValid() && rule.matchValue().size() == rule.matchMask().size();
+}
+
+static quint32 writeMagicRules(QMimeCacheWriter &writer, const QList<QMimeMagicRule> &allRules,
+                               quint32 *count, int *maxExtent)
+{
+    QList<QMimeMagicRule> rules;
+    for (const QMimeMagicRule &rule : allRules) {
+        if (isCacheableMagicRule(rule))
+            rules.append(rule);
+    }
+    *count = rules.size();
+    const quint32 offset = writer.reserve(32 * rules.size());
+    quint32 off = offset;
+    for (const QMimeMagicRule &rule : qAsConst(rules)) {
+        const QByteArray value = rule.matchValue();
+        const QByteArray mask = rule.matchMask();
+        const bool hasMask = std::any_of(mask.cbegin(), mask.cend(), [](char c) { return c != char(-1); });
+        *maxExtent = qMax(*maxExtent, rule.endPos() + int(value.size()));
+        writer.setUint32(off, rule.startPos());
+        writer.setUint32(off + 4, rule.endPos() - rule.startPos() + 1);
+        writer.setUint32(off + 8, 1); // word size: the value is already in host byte order
+        writer.setUint32(off + 12, value.size());
+        writer.setUint32(off + 16, writer.addBytes(value));
+        writer.setUint32(off + 20, hasMask ? writer.addBytes(mask) : 0);
+        quint32 numChildren = 0;
+        const quint32 children = writeMagicRules(writer, rule.m_subMatches, &numChildren, maxExtent);
+        writer.setUint32(off + 24, numChildren);
+        writer.setUint32(off + 28, children);
+        off += 32;
+    }
+    return offset;
+}
+} // unnamed namespace
+
+/*
+   Compiles the loaded data into the files 'mime.cache' and 'types' in \a directory,
+   so that a QMimeBinaryProvider can use it without parsing the XML again.
+   The matching results are the same as with this provider, but the data is not
+   portable to hosts of a different byte order.
+ */
+bool QMimeXMLProvider::writeCache(const QString &directory) const
+{
+#if QT_CONFIG(temporaryfile)
+    if (!QDir().mkpath(directory))
+        return false;
+
+    enum { HeaderSize = 40 };
+    QMimeCacheWriter writer;
+    writer.reserve(HeaderSize);
+    writer.setUint32(0, 0x00010002); // version 1.2
+
+    // Put the type names first, they are used by almost every table
+    QStringList names = m_nameMimeTypeMap.keys();
+    names.sort();
+    for (const QString &name : qAsConst(names))
+        writer.addString(name);
+
+    QMap<QByteArray, QString> aliases;
+    for (auto it = m_aliases.cbegin(), end = m_aliases.cend(); it != end; ++it)
+        aliases.insert(it.key().toLatin1(), it.value());
+    writer.setUint32(PosAliasListOffset, writeStringMap(writer, aliases));
+
+    QMap<QByteArray, QStringList> parents;
+    for (auto it = m_parents.cbegin(), end = m_parents.cend(); it != end; ++it)
+        parents.insert(it.key().toLatin1(), it.value());
+    const quint32 parentListOffset = writer.reserve(4 + 8 * parents.size());
+    writer.setUint32(PosParentListOffset, parentListOffset);
+    writer.setUint32(parentListOffset, parents.size());
+    quint32 off = parentListOffset + 4;
+    for (auto it = parents.cbegin(), end = parents.cend(); it != end; ++it, off += 8) {
+        writer.setUint32(off, writer.addString(QString::fromLatin1(it.key())));
+        const quint32 listOffset = writer.reserve(4 + 4 * it.value().size());
+        writer.setUint32(listOffset, it.value().size());
+        for (int i = 0; i < it.value().size(); ++i)
+            writer.setUint32(listOffset + 4 + 4 * i, writer.addString(it.value().at(i)));
+        writer.setUint32(off + 4, listOffset);
+    }
+
+    // Sort the globs the way QMimeBinaryProvider looks for them: literal file names,
+    // suffixes like "*.txt" (in a tree keyed by the reversed suffix), and everything else
+    QList<QMimeCacheGlob> literals;
+    QList<QMimeCacheGlob> suffixes;
+    QList<QMimeCacheGlob> globs;
+    const auto addGlob = [&](const QMimeGlobPattern &glob) {
+        const QString &pattern = glob.pattern();
+        const quint32 flagsAndWeight = glob.weight() | (glob.isCaseSensitive() ? 0x100 : 0);
+        const auto isSpecial = [](QChar c) {
+            return c == QLatin1Char('*') || c == QLatin1Char('?') || c == QLatin1Char('[');
+        };
+        const QStringView rest = QStringView{pattern}.mid(1);
+        if (std::none_of(pattern.cbegin(), pattern.cend(), isSpecial)) {
+            literals.append({ pattern, glob.mimeType(), flagsAndWeight });
+        } else if (pattern.startsWith(QLatin1Char('*')) && !rest.isEmpty()
+                   && std::none_of(rest.cbegin(), rest.cend(), isSpecial)) {
+            QString reversed(rest.size(), Qt::Uninitialized);
+            std::reverse_copy(rest.cbegin(), rest.cend(), reversed.begin());
+            suffixes.append({ reversed, glob.mimeType(), flagsAndWeight });
+        } else {
+            globs.append({ pattern, glob.mimeType(), flagsAndWeight });
+        }
+    };
+    for (const QMimeGlobPattern &glob : m_mimeTypeGlobs.m_highWeightGlobs)
+        addGlob(glob);
+    for (auto it = m_mimeTypeGlobs.m_fastPatterns.cbegin(), end = m_mimeTypeGlobs.m_fastPatterns.cend(); it != end; ++it) {
+        const QString pattern = QLatin1String("*.") + it.key();
+        for (const QString &mimeType : it.value())
+            addGlob(QMimeGlobPattern(pattern, mimeType));
+    }
+    for (const QMimeGlobPattern &glob : m_mimeTypeGlobs.m_lowWeightGlobs)
+        addGlob(glob);
+
+    writer.setUint32(PosLiteralListOffset, writeGlobList(writer, literals));
+    writer.setUint32(PosGlobListOffset, writeGlobList(writer, globs));
+
+    std::stable_sort(suffixes.begin(), suffixes.end(), [](const QMimeCacheGlob &lhs, const QMimeCacheGlob &rhs) {
+        return lhs.pattern < rhs.pattern;
+    });
+    const quint32 suffixTreeOffset = writer.reserve(8);
+    writer.setUint32(PosReverseSuffixTreeOffset, suffixTreeOffset);
+    const auto roots = writeSuffixTreeChildren(writer, suffixes.cbegin(), suffixes.cend(), 0);
+    writer.setUint32(suffixTreeOffset, roots.first);
+    writer.setUint32(suffixTreeOffset + 4, roots.second);
+
+    // QMimeBinaryProvider returns the first match, so order by priority like findByMagic() does
+    QList<QMimeMagicRuleMatcher> matchers = m_magicMatchers;
+    std::stable_sort(matchers.begin(), matchers.end(), [](const QMimeMagicRuleMatcher &lhs, const QMimeMagicRuleMatcher &rhs) {
+        return lhs.priority() > rhs.priority();
+    });
+    const quint32 magicListOffset = writer.reserve(12 + 16 * matchers.size());
+    writer.setUint32(PosMagicListOffset, magicListOffset);
+    writer.setUint32(magicListOffset, matchers.size());
+    writer.setUint32(magicListOffset + 8, magicListOffset + 12);
+    int maxExtent = 0;
+    off = magicListOffset + 12;
+    for (const QMimeMagicRuleMatcher &matcher : qAsConst(matchers)) {
+        quint32 numMatchlets = 0;
+        const quint32 matchlets = writeMagicRules(writer, matcher.magicRules(), &numMatchlets, &maxExtent);
+        writer.setUint32(off, matcher.priority());
+        writer.setUint32(off + 4, writer.addString(matcher.mimetype()));
+        writer.setUint32(off + 8, numMatchlets);
+        writer.setUint32(off + 12, matchlets);
+        off += 16;
+    }
+    writer.setUint32(magicListOffset + 4, maxExtent);
+
+    const quint32 namespaceListOffset = writer.reserve(4); // empty
+    writer.setUint32(28, namespaceListOffset);
+
+    QMap<QByteArray, QString> icons;
+    QMap<QByteArray, QString> genericIcons;
+    for (const QMimeType &mime : m_nameMimeTypeMap) {
+        if (!mime.d->iconName.isEmpty())
+            icons.insert(mime.d->name.toLatin1(), mime.d->iconName);
+        if (!mime.d->genericIconName.isEmpty())
+            genericIcons.insert(mime.d->name.toLatin1(), mime.d->genericIconName);
+    }
+    writer.setUint32(PosIconsListOffset, writeStringMap(writer, icons));
+    writer.setUint32(PosGenericIconsListOffset, writeStringMap(writer, genericIcons));
+
+    // QMimeBinaryProvider only uses the directory once mime.cache exists, so write that last
+    QSaveFile typesFile(directory + QLatin1String("/types"));
+    if (!typesFile.open(QIODevice::WriteOnly))
+        return false;
+    for (const QString &name : qAsConst(names))
+        typesFile.write(name.toLatin1() + '\n');
+    if (!typesFile.commit())
+        return false;
+    QSaveFile cacheFile(directory + QLatin1String("/mime.cache"));
+    if (!cacheFile.open(QIODevice::WriteOnly))
+        return false;
+    cacheFile.write(writer.m_data);
+    return cacheFile.commit();
+#else
+    Q_UNUSED(directory);
+    return false;
+#endif
+}
+
 QT_END_NAMESPACE
@@ -63,8 +63,9 @@ QT_REQUIRE_CONFIG(mimetype);
 QT_BEGIN_NAMESPACE
 
 class QMimeMagicRuleMatcher;
+class QMimeXMLProvider;
 
-class QMimeProviderBase
+class Q_AUTOTEST_EXPORT QMimeProviderBase
 {
 public:
     QMimeProviderBase(QMimeDatabasePrivate *db, const QString &directory);
@@ -79,6 +80,7 @@ public:
     virtual void addAliases(const QString &name, QStringList &result) = 0;
     virtual void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) = 0;
     virtual void addAllMimeTypes(QList<QMimeType> &result) = 0;
+    virtual void loadMimeTypePrivate(QMimeTypePrivate &) {}
     virtual void loadIcon(QMimeTypePrivate &) {}
     virtual void loadGenericIcon(QMimeTypePrivate &) {}
     virtual void ensureLoaded() {}
@@ -92,10 +94,13 @@ public:
 /*
    Parses the files 'mime.cache' and 'types' on demand
  */
-class QMimeBinaryProvider : public QMimeProviderBase
+class Q_AUTOTEST_EXPORT QMimeBinaryProvider : public QMimeProviderBase
 {
 public:
+    enum InternalDatabaseEnum { InternalDatabase };
     QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString &directory);
+    // Reads the cache written by QMimeXMLProvider::writeCache() for the internal database
+    QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString &directory, InternalDatabaseEnum);
     virtual ~QMimeBinaryProvider();
 
     bool isValid() override;
@@ -107,7 +112,7 @@ public:
     void addAliases(const QString &name, QStringList &result) override;
     void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) override;
     void addAllMimeTypes(QList<QMimeType> &result) override;
-    static void loadMimeTypePrivate(QMimeTypePrivate &);
+    void loadMimeTypePrivate(QMimeTypePrivate &) override;
     void loadIcon(QMimeTypePrivate &) override;
     void loadGenericIcon(QMimeTypePrivate &) override;
     void ensureLoaded() override;
@@ -126,12 +131,15 @@ private:
     QStringList m_cacheFileNames;
     QSet<QString> m_mimetypeNames;
     bool m_mimetypeListLoaded;
+    bool m_internalDatabase = false;
+    // Comments and glob lists are not part of mime.cache
+    std::unique_ptr<QMimeXMLProvider> m_internalXmlProvider;
 };
 
 /*
    Parses the raw XML files (slower)
  */
-class QMimeXMLProvider : public QMimeProviderBase
+class Q_AUTOTEST_EXPORT QMimeXMLProvider : public QMimeProviderBase
 {
 public:
     enum InternalDatabaseEnum { InternalDatabase };
@@ -153,10 +161,14 @@ public:
     void addAliases(const QString &name, QStringList &result) override;
     void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) override;
     void addAllMimeTypes(QList<QMimeType> &result) override;
+    void loadMimeTypePrivate(QMimeTypePrivate &) override;
     void ensureLoaded() override;
 
     bool load(const QString &fileName, QString *errorMessage);
 
+    static QString internalDatabaseCacheDirectory();
+    bool writeCache(const QString &directory) const;
+
     // Called by the mimetype xml parser
     void addMimeType(const QMimeType &mt);
     void addGlobPattern(const QMimeGlobPattern &glob);
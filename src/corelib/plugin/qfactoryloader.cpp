@@ -58,6 +58,9 @@
 #include "qjsonobject.h"
 #include "qjsonarray.h"
 #include "private/qduplicatetracker_p.h"
+#if QT_CONFIG(library)
+#include "qpluginmetadatacache_p.h"
+#endif
 
 #include <qtcore_tracepoints_p.h>
 
@@ -197,6 +200,7 @@ void QFactoryLoader::update()
 #endif
                     QDir::Files);
         QLibraryPrivate *library = nullptr;
+        QPluginMetaDataCache cache(path);
 
         for (int j = 0; j < plugins.count(); ++j) {
             QString fileName = QDir::cleanPath(path + QLatin1Char('/') + plugins.at(j));
@@ -227,7 +231,7 @@ void QFactoryLoader::update()
             Q_TRACE(QFactoryLoader_update, fileName);
 
             library = QLibraryPrivate::findOrCreate(QFileInfo(fileName).canonicalFilePath());
-            if (!library->isPlugin()) {
+            if (!library->isPlugin(&cache)) {
                 if (qt_debug_component()) {
                     qDebug() << library->errorString << Qt::endl
                              << "         not a plugin";
@@ -283,6 +287,7 @@ void QFactoryLoader::update()
                 library->release();
             }
         }
+        cache.save();
     }
 #else
     Q_D(QFactoryLoader);
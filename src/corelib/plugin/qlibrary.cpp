@@ -42,6 +42,7 @@
 
 #include "qfactoryloader_p.h"
 #include "qlibrary_p.h"
+#include "qpluginmetadatacache_p.h"
 #include <qstringlist.h>
 #include <qfile.h>
 #include <qfileinfo.h>
@@ -731,15 +732,15 @@ static bool qt_get_metadata(QLibraryPrivate *priv, QString *errMsg)
     return true;
 }
 
-bool QLibraryPrivate::isPlugin()
+bool QLibraryPrivate::isPlugin(QPluginMetaDataCache *cache)
 {
     if (pluginState == MightBeAPlugin)
-        updatePluginState();
+        updatePluginState(cache);
 
     return pluginState == IsAPlugin;
 }
 
-void QLibraryPrivate::updatePluginState()
+void QLibraryPrivate::updatePluginState(QPluginMetaDataCache *cache)
 {
     QMutexLocker locker(&mutex);
     errorString.clear();
@@ -763,8 +764,19 @@ void QLibraryPrivate::updatePluginState()
 #endif
 
     if (!pHnd.loadRelaxed()) {
-        // scan for the plugin metadata without loading
-        success = findPatternUnloaded(fileName, this);
+        // scan for the plugin metadata without loading, unless the
+        // result of an earlier scan of the same file is cached
+        if (const QPluginMetaDataCache::Entry *entry = cache ? cache->find(fileName) : nullptr) {
+            if (qt_debug_component())
+                qDebug() << "Using cached plugin metadata for" << fileName;
+            success = entry->isPlugin;
+            metaData = entry->metaData;
+            errorString = entry->errorString;
+        } else {
+            success = findPatternUnloaded(fileName, this);
+            if (cache)
+                cache->insert(fileName, { success, success ? metaData : QJsonObject(), errorString });
+        }
     } else {
         // library is already loaded (probably via QLibrary)
         // simply get the target function and call it.
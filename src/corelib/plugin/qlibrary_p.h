@@ -69,6 +69,7 @@ QT_BEGIN_NAMESPACE
 bool qt_debug_component();
 
 class QLibraryStore;
+class QPluginMetaDataCache;
 class QLibraryPrivate
 {
 public:
@@ -108,8 +109,8 @@ public:
     QString errorString;
     QString qualifiedFileName;
 
-    void updatePluginState();
-    bool isPlugin();
+    void updatePluginState(QPluginMetaDataCache *cache = nullptr);
+    bool isPlugin(QPluginMetaDataCache *cache = nullptr);
 
 private:
     explicit QLibraryPrivate(const QString &canonicalFileName, const QString &version, QLibrary::LoadHints loadHints);
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qpluginmetadatacache_p.h"
+
+#include "qplatformdefs.h"
+#include <qcborarray.h>
+#include <qcbormap.h>
+#include <qcborvalue.h>
+#include <qcryptographichash.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+#include <qsysinfo.h>
+
+QT_BEGIN_NAMESPACE
+
+static QCborMap cacheHeader(const QString &directory)
+{
+    QCborMap header;
+    header[QLatin1String("qtVersion")] = QLatin1String(QT_VERSION_STR);
+    header[QLatin1String("buildAbi")] = QSysInfo::buildAbi();
+    header[QLatin1String("directory")] = directory;
+    return header;
+}
+
+QPluginMetaDataCache::QPluginMetaDataCache(const QString &directory)
+    : directory(directory), enabled(isEnabled())
+{
+    if (!enabled)
+        return;
+
+    QFile file(cacheFilePath(directory));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QCborMap cache = QCborValue::fromCbor(file.readAll()).toMap();
+    if (cache.value(QLatin1String("header")).toMap() != cacheHeader(directory))
+        return;
+
+    const QCborArray plugins = cache.value(QLatin1String("plugins")).toArray();
+    for (const QCborValue &value : plugins) {
+        const QCborMap plugin = value.toMap();
+        Record record;
+        record.key.size = plugin.value(QLatin1String("size")).toInteger(-1);
+        record.key.modificationTime = plugin.value(QLatin1String("mtime")).toInteger();
+        record.key.inode = quint64(plugin.value(QLatin1String("inode")).toInteger());
+        record.entry.isPlugin = plugin.value(QLatin1String("isPlugin")).toBool();
+        record.entry.metaData = plugin.value(QLatin1String("metaData")).toMap().toJsonObject();
+        record.entry.errorString = plugin.value(QLatin1String("error")).toString();
+        record.valid = true;
+        records.insert(plugin.value(QLatin1String("file")).toString(), record);
+    }
+}
+
+/*
+    The cache is used unless the QT_NO_PLUGIN_CACHE environment variable is set.
+*/
+bool QPluginMetaDataCache::isEnabled()
+{
+    return !qEnvironmentVariableIsSet("QT_NO_PLUGIN_CACHE");
+}
+
+QString QPluginMetaDataCache::cacheFilePath(const QString &directory)
+{
+    const QByteArray name = QCryptographicHash::hash(QFile::encodeName(directory),
+                                                     QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + QLatin1String("/qtplugincache/") + QLatin1String(name);
+}
+
+QPluginMetaDataCache::FileKey QPluginMetaDataCache::fileKey(const QString &fileName)
+{
+    FileKey key;
+#ifdef Q_OS_UNIX
+    QT_STATBUF st;
+    if (QT_STAT(QFile::encodeName(fileName), &st) != 0)
+        return key;
+    key.size = st.st_size;
+    key.inode = st.st_ino;
+#  if defined(Q_OS_DARWIN)
+    key.modificationTime = qint64(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#  elif defined(Q_OS_LINUX)
+    key.modificationTime = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#  else
+    key.modificationTime = qint64(st.st_mtime) * 1000000000;
+#  endif
+#else
+    const QFileInfo info(fileName);
+    if (!info.exists())
+        return key;
+    key.size = info.size();
+    key.modificationTime = info.lastModified().toMSecsSinceEpoch() * 1000000;
+#endif
+    return key;
+}
+
+/*
+    Returns the cached entry for \a fileName if the file has not changed since
+    it was stored, or \nullptr otherwise.
+*/
+const QPluginMetaDataCache::Entry *QPluginMetaDataCache::find(const QString &fileName)
+{
+    if (!enabled)
+        return nullptr;
+
+    const FileKey key = fileKey(fileName);
+    Record &record = records[fileName];
+    record.used = true;
+    if (record.valid && key.isValid() && record.key == key)
+        return &record.entry;
+
+    // remember the state of the file from before it gets parsed
+    record.key = key;
+    record.valid = false;
+    return nullptr;
+}
+
+/*
+    Stores \a entry for \a fileName, which must have been looked up with find()
+    before it was parsed.
+*/
+void QPluginMetaDataCache::insert(const QString &fileName, const Entry &entry)
+{
+    if (!enabled)
+        return;
+
+    Record &record = records[fileName];
+    if (!record.key.isValid())
+        return;
+    record.entry = entry;
+    record.used = true;
+    record.valid = true;
+    modified = true;
+}
+
+/*
+    Writes the cache file if any entry was added or changed. Files that were
+    not looked up are dropped from the cache.
+*/
+bool QPluginMetaDataCache::save()
+{
+    if (!enabled || !modified)
+        return true;
+
+    QCborArray plugins;
+    for (auto it = records.cbegin(); it != records.cend(); ++it) {
+        const Record &record = it.value();
+        if (!record.used || !record.valid)
+            continue;
+        QCborMap plugin;
+        plugin[QLatin1String("file")] = it.key();
+        plugin[QLatin1String("size")] = record.key.size;
+        plugin[QLatin1String("mtime")] = record.key.modificationTime;
+        plugin[QLatin1String("inode")] = qint64(record.key.inode);
+        plugin[QLatin1String("isPlugin")] = record.entry.isPlugin;
+        if (record.entry.isPlugin)
+            plugin[QLatin1String("metaData")] = QCborMap::fromJsonObject(record.entry.metaData);
+        else
+            plugin[QLatin1String("error")] = record.entry.errorString;
+        plugins.append(plugin);
+    }
+
+    QCborMap cache;
+    cache[QLatin1String("header")] = cacheHeader(directory);
+    cache[QLatin1String("plugins")] = plugins;
+
+    const QString path = cacheFilePath(directory);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return false;
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(cache.toCborValue().toCbor());
+    if (!file.commit())
+        return false;
+    modified = false;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLUGINMETADATACACHE_P_H
+#define QPLUGINMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(library);
+
+QT_BEGIN_NAMESPACE
+
+/*
+    An on-disk cache of the metadata of the plugins in one directory, so that
+    QFactoryLoader does not have to open and parse each of them on every
+    start-up. Entries are validated against the size, modification time and
+    inode of the files. The cache files are shared by all processes of the
+    user and replaced atomically.
+*/
+class Q_CORE_EXPORT QPluginMetaDataCache
+{
+public:
+    struct Entry
+    {
+        bool isPlugin = false;
+        QJsonObject metaData;
+        QString errorString;
+    };
+
+    explicit QPluginMetaDataCache(const QString &directory);
+
+    static bool isEnabled();
+    static QString cacheFilePath(const QString &directory);
+
+    const Entry *find(const QString &fileName);
+    void insert(const QString &fileName, const Entry &entry);
+    bool save();
+
+private:
+    struct FileKey
+    {
+        qint64 size = -1;
+        qint64 modificationTime = 0; // nanoseconds where available
+        quint64 inode = 0;
+
+        bool isValid() const { return size >= 0; }
+        bool operator==(const FileKey &other) const
+        {
+            return size == other.size && modificationTime == other.modificationTime
+                    && inode == other.inode;
+        }
+    };
+    static FileKey fileKey(const QString &fileName);
+
+    struct Record
+    {
+        FileKey key;
+        Entry entry;
+        bool used = false;  // looked up or inserted, and thus saved
+        bool valid = false; // entry matches key
+    };
+
+    QString directory;
+    QHash<QString, Record> records;
+    bool enabled;
+    bool modified = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLUGINMETADATACACHE_P_H
@@ -372,6 +372,7 @@ void QTextStreamPrivate::reset()
 
     readBufferOffset = 0;
     readBufferStartDevicePos = 0;
+    retainedReadBuffer.clear();
     lastTokenSize = 0;
 
     hasWrittenData = false;
@@ -451,8 +452,12 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            qt_prettyDebug(buf, qMin(32,int(bytesRead)) , int(bytesRead)).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the read buffer, avoiding a temporary QString
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + int(toUtf16.requiredSpace(bytesRead)));
+    const QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                                     QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(int(decodedEnd - readBuffer.constData()));
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -497,6 +502,7 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
 void QTextStreamPrivate::resetReadBuffer()
 {
     readBuffer.clear();
+    retainedReadBuffer.clear();
     readBufferOffset = 0;
     readBufferStartDevicePos = (device ? device->pos() : 0);
 }
@@ -614,6 +620,28 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // Let the vectorized QStringView::indexOf() find the line
+            // feed instead of inspecting the buffer one QChar at a time.
+            int available = endOffset - startOffset;
+            if (maxlen)
+                available = qMin(available, maxlen - totalSize);
+            const int lf = int(QStringView(chPtr, available).indexOf(QLatin1Char('\n')));
+            if (lf >= 0) {
+                const QChar prev = lf > 0 ? chPtr[lf - 1] : lastChar;
+                foundToken = true;
+                delimSize = (prev == QLatin1Char('\r')) ? 2 : 1;
+                consumeDelimiter = true;
+                totalSize += lf + 1;
+                startOffset += lf + 1;
+            } else if (available > 0) {
+                lastChar = chPtr[available - 1];
+                totalSize += available;
+                startOffset += available;
+            }
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -632,12 +660,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == QLatin1Char('\n')) {
-                    foundToken = true;
-                    delimSize = (lastChar == QLatin1Char('\r')) ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE(); // handled above
                 break;
             }
         }
@@ -1655,6 +1678,52 @@ bool QTextStream::readLineInto(QString *line, qint64 maxlen)
     return true;
 }
 
+/*!
+    \since 6.0
+
+    Reads one line of text from the stream and returns it as a view into
+    the stream's internal buffer, without allocating a QString for it.
+
+    The maximum allowed line length is set to \a maxlen. If the stream
+    contains lines longer than this, then the lines will be split after
+    \a maxlen characters and returned in parts. If \a maxlen is 0, the
+    lines can be of any length.
+
+    The returned line has no trailing end-of-line characters ("\\n"
+    or "\\r\\n").
+
+    If the stream has read to the end of the file or an error has
+    occurred, a null QStringView is returned; an empty line is returned
+    as an empty, non-null view.
+
+    \note The returned view is only valid until the next call to a
+    function that reads from, seeks in or resets this stream, or changes
+    its device or string. Convert it to a QString if the data needs to
+    outlive that.
+
+    \sa readLine(), readLineInto()
+*/
+QStringView QTextStream::readLineView(qint64 maxlen)
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(QStringView());
+
+    // drop the data handed out by the previous call
+    d->retainedReadBuffer.clear();
+
+    const QChar *readPtr;
+    int length;
+    if (!d->scan(&readPtr, &length, int(maxlen), QTextStreamPrivate::EndOfLine))
+        return QStringView();
+
+    // consumeLastToken() may free or compact the read buffer; keep a
+    // shallow copy alive so the returned view stays valid.
+    if (d->device)
+        d->retainedReadBuffer = d->readBuffer;
+    d->consumeLastToken();
+    return QStringView(readPtr, length);
+}
+
 /*!
     \since 4.1
 
@@ -1674,6 +1743,33 @@ QString QTextStream::read(qint64 maxlen)
     return d->read(int(maxlen));
 }
 
+/*!
+    \internal
+
+    Accumulates the decimal ASCII digits found at the current read position
+    into \a val, consuming them, and returns how many were read. Only data
+    already present in the buffer is inspected; the caller handles the rest.
+*/
+int QTextStreamPrivate::consumeAsciiDigits(qulonglong *val)
+{
+    const QChar *ptr = readPtr();
+    const int available = string ? string->size() - stringOffset
+                                 : readBuffer.size() - readBufferOffset;
+    qulonglong v = *val;
+    int n = 0;
+    for (; n < available; ++n) {
+        const char16_t c = ptr[n].unicode();
+        if (c < u'0' || c > u'9')
+            break;
+        v = v * 10 + (c - u'0');
+    }
+    if (n) {
+        consume(n);
+        *val = v;
+    }
+    return n;
+}
+
 /*!
     \internal
 */
@@ -1788,13 +1884,16 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
             val += sign.digitValue();
             ndigits++;
         }
-        // Parse digits
+        // Parse the run of ASCII digits available in the buffer in one go
+        ndigits += consumeAsciiDigits(&val);
+        // Parse remaining digits, refilling the buffer as needed
+        const bool skipGroupSeparators = locale != QLocale::c();
         QChar ch;
         while (getChar(&ch)) {
             if (ch.isDigit()) {
                 val *= 10;
                 val += ch.digitValue();
-            } else if (locale != QLocale::c() && ch == locale.groupSeparator()) {
+            } else if (skipGroupSeparators && ch == locale.groupSeparator()) {
                 continue;
             } else {
                 ungetChar(ch);
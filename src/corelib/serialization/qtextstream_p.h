@@ -124,6 +124,7 @@ public:
 
     QString writeBuffer;
     QString readBuffer;
+    QString retainedReadBuffer; // keeps the data viewed by readLineView() alive
     int readBufferOffset;
     int readConverterSavedStateOffset; //the offset between readBufferStartDevicePos and that start of the buffer
     qint64 readBufferStartDevicePos;
@@ -166,6 +167,7 @@ public:
 
     inline bool getChar(QChar *ch);
     inline void ungetChar(QChar ch);
+    int consumeAsciiDigits(qulonglong *val);
     NumberParsingStatus getNumber(qulonglong *l);
     bool getReal(double *f);
 
@@ -64,9 +64,11 @@ public: \
 private:
 #endif
 
+#include <algorithm>
 #include <iterator>
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -1149,7 +1151,11 @@ inline int QXmlStreamReaderPrivate::fastScanLiteralContent()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        // spaces need no normalization, only tabs and line breaks do
+        n += fastScanPlainCharacters(u'&', u'<', u'"', u'\'');
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1222,6 +1228,73 @@ inline int QXmlStreamReaderPrivate::fastScanSpace()
     return n;
 }
 
+/*!
+  \internal
+
+  Returns the number of characters at the start of [\a ptr, \a end) that
+  can be copied to the text buffer without looking at them one by one
+  while scanning character data or literals: anything but control
+  characters (tabs and line breaks need line counting or normalization),
+  the noncharacters U+FFFE and U+FFFF, and the delimiters \a d1 to \a d4.
+ */
+static qsizetype plainCharacterRun(const char16_t *ptr, const char16_t *end,
+                                   char16_t d1, char16_t d2, char16_t d3, char16_t d4)
+{
+    const char16_t *const begin = ptr;
+#ifdef __SSE2__
+    const __m128i lastControl = _mm_set1_epi16(0x1f);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i allOnes = _mm_set1_epi16(-1);
+    const __m128i delim1 = _mm_set1_epi16(short(d1));
+    const __m128i delim2 = _mm_set1_epi16(short(d2));
+    const __m128i delim3 = _mm_set1_epi16(short(d3));
+    const __m128i delim4 = _mm_set1_epi16(short(d4));
+    for ( ; end - ptr >= 8; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        // c < 0x20 is c - 0x1f saturating to zero; c >= 0xfffe is c + 1 saturating to 0xffff
+        __m128i special = _mm_cmpeq_epi16(_mm_subs_epu16(data, lastControl), _mm_setzero_si128());
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(_mm_adds_epu16(data, one), allOnes));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi16(data, delim1),
+                                                     _mm_cmpeq_epi16(data, delim2)));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi16(data, delim3),
+                                                     _mm_cmpeq_epi16(data, delim4)));
+        const uint mask = uint(_mm_movemask_epi8(special));
+        if (mask)
+            return ptr - begin + qCountTrailingZeroBits(mask) / 2;
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        const char16_t c = *ptr;
+        if (c < 0x20 || c >= 0xfffe || c == d1 || c == d2 || c == d3 || c == d4)
+            break;
+    }
+    return ptr - begin;
+}
+
+/*!
+  \internal
+
+  Appends the run of characters at the current read position that need no
+  special treatment (see plainCharacterRun()) to the text buffer in one go,
+  and returns its length. Characters pushed back with putChar() are left to
+  the regular, character by character, scanning.
+ */
+inline int QXmlStreamReaderPrivate::fastScanPlainCharacters(char16_t d1, char16_t d2,
+                                                            char16_t d3, char16_t d4)
+{
+    if (!putStack.isEmpty() || readBufferPos >= readBuffer.size())
+        return 0;
+
+    const QStringView buffer(readBuffer);
+    const char16_t *begin = buffer.utf16() + readBufferPos;
+    const int run = int(plainCharacterRun(begin, buffer.utf16() + buffer.size(), d1, d2, d3, d4));
+    if (run) {
+        textBuffer.append(reinterpret_cast<const QChar *>(begin), run);
+        readBufferPos += run;
+    }
+    return run;
+}
+
 /*!
   \internal
 
@@ -1232,7 +1305,17 @@ inline int QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        if (const int run = fastScanPlainCharacters(u'&', u'<', u']', u']')) {
+            if (isWhitespace) {
+                const QStringView plain = QStringView(textBuffer).last(run);
+                isWhitespace = std::all_of(plain.begin(), plain.end(),
+                                           [](QChar ch) { return ch == QLatin1Char(' '); });
+            }
+            n += run;
+        }
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -506,6 +506,7 @@ public:
 
     // scan optimization functions. Not strictly necessary but LALR is
     // not very well suited for scanning fast
+    inline int fastScanPlainCharacters(char16_t d1, char16_t d2, char16_t d3, char16_t d4);
     int fastScanLiteralContent();
     int fastScanSpace();
     int fastScanContentCharList();
@@ -38,6 +38,12 @@
 ****************************************************************************/
 
 #include "qbytearraymatcher.h"
+#include "qbytearraylist.h"
+#include "qhash.h"
+
+#include "private/qmultimatcher_p.h"
+#include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 #include <limits.h>
 
@@ -87,6 +93,79 @@ static inline qsizetype bm_find(const uchar *cc, qsizetype l, qsizetype index, c
     return -1; // not found
 }
 
+#ifdef __SSE2__
+/*
+    Needles up to this long are searched for with simd_find(), longer ones with
+    bm_find(), whose skips then become long enough to be faster.
+*/
+static constexpr qsizetype SimdMaxNeedleLength = 128;
+
+/*
+    Searches for the needle \a puc of length \a pl (at least 2) by comparing its
+    first and last bytes against 16 (32 with AVX2) consecutive positions of the
+    haystack at once. The bytes in between are compared only at the positions
+    where both of them match.
+*/
+static qsizetype simd_find(const uchar *cc, qsizetype l, qsizetype index, const uchar *puc,
+                           qsizetype pl)
+{
+    Q_ASSERT(pl >= 2);
+    const qsizetype pl_minus_one = pl - 1;
+    auto matchesAt = [=](qsizetype pos) {
+        return memcmp(cc + pos + 1, puc + 1, size_t(pl - 2)) == 0;
+    };
+
+    qsizetype i = index;
+#  if defined(__AVX2__)
+    const __m256i first256 = _mm256_set1_epi8(char(puc[0]));
+    const __m256i last256 = _mm256_set1_epi8(char(puc[pl_minus_one]));
+    for ( ; i + pl_minus_one + 32 <= l; i += 32) {
+        const __m256i firsts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cc + i));
+        const __m256i lasts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cc + i + pl_minus_one));
+        uint mask = uint(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(firsts, first256),
+                                                               _mm256_cmpeq_epi8(lasts, last256))));
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = i + qCountTrailingZeroBits(mask);
+            if (matchesAt(pos))
+                return pos;
+        }
+    }
+#  endif
+    const __m128i first = _mm_set1_epi8(char(puc[0]));
+    const __m128i last = _mm_set1_epi8(char(puc[pl_minus_one]));
+    for ( ; i + pl_minus_one + 16 <= l; i += 16) {
+        const __m128i firsts = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i));
+        const __m128i lasts = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i + pl_minus_one));
+        uint mask = uint(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firsts, first),
+                                                         _mm_cmpeq_epi8(lasts, last))));
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = i + qCountTrailingZeroBits(mask);
+            if (matchesAt(pos))
+                return pos;
+        }
+    }
+
+    for ( ; i + pl_minus_one < l; ++i) {
+        if (cc[i] == puc[0] && cc[i + pl_minus_one] == puc[pl_minus_one] && matchesAt(i))
+            return i;
+    }
+    return -1; // not found
+}
+#endif
+
+/*
+    Dispatches to the fastest of the search functions above for a needle of length \a pl.
+*/
+static inline qsizetype matcher_find(const uchar *cc, qsizetype l, qsizetype index,
+                                     const uchar *puc, qsizetype pl, const uchar *skiptable)
+{
+#ifdef __SSE2__
+    if (pl >= 2 && pl <= SimdMaxNeedleLength)
+        return simd_find(cc, l, index, puc, pl);
+#endif
+    return bm_find(cc, l, index, puc, pl, skiptable);
+}
+
 /*! \class QByteArrayMatcher
     \inmodule QtCore
     \brief The QByteArrayMatcher class holds a sequence of bytes that
@@ -199,8 +278,8 @@ qsizetype QByteArrayMatcher::indexIn(const QByteArray &ba, qsizetype from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
-                   p.p, p.l, p.q_skiptable);
+    return matcher_find(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
+                        p.p, p.l, p.q_skiptable);
 }
 
 /*!
@@ -214,8 +293,8 @@ qsizetype QByteArrayMatcher::indexIn(const char *str, qsizetype len, qsizetype f
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(str), len, from,
-                   p.p, p.l, p.q_skiptable);
+    return matcher_find(reinterpret_cast<const uchar *>(str), len, from,
+                        p.p, p.l, p.q_skiptable);
 }
 
 /*!
@@ -235,11 +314,8 @@ static qsizetype findChar(const char *str, qsizetype len, char ch, qsizetype fro
     if (from < 0)
         from = qMax(from + len, qsizetype(0));
     if (from < len) {
-        const uchar *n = s + from - 1;
-        const uchar *e = s + len;
-        while (++n != e)
-            if (*n == c)
-                return  n - s;
+        if (const void *n = memchr(s + from, c, size_t(len - from)))
+            return static_cast<const uchar *>(n) - s;
     }
     return -1;
 }
@@ -285,6 +361,12 @@ qsizetype qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
+#ifdef __SSE2__
+    if (sl <= SimdMaxNeedleLength)
+        return simd_find(reinterpret_cast<const uchar *>(haystack0), haystackLen, from,
+                         reinterpret_cast<const uchar *>(needle), needleLen);
+#endif
+
     /*
       We use the Boyer-Moore algorithm in cases where the overhead
       for the skip table should pay off, otherwise we use a simple
@@ -322,6 +404,361 @@ qsizetype qFindByteArray(
     return -1;
 }
 
+/*!
+    \internal
+
+    Builds the automaton finding \a patterns, given as sequences of symbols.
+*/
+void QMultiMatcherAutomaton::build(const QList<QList<char32_t>> &patterns)
+{
+    *this = QMultiMatcherAutomaton();
+
+    // give a class to each symbol used by the patterns; all others share class 0
+    bool usedLatin1[256] = {};
+    for (const QList<char32_t> &pattern : patterns) {
+        for (char32_t symbol : pattern) {
+            if (symbol < 256)
+                usedLatin1[symbol] = true;
+            else
+                m_otherSymbols.append(symbol);
+        }
+    }
+    std::sort(m_otherSymbols.begin(), m_otherSymbols.end());
+    m_otherSymbols.erase(std::unique(m_otherSymbols.begin(), m_otherSymbols.end()),
+                         m_otherSymbols.end());
+    for (int symbol = 0; symbol < 256; ++symbol) {
+        if (usedLatin1[symbol])
+            m_latin1Classes[symbol] = m_classCount++;
+    }
+    m_otherClassBase = m_classCount;
+    m_classCount += int(m_otherSymbols.size());
+
+    // the trie of the patterns, as (state, class) -> child; state 0 is the root
+    const auto edgeKey = [](int state, int cls) { return (quint64(state) << 32) | quint32(cls); };
+    QHash<quint64, int> children;
+    m_outputs.append(-1);
+    m_patternLengths.reserve(patterns.size());
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QList<char32_t> &pattern = patterns.at(i);
+        m_patternLengths.append(pattern.size());
+        m_maxPatternLength = qMax(m_maxPatternLength, pattern.size());
+        if (pattern.isEmpty()) {
+            if (m_firstEmptyPattern < 0)
+                m_firstEmptyPattern = i;
+            continue;
+        }
+
+        int state = 0;
+        for (char32_t symbol : pattern) {
+            int &child = children[edgeKey(state, classOf(symbol))];
+            if (!child) {
+                child = int(m_outputs.size());
+                m_outputs.append(-1);
+            }
+            state = child;
+        }
+        if (m_outputs.at(state) < 0)
+            m_outputs[state] = i;
+    }
+    for (int symbol = 0; symbol < 256; ++symbol) {
+        m_latin1FirstSymbols[symbol] = m_latin1Classes[symbol]
+                && children.contains(edgeKey(0, m_latin1Classes[symbol]));
+    }
+    if (m_firstEmptyPattern < 0) {
+        for (const QList<char32_t> &pattern : patterns)
+            m_firstSymbols.append(pattern.first());
+        std::sort(m_firstSymbols.begin(), m_firstSymbols.end());
+        m_firstSymbols.erase(std::unique(m_firstSymbols.begin(), m_firstSymbols.end()),
+                             m_firstSymbols.end());
+    }
+
+    const int stateCount = int(m_outputs.size());
+    m_outputLinks.fill(-1, stateCount);
+    QList<int> queue;
+    queue.reserve(stateCount);
+
+    // The complete DFA has a row of m_classCount transitions per state, which
+    // is too much for many long patterns over many symbols. Beyond this size,
+    // only the trie and the failure links are kept, and indexIn() follows the
+    // failure links instead.
+    constexpr qsizetype MaxDenseTransitions = 1 << 22;
+    qsizetype denseSize;
+    m_dense = !qMulOverflow(qsizetype(stateCount), qsizetype(m_classCount), &denseSize)
+            && denseSize <= MaxDenseTransitions;
+    if (!m_dense) {
+        // the edges of each state sorted by class, and the complete root row
+        QList<std::pair<quint64, int>> edges;
+        edges.reserve(children.size());
+        for (auto it = children.cbegin(); it != children.cend(); ++it)
+            edges.append({ it.key(), it.value() });
+        std::sort(edges.begin(), edges.end());
+        m_transitions.fill(0, m_classCount);
+        m_edgeOffsets.fill(0, stateCount + 1);
+        m_edgeClasses.reserve(edges.size());
+        m_edgeTargets.reserve(edges.size());
+        for (const auto &edge : qAsConst(edges)) {
+            const int state = int(edge.first >> 32);
+            const int cls = int(quint32(edge.first));
+            if (state == 0)
+                m_transitions[cls] = edge.second;
+            ++m_edgeOffsets[state + 1];
+            m_edgeClasses.append(cls);
+            m_edgeTargets.append(edge.second);
+        }
+        for (int state = 0; state < stateCount; ++state)
+            m_edgeOffsets[state + 1] += m_edgeOffsets.at(state);
+
+        // Breadth first, the failure state of each child is where the failure
+        // state of its parent goes on the same class.
+        m_failures.fill(0, stateCount);
+        for (int c = 0; c < m_classCount; ++c) {
+            if (const int child = m_transitions.at(c))
+                queue.append(child);
+        }
+        for (qsizetype head = 0; head < queue.size(); ++head) {
+            const int state = queue.at(head);
+            const int failure = m_failures.at(state);
+            m_outputLinks[state] = m_outputs.at(failure) >= 0 ? failure : m_outputLinks.at(failure);
+            for (int e = m_edgeOffsets.at(state); e < m_edgeOffsets.at(state + 1); ++e) {
+                const int child = m_edgeTargets.at(e);
+                m_failures[child] = nextSparseState(failure, m_edgeClasses.at(e));
+                queue.append(child);
+            }
+        }
+        return;
+    }
+
+    // state 0 also means "no transition" until the automaton is complete
+    m_transitions.fill(0, denseSize);
+    for (auto it = children.cbegin(); it != children.cend(); ++it)
+        m_transitions[qsizetype(it.key() >> 32) * m_classCount + qsizetype(quint32(it.key()))] = it.value();
+
+    // Breadth first, the missing transitions of each state become those of
+    // its failure state, the longest proper suffix of it in the trie, which
+    // is less deep and so has been completed already.
+    QList<int> failures(stateCount, 0);
+    for (int c = 0; c < m_classCount; ++c) {
+        if (const int child = m_transitions.at(c))
+            queue.append(child);
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const int state = queue.at(head);
+        const int failure = failures.at(state);
+        m_outputLinks[state] = m_outputs.at(failure) >= 0 ? failure : m_outputLinks.at(failure);
+        for (int c = 0; c < m_classCount; ++c) {
+            const qsizetype slot = qsizetype(state) * m_classCount + c;
+            const int failureTransition = m_transitions.at(qsizetype(failure) * m_classCount + c);
+            if (const int child = m_transitions.at(slot)) {
+                failures[child] = failureTransition;
+                queue.append(child);
+            } else {
+                m_transitions[slot] = failureTransition;
+            }
+        }
+    }
+
+    // turn the states into offsets of their rows and flag the transitions
+    // into states where some pattern ends; these fit in an int, as
+    // denseSize does
+    for (int &next : m_transitions) {
+        const bool output = m_outputs.at(next) >= 0 || m_outputLinks.at(next) >= 0;
+        next *= m_classCount;
+        if (output)
+            next = ~next;
+    }
+}
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QMultiByteArrayMatcher class finds the first occurrence of any
+    of several sequences of bytes in a byte array.
+
+    \since 6.0
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    A QMultiByteArrayMatcher holds a list of patterns and searches byte arrays
+    for all of them at once, looking at each byte of the searched data only
+    once however many patterns there are. This is much faster than calling
+    QByteArray::indexOf() or QByteArrayMatcher::indexIn() for each pattern in
+    turn, for instance to find keywords or markers in a buffer:
+
+    \code
+    const QMultiByteArrayMatcher markers({ "\r\n", "\n", "\r" });
+    qsizetype marker;
+    const qsizetype end = markers.indexIn(buffer, 0, &marker);
+    \endcode
+
+    The patterns are compiled into an Aho-Corasick automaton when they are set,
+    so a matcher should be created once and reused.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+struct QMultiByteArrayMatcherPrivate : QSharedData
+{
+    QByteArrayList patterns;
+    QMultiMatcherAutomaton automaton;
+    // the bytes that the patterns start with, if there are few enough of
+    // them to look for all at once
+    QByteArray firstBytes;
+};
+
+#ifdef __SSE2__
+/*
+    Returns the position of the first byte in [\a i, \a end) of \a cc that
+    is one of the up to 4 \a firstBytes, or \a end.
+*/
+static qsizetype skipToFirstBytes(const uchar *cc, qsizetype i, qsizetype end,
+                                  const QByteArray &firstBytes)
+{
+    const char *bytes = firstBytes.constData();
+    const qsizetype count = firstBytes.size();
+    const __m128i byte0 = _mm_set1_epi8(bytes[0]);
+    const __m128i byte1 = _mm_set1_epi8(bytes[qMin(count - 1, qsizetype(1))]);
+    const __m128i byte2 = _mm_set1_epi8(bytes[qMin(count - 1, qsizetype(2))]);
+    const __m128i byte3 = _mm_set1_epi8(bytes[qMin(count - 1, qsizetype(3))]);
+    for ( ; i + 16 <= end; i += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i));
+        const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, byte0),
+                                                        _mm_cmpeq_epi8(data, byte1)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(data, byte2),
+                                                        _mm_cmpeq_epi8(data, byte3)));
+        if (const uint mask = uint(_mm_movemask_epi8(found)))
+            return i + qCountTrailingZeroBits(mask);
+    }
+    for ( ; i != end; ++i) {
+        if (memchr(bytes, cc[i], size_t(count)))
+            return i;
+    }
+    return end;
+}
+#endif
+
+static void buildAutomaton(QMultiByteArrayMatcherPrivate *d)
+{
+    QList<QList<char32_t>> symbols;
+    symbols.reserve(d->patterns.size());
+    for (const QByteArray &pattern : qAsConst(d->patterns)) {
+        QList<char32_t> patternSymbols;
+        patternSymbols.reserve(pattern.size());
+        for (char c : pattern)
+            patternSymbols.append(uchar(c));
+        symbols.append(patternSymbols);
+    }
+    d->automaton.build(symbols);
+
+    d->firstBytes.clear();
+#ifdef __SSE2__
+    const QList<char32_t> &firstSymbols = d->automaton.firstSymbols();
+    if (firstSymbols.size() <= 4) {
+        for (char32_t symbol : firstSymbols)
+            d->firstBytes.append(char(symbol));
+    }
+#endif
+}
+
+/*!
+    Constructs a matcher without patterns, which matches nothing.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a patterns.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QByteArrayList &patterns)
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->patterns = patterns;
+    buildAutomaton(d.data());
+}
+
+/*!
+    Constructs a matcher as a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is very fast
+    and never fails.
+*/
+
+/*!
+    Sets the patterns that this matcher searches for to \a patterns.
+
+    \sa patterns()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QByteArrayList &patterns)
+{
+    d->patterns = patterns;
+    buildAutomaton(d.data());
+}
+
+/*!
+    Returns the patterns that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QByteArrayList QMultiByteArrayMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Searches \a data, from byte position \a from (default 0, i.e. from the
+    first byte), for the patterns() and returns the position where the first
+    occurrence of any of them starts, or -1 if none of them occurs.
+
+    If \a matchedPattern is not \nullptr, the index of the pattern that was
+    found is stored in it, or -1 if none was. If several patterns occur at
+    the returned position, the one coming first in patterns() is reported.
+    An empty pattern matches at \a from.
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from,
+                                          qsizetype *matchedPattern) const
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.data());
+    auto byteAt = [bytes](qsizetype i) { return bytes[i]; };
+#ifdef __SSE2__
+    if (!d->firstBytes.isEmpty()) {
+        auto skip = [this, bytes](qsizetype i, qsizetype end) {
+            return skipToFirstBytes(bytes, i, end, d->firstBytes);
+        };
+        return d->automaton.indexIn(data.size(), from, byteAt, skip, matchedPattern);
+    }
+#endif
+    auto skip = [this, byteAt](qsizetype i, qsizetype end) {
+        return d->automaton.skipToFirstSymbol(i, end, byteAt);
+    };
+    return d->automaton.indexIn(data.size(), from, byteAt, skip, matchedPattern);
+}
+
 /*!
     \class QStaticByteArrayMatcherBase
     \since 5.9
@@ -407,8 +844,8 @@ int QStaticByteArrayMatcherBase::indexOfIn(const char *needle, uint nlen, const
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(haystack), hlen, from,
-                   reinterpret_cast<const uchar *>(needle),   nlen, m_skiptable.data);
+    return int(matcher_find(reinterpret_cast<const uchar *>(haystack), hlen, from,
+                            reinterpret_cast<const uchar *>(needle), nlen, m_skiptable.data));
 }
 
 /*!
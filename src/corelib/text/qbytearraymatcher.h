@@ -41,6 +41,7 @@
 #define QBYTEARRAYMATCHER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,6 +84,32 @@ private:
     };
 };
 
+struct QMultiByteArrayMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QByteArrayList &patterns);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    ~QMultiByteArrayMatcher();
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher &operator=(QMultiByteArrayMatcher &&other) noexcept
+    { d.swap(other.d); return *this; }
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    void setPatterns(const QByteArrayList &patterns);
+    QByteArrayList patterns() const;
+
+    qsizetype indexIn(QByteArrayView data, qsizetype from = 0,
+                      qsizetype *matchedPattern = nullptr) const;
+
+private:
+    QSharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
 class QStaticByteArrayMatcherBase
 {
     alignas(16)
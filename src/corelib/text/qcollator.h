@@ -116,6 +116,9 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QList<QCollatorSortKey> sortKeys(const QStringList &strings) const;
+
+    void sort(QStringList &strings) const;
 
 private:
     QCollatorPrivate *d;
@@ -151,6 +151,27 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(QByteArray()));
 }
 
+// Appends the sort key for string, including its terminating '\0', to arena.
+// ICU's keys never contain any other '\0', so they compare with qstrcmp()
+// wherever in the arena they start.
+void QCollatorPrivate::appendSortKey(QByteArray &arena, QStringView string) const
+{
+    Q_ASSERT(collator);
+    const qsizetype offset = arena.size();
+    const int guess = 16 + string.size() + (string.size() >> 2);
+    arena.resize(offset + guess);
+    int size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.data()),
+                               string.size(), reinterpret_cast<uint8_t *>(arena.data() + offset),
+                               guess);
+    if (size > guess) {
+        arena.resize(offset + size);
+        size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.data()),
+                               string.size(), reinterpret_cast<uint8_t *>(arena.data() + offset),
+                               size);
+    }
+    arena.resize(offset + size);
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
     return qstrcmp(d->m_key, otherKey.d->m_key);
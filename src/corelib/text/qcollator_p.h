@@ -117,6 +117,9 @@ public:
     // Implemented by each back-end, in its own way:
     void init();
     void cleanup();
+#if QT_CONFIG(icu)
+    void appendSortKey(QByteArray &arena, QStringView string) const;
+#endif
 
 private:
     Q_DISABLE_COPY_MOVE(QCollatorPrivate)
@@ -3596,6 +3596,32 @@ QString QLocaleData::applyIntegerFormatting(QString &&numStr, bool negative, int
     return result;
 }
 
+/*
+    Equivalent of numericToCLocale() for the C locale, which only needs to
+    look at a single UTF-16 code unit and need not build any of the locale's
+    symbol strings.
+*/
+static inline char cLocaleNumericChar(char16_t ch)
+{
+    if (ch >= u'0' && ch <= u'9')
+        return char(ch);
+    switch (ch) {
+    case u'+':
+        return '+';
+    case u'-':
+    case u'\x2212':
+        return '-';
+    case u'.':
+        return '.';
+    case u'e':
+    case u'E':
+        return 'e';
+    case u',':
+        return ',';
+    }
+    return 0;
+}
+
 /*
     Converts a number in locale to its representation in the C locale.
     Only has to guarantee that a string that is a correct representation of
@@ -3621,11 +3647,15 @@ bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_o
     int last_separator_idx = -1;
     int start_of_digits_idx = -1;
     int exponent_idx = -1;
+    // Most conversions (QString::toDouble() and friends) use the C locale,
+    // whose numeric symbols are all single ASCII characters.
+    const bool isCLocale = this == c();
 
     while (idx < length) {
         const QStringView in = QStringView(uc + idx, uc[idx].isHighSurrogate() ? 2 : 1);
 
-        char out = numericToCLocale(in);
+        char out = isCLocale ? (in.size() == 1 ? cLocaleNumericChar(in.front().unicode()) : 0)
+                             : numericToCLocale(in);
         if (out == 0) {
             const QChar simple = in.size() == 1 ? in.front() : QChar::Null;
             if (in == listSeparator())
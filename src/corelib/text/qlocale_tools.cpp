@@ -282,6 +282,83 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
         --length;
 }
 
+/*
+    Clinger's fast path: if the decimal significand fits in 53 bits and the
+    power of ten is itself exactly representable as a double, a single
+    IEEE multiplication or division yields the correctly rounded result.
+    Only plain decimal input spanning all of \a num is accepted; anything
+    else (spaces, junk, hex, too many digits, large exponents) returns
+    false and is left to the general conversion.
+*/
+static bool fastAsciiToDouble(const char *num, qsizetype numLen, double *result)
+{
+    static constexpr double powersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr int MaxDigits = 15; // 10^15 < 2^53
+    constexpr int MaxPower = int(std::size(powersOfTen)) - 1;
+
+    const char *p = num;
+    const char *const end = num + numLen;
+    const bool negative = *p == '-';
+    if (negative || *p == '+')
+        ++p;
+
+    quint64 significand = 0;
+    int digits = 0;
+    int exponent = 0;
+    const char *const intStart = p;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        if (digits || *p != '0')
+            ++digits;
+        significand = significand * 10 + (*p - '0');
+        if (digits > MaxDigits)
+            return false;
+    }
+    if (p == intStart)
+        return false;
+    if (p != end && *p == '.') {
+        const char *const fracStart = ++p;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (digits || *p != '0')
+                ++digits;
+            significand = significand * 10 + (*p - '0');
+            if (digits > MaxDigits)
+                return false;
+        }
+        if (p == fracStart)
+            return false;
+        exponent -= int(p - fracStart);
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negativeExponent = p != end && *p == '-';
+        if (p != end && (negativeExponent || *p == '+'))
+            ++p;
+        const char *const expStart = p;
+        int e = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            e = e * 10 + (*p - '0');
+            if (p - expStart > 3)
+                return false;
+        }
+        if (p == expStart)
+            return false;
+        exponent += negativeExponent ? -e : e;
+    }
+    if (p != end || exponent < -MaxPower || exponent > MaxPower)
+        return false;
+
+    double d = double(significand);
+    if (exponent < 0)
+        d /= powersOfTen[-exponent];
+    else
+        d *= powersOfTen[exponent];
+    *result = negative ? -d : d;
+    return true;
+}
+
 double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &processed,
                         StrayCharacterMode strayCharMode)
 {
@@ -324,6 +401,11 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+    if (int(numLen) == numLen && fastAsciiToDouble(num, numLen, &d)) {
+        processed = int(numLen);
+        return d;
+    }
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
@@ -0,0 +1,217 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTIMATCHER_P_H
+#define QMULTIMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    An Aho-Corasick automaton, finding the leftmost occurrence of any of a set of
+    patterns in a single pass over the haystack. Patterns and haystack are seen as
+    sequences of symbols: code units, or case-folded code points for
+    case-insensitive string matching.
+
+    The automaton is a complete DFA over the classes of the symbols used by the
+    patterns, plus one class (0) for all other symbols, so that each symbol of the
+    haystack costs a class lookup and a transition lookup. When that DFA would be
+    too large, only the trie of the patterns and its failure links are kept. While
+    no pattern has been started, the haystack is scanned by a separate function,
+    which the users can replace by a vectorized search for the firstSymbols().
+*/
+class QMultiMatcherAutomaton
+{
+public:
+    void build(const QList<QList<char32_t>> &patterns);
+
+    bool isEmpty() const { return m_patternLengths.isEmpty(); }
+
+    // The symbols that the patterns start with; empty if a pattern is empty
+    const QList<char32_t> &firstSymbols() const { return m_firstSymbols; }
+
+    // Returns the first position in [\a i, \a end) where a pattern may
+    // start, or \a end.
+    template <typename SymbolAt>
+    qsizetype skipToFirstSymbol(qsizetype i, qsizetype end, SymbolAt symbolAt) const
+    {
+        for ( ; i != end; ++i) {
+            const char32_t symbol = symbolAt(i);
+            if (symbol < 256 ? m_latin1FirstSymbols[symbol] : m_transitions[classOf(symbol)] != 0)
+                break;
+        }
+        return i;
+    }
+
+    // Returns the start of the leftmost match at or after \a from of the
+    // symbols returned by \a symbolAt for the positions up to \a length. If
+    // several patterns match there, the one added first wins. \a skip is
+    // skipToFirstSymbol() or an equivalent function.
+    template <typename SymbolAt, typename Skip>
+    qsizetype indexIn(qsizetype length, qsizetype from, SymbolAt symbolAt, Skip skip,
+                      qsizetype *matchedPattern) const
+    {
+        qsizetype bestStart = -1;
+        qsizetype bestPattern = -1;
+        if (from < 0)
+            from = 0;
+        if (from <= length && !isEmpty()) {
+            // any match ending at or after end would start after the best one so far
+            qsizetype end = length;
+            if (m_firstEmptyPattern >= 0) {
+                bestStart = from;
+                bestPattern = m_firstEmptyPattern;
+                end = qMin(length, bestStart + m_maxPatternLength);
+            }
+
+            const bool dense = m_dense;
+            const int *transitions = m_transitions.constData();
+            int state = 0;
+            for (qsizetype i = from; i < end; ++i) {
+                if (state == 0) {
+                    i = skip(i, end);
+                    if (i == end)
+                        break;
+                }
+
+                const int cls = classOf(symbolAt(i));
+                int stateIndex;
+                if (dense) {
+                    state = transitions[state + cls];
+                    if (state >= 0)
+                        continue;
+                    state = ~state;
+                    stateIndex = state / m_classCount;
+                } else {
+                    state = nextSparseState(state, cls);
+                    if (m_outputs[state] < 0 && m_outputLinks[state] < 0)
+                        continue;
+                    stateIndex = state;
+                }
+
+                // some patterns end here
+                int s = m_outputs[stateIndex] >= 0 ? stateIndex : m_outputLinks[stateIndex];
+                for ( ; s >= 0; s = m_outputLinks[s]) {
+                    const qsizetype pattern = m_outputs[s];
+                    const qsizetype start = i + 1 - m_patternLengths[pattern];
+                    if (bestStart < 0 || start < bestStart
+                            || (start == bestStart && pattern < bestPattern)) {
+                        bestStart = start;
+                        bestPattern = pattern;
+                        end = qMin(length, bestStart + m_maxPatternLength);
+                    }
+                }
+            }
+        }
+
+        if (matchedPattern)
+            *matchedPattern = bestPattern;
+        return bestStart;
+    }
+
+private:
+    int classOf(char32_t symbol) const
+    {
+        if (symbol < 256)
+            return m_latin1Classes[symbol];
+        const auto it = std::lower_bound(m_otherSymbols.cbegin(), m_otherSymbols.cend(), symbol);
+        if (it == m_otherSymbols.cend() || *it != symbol)
+            return 0;
+        return m_otherClassBase + int(it - m_otherSymbols.cbegin());
+    }
+
+    // Without the complete DFA: the state reached from \a state on \a cls,
+    // following the failure links until the state has a child for it. The
+    // root row is complete, so this ends there at the latest.
+    int nextSparseState(int state, int cls) const
+    {
+        for (;;) {
+            if (state == 0)
+                return m_transitions[cls];
+            const auto begin = m_edgeClasses.cbegin() + m_edgeOffsets[state];
+            const auto end = m_edgeClasses.cbegin() + m_edgeOffsets[state + 1];
+            const auto it = std::lower_bound(begin, end, cls);
+            if (it != end && *it == cls)
+                return m_edgeTargets[it - m_edgeClasses.cbegin()];
+            state = m_failures[state];
+        }
+    }
+
+    int m_latin1Classes[256] = {};
+    bool m_latin1FirstSymbols[256] = {};
+    QList<char32_t> m_otherSymbols;     // sorted, classes from m_otherClassBase on
+    QList<char32_t> m_firstSymbols;
+    int m_otherClassBase = 1;
+    int m_classCount = 1;
+
+    // With m_dense: state * m_classCount + class -> next state * m_classCount,
+    // bitwise negated if some pattern ends in the next state. Otherwise only
+    // the root row, class -> next state.
+    QList<int> m_transitions;
+    bool m_dense = true;
+    // without m_dense: the children of each state, sorted by class
+    QList<int> m_edgeOffsets;           // state -> first edge; one more for the end
+    QList<int> m_edgeClasses;
+    QList<int> m_edgeTargets;
+    QList<int> m_failures;              // state -> longest proper suffix state
+    QList<qsizetype> m_outputs;         // state -> pattern ending there, or -1
+    QList<int> m_outputLinks;           // state -> longest suffix state with an output, or -1
+    QList<qsizetype> m_patternLengths;
+    qsizetype m_maxPatternLength = 0;
+    qsizetype m_firstEmptyPattern = -1;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMULTIMATCHER_P_H
@@ -41,6 +41,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -52,6 +53,9 @@
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
 
+#include <algorithm>
+#include <optional>
+
 #define PCRE2_CODE_UNIT_WIDTH 16
 
 #include <pcre2.h>
@@ -723,6 +727,20 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A compiled (and possibly JIT-compiled) PCRE2 pattern. Once created it is
+    never modified again, so it can be shared between any number of
+    QRegularExpressionPrivate objects and used from several threads at once.
+*/
+struct QPcreCompiledPattern : QSharedData
+{
+    explicit QPcreCompiledPattern(pcre2_code_16 *code) : code(code) {}
+    ~QPcreCompiledPattern() { pcre2_code_free_16(code); }
+    Q_DISABLE_COPY_MOVE(QPcreCompiledPattern)
+
+    pcre2_code_16 *const code;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -755,9 +773,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is reference-counted through sharedPattern, and may also
+    // be referenced by the process-wide pattern cache; compiledPattern is a
+    // shortcut to sharedPattern->code. When the private is copied (i.e. a
+    // detach happened) both are reset.
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> sharedPattern;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -873,7 +893,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    sharedPattern.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -881,8 +901,66 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     usingCrLfNewlines = false;
 }
 
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions options;
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs,
+                           const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.options == rhs.options && lhs.pattern == rhs.pattern;
+    }
+};
+
+size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.pattern, int(key.options));
+}
+
+/*
+    Process-wide cache of successfully compiled patterns, so that creating
+    the same QRegularExpression over and over again (in a loop, or in
+    different threads) compiles and JIT-compiles it only once.
+*/
+class QRegularExpressionPatternCache
+{
+public:
+    // QCache owns the entries; an entry just holds a reference to the pattern
+    struct Entry
+    {
+        QExplicitlySharedDataPointer<QPcreCompiledPattern> pattern;
+    };
+
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> find(const QRegularExpressionCacheKey &key)
+    {
+        const QMutexLocker lock(&mutex);
+        if (Entry *entry = cache.object(key))
+            return entry->pattern;
+        return {};
+    }
+
+    void insert(const QRegularExpressionCacheKey &key,
+                const QExplicitlySharedDataPointer<QPcreCompiledPattern> &pattern)
+    {
+        const QMutexLocker lock(&mutex);
+        cache.insert(key, new Entry{pattern});
+    }
+
+private:
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, Entry> cache{256};
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionPatternCache, patternCache)
+
 /*!
     \internal
+
+    Compiles the pattern, or fetches an already compiled copy of it from the
+    process-wide pattern cache. Patterns that fail to compile are not cached.
 */
 void QRegularExpressionPrivate::compilePattern()
 {
@@ -894,6 +972,17 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
+    QRegularExpressionPatternCache *cache = patternCache();
+    const QRegularExpressionCacheKey key{pattern, patternOptions};
+    if (cache) {
+        sharedPattern = cache->find(key);
+        if (sharedPattern) {
+            compiledPattern = sharedPattern->code;
+            getPatternInfo();
+            return;
+        }
+    }
+
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
@@ -913,8 +1002,13 @@ void QRegularExpressionPrivate::compilePattern()
         errorCode = 0;
     }
 
+    sharedPattern = new QPcreCompiledPattern(compiledPattern);
     optimizePattern();
     getPatternInfo();
+
+    // only publish the pattern once it's JIT-compiled; from now on it's immutable
+    if (cache)
+        cache->insert(key, sharedPattern);
 }
 
 /*!
@@ -989,6 +1083,62 @@ static pcre2_jit_stack_16 *qtPcreCallback(void *)
     return nullptr;
 }
 
+/*
+    The match context and match data used by doMatch(), kept per thread so
+    that matching does not need to allocate and free them every time. The
+    match data only ever grows, to accommodate the pattern with the most
+    capturing groups matched so far in the thread.
+*/
+class QPcreMatchResources
+{
+    Q_DISABLE_COPY(QPcreMatchResources)
+
+public:
+    QPcreMatchResources()
+        : matchContext(pcre2_match_context_create_16(nullptr))
+    {
+        pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
+    }
+
+    ~QPcreMatchResources()
+    {
+        pcre2_match_data_free_16(matchData);
+        pcre2_match_context_free_16(matchContext);
+    }
+
+    pcre2_match_data_16 *matchDataFor(int capturingCount)
+    {
+        const uint32_t pairs = uint32_t(capturingCount) + 1;
+        if (!matchData || pcre2_get_ovector_count_16(matchData) < pairs) {
+            pcre2_match_data_free_16(matchData);
+            matchData = pcre2_match_data_create_16(pairs, nullptr);
+        }
+        return matchData;
+    }
+
+    pcre2_match_context_16 *matchContext;
+    pcre2_match_data_16 *matchData = nullptr;
+};
+
+Q_GLOBAL_STATIC(QThreadStorage<QPcreMatchResources *>, matchResources)
+
+/*!
+    \internal
+
+    Returns the match resources of the current thread. While static data is
+    being destroyed they are gone, and this returns resources created in
+    \a fallback, which only last as long as the caller keeps it.
+*/
+static QPcreMatchResources *localMatchResources(std::optional<QPcreMatchResources> &fallback)
+{
+    QThreadStorage<QPcreMatchResources *> *storage = matchResources();
+    if (!storage)
+        return &fallback.emplace();
+    if (!storage->hasLocalData())
+        storage->setLocalData(new QPcreMatchResources);
+    return storage->localData();
+}
+
 /*!
     \internal
 */
@@ -1162,9 +1312,10 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    std::optional<QPcreMatchResources> fallbackResources;
+    QPcreMatchResources *resources = localMatchResources(fallbackResources);
+    pcre2_match_context_16 *matchContext = resources->matchContext;
+    pcre2_match_data_16 *matchData = resources->matchDataFor(capturingCount);
 
     const char16_t * const subjectUtf16 = priv->subject.utf16();
 
@@ -1259,9 +1410,6 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
             capturedOffsets[0] -= maximumLookBehind;
         }
     }
-
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
 }
 
 /*!
@@ -2597,6 +2745,316 @@ QtPrivate::QRegularExpressionMatchIteratorRangeBasedForIterator begin(const QReg
   \internal
 */
 
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSet class matches a string against many
+    regular expressions at once.
+
+    \since 6.0
+
+    \ingroup tools
+    \ingroup shared
+
+    A QRegularExpressionSet holds a list of patterns, all using the same
+    pattern options, and finds which of them matches a given subject string.
+    This is typically used to classify input, for instance log lines, by
+    the first of many rules that applies:
+
+    \code
+    const QRegularExpressionSet rules({ "^ERROR\\b", "^WARN(ING)?\\b", "timeout" });
+    switch (rules.matchingPattern(line)) {
+    case 0: ...
+    }
+    \endcode
+
+    Where possible the patterns are combined into a single compiled
+    expression, so that the subject is scanned once rather than once per
+    pattern. Patterns using back references, named or recursive groups,
+    \c{(*VERB)} sequences, \c{\\Q} quoting or comments, as well as all the
+    patterns of a set using QRegularExpression::DontCaptureOption, are matched
+    on their own instead; this does not change the result, only the speed.
+
+    \sa QRegularExpression
+*/
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    void compile();
+    static bool canCombine(const QRegularExpressionPrivate *re);
+
+    QStringList patterns;
+    QRegularExpression::PatternOptions patternOptions = QRegularExpression::NoPatternOption;
+
+    // one expression per pattern, also used to match those patterns
+    // that cannot be folded into the combined expression
+    QList<QRegularExpression> expressions;
+    QList<int> separatePatterns;
+
+    // alternation of all the other patterns, each followed by an empty
+    // marker group; the marker that matched tells which pattern matched
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> combined;
+    QList<int> markerGroups; // ascending
+    QList<int> markerPatterns;
+    int combinedCapturingCount = 0;
+    bool valid = true;
+};
+
+/*!
+    \internal
+
+    Returns whether the pattern of \a re can be used as an alternative of
+    a bigger expression without changing its meaning: the capturing groups
+    get renumbered, and the pattern must not extend past the group it is
+    wrapped into.
+*/
+bool QRegularExpressionSetPrivate::canCombine(const QRegularExpressionPrivate *re)
+{
+    const QString &pattern = re->pattern;
+    if (pattern.contains(QLatin1String("(*")) || pattern.contains(QLatin1String("\\Q"))
+            || pattern.contains(QLatin1String("\\g"))) {
+        return false;
+    }
+
+    // with extended syntax, '#' starts a comment that would swallow the end of the group
+    bool extendedSyntax = re->patternOptions & QRegularExpression::ExtendedPatternSyntaxOption;
+
+    // recursion and subroutine calls by number: (?R), (?1), (?+1), (?-1)
+    for (qsizetype i = pattern.indexOf(QLatin1String("(?")); i >= 0;
+         i = pattern.indexOf(QLatin1String("(?"), i + 2)) {
+        const QStringView rest = QStringView(pattern).mid(i + 2);
+        if (rest.isEmpty())
+            break;
+        QChar c = rest.front();
+        if ((c == QLatin1Char('+') || c == QLatin1Char('-')) && rest.size() > 1)
+            c = rest.at(1);
+        if (c == QLatin1Char('R') || c.isDigit())
+            return false;
+
+        // option settings like (?x) or (?i-x:...); turning x off counts too, to keep it simple
+        qsizetype n = 0;
+        while (n < rest.size() && (rest.at(n).isLetter() || rest.at(n) == QLatin1Char('-')
+                                   || rest.at(n) == QLatin1Char('^'))) {
+            ++n;
+        }
+        if (n < rest.size() && (rest.at(n) == QLatin1Char(')') || rest.at(n) == QLatin1Char(':'))
+                && rest.left(n).contains(QLatin1Char('x'))) {
+            extendedSyntax = true;
+        }
+    }
+    if (extendedSyntax && pattern.contains(QLatin1Char('#')))
+        return false;
+
+    uint32_t backReferenceMax = 0;
+    uint32_t nameCount = 0;
+    pcre2_pattern_info_16(re->compiledPattern, PCRE2_INFO_BACKREFMAX, &backReferenceMax);
+    pcre2_pattern_info_16(re->compiledPattern, PCRE2_INFO_NAMECOUNT, &nameCount);
+    return backReferenceMax == 0 && nameCount == 0;
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionSetPrivate::compile()
+{
+    QString combinedPattern;
+    int groupCount = 0;
+    // the marker groups must capture
+    const bool combine = !(patternOptions & QRegularExpression::DontCaptureOption);
+
+    expressions.reserve(patterns.size());
+    for (int i = 0; i < patterns.size(); ++i) {
+        const QRegularExpression re(patterns.at(i), patternOptions);
+        expressions.append(re);
+        if (!re.isValid()) {
+            valid = false;
+            continue;
+        }
+
+        if (!combine || !canCombine(re.d.data())) {
+            separatePatterns.append(i);
+            continue;
+        }
+
+        if (!combinedPattern.isEmpty())
+            combinedPattern += QLatin1Char('|');
+        combinedPattern += QLatin1String("(?:") + re.pattern() + QLatin1String(")()");
+        groupCount += re.captureCount() + 1;
+        markerGroups.append(groupCount);
+        markerPatterns.append(i);
+    }
+
+    if (!valid || combinedPattern.isEmpty())
+        return;
+
+    const int options = convertToPcreOptions(patternOptions) | PCRE2_UTF;
+    int errorCode;
+    PCRE2_SIZE errorOffset;
+    pcre2_code_16 *code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(combinedPattern.utf16()),
+                                           combinedPattern.length(), options,
+                                           &errorCode, &errorOffset, nullptr);
+    if (!code) {
+        // shouldn't happen, but matching the patterns one by one still works
+        separatePatterns.clear();
+        for (int i = 0; i < patterns.size(); ++i)
+            separatePatterns.append(i);
+        markerGroups.clear();
+        markerPatterns.clear();
+        return;
+    }
+
+    static const bool enableJit = isJitEnabled();
+    if (enableJit)
+        pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE);
+
+    combined = new QPcreCompiledPattern(code);
+    combinedCapturingCount = groupCount;
+}
+
+/*!
+    Constructs an empty set, which matches nothing.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a set holding the given \a patterns, each compiled with the
+    pattern options \a options.
+
+    \sa isValid()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->patterns = patterns;
+    d->patternOptions = options;
+    d->compile();
+}
+
+/*!
+    Constructs a set as a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other) = default;
+
+/*!
+    Destroys the set.
+*/
+QRegularExpressionSet::~QRegularExpressionSet() = default;
+
+/*!
+    Assigns \a other to this set and returns a reference to this set.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other) = default;
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this set.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps the set \a other with this set. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns the patterns of this set.
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Returns the pattern options used for all the patterns of this set.
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Returns the number of patterns in this set.
+*/
+qsizetype QRegularExpressionSet::size() const
+{
+    return d->patterns.size();
+}
+
+/*!
+    Returns \c true if all the patterns of this set are valid regular
+    expressions; otherwise returns \c false. An invalid set never matches.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return d->valid;
+}
+
+/*!
+    Matches the patterns of this set against \a subject, starting at the
+    position \a offset, and returns the index of the pattern whose match
+    starts earliest in the subject. If several patterns match at that
+    position, the one coming first in the set wins. Returns -1 if no pattern
+    matches or if the set is not valid.
+
+    A negative \a offset is taken as an offset from the end of the subject,
+    as in QRegularExpression::match().
+*/
+int QRegularExpressionSet::matchingPattern(QStringView subject, qsizetype offset) const
+{
+    if (!d->valid)
+        return -1;
+
+    if (offset < 0)
+        offset += subject.size();
+    if (offset < 0 || offset > subject.size())
+        return -1;
+
+    int best = -1;
+    qsizetype bestStart = -1;
+
+    if (d->combined) {
+        std::optional<QPcreMatchResources> fallbackResources;
+        QPcreMatchResources *resources = localMatchResources(fallbackResources);
+        pcre2_match_data_16 *matchData = resources->matchDataFor(d->combinedCapturingCount);
+        const char16_t *subjectUtf16 = subject.isNull() ? u"" : subject.utf16();
+        const int result = safe_pcre2_match_16(d->combined->code,
+                                               reinterpret_cast<PCRE2_SPTR16>(subjectUtf16),
+                                               subject.size(), offset, 0,
+                                               matchData, resources->matchContext);
+        if (result > 0) {
+            // the highest group set is the marker of the alternative that matched
+            const auto it = std::lower_bound(d->markerGroups.cbegin(), d->markerGroups.cend(),
+                                             result - 1);
+            Q_ASSERT(it != d->markerGroups.cend() && *it == result - 1);
+            best = d->markerPatterns.at(it - d->markerGroups.cbegin());
+            bestStart = qsizetype(pcre2_get_ovector_pointer_16(matchData)[0]);
+        }
+    }
+
+    for (int i : qAsConst(d->separatePatterns)) {
+        const QRegularExpressionMatch match = d->expressions.at(i).match(subject, offset);
+        if (!match.hasMatch())
+            continue;
+        const qsizetype start = match.capturedStart();
+        if (best == -1 || start < bestStart || (start == bestStart && i < best)) {
+            best = i;
+            bestStart = start;
+        }
+    }
+
+    return best;
+}
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
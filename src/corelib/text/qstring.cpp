@@ -10056,6 +10056,11 @@ qsizetype QtPrivate::findString(QStringView haystack0, qsizetype from, QStringVi
     if (sl == 1)
         return qFindChar(haystack0, needle0[0], from, cs);
 
+#ifdef __SSE2__
+    if (cs == Qt::CaseSensitive && sl <= SimdMaxNeedleLength)
+        return simd_find(haystack0, from, needle0);
+#endif
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
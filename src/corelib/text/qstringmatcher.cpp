@@ -39,6 +39,10 @@
 ****************************************************************************/
 
 #include "qstringmatcher.h"
+#include "qstringlist.h"
+
+#include "private/qmultimatcher_p.h"
+#include "private/qsimd_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -128,6 +132,84 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
     return -1; // not found
 }
 
+#ifdef __SSE2__
+/*
+    Case-sensitive needles up to this long are searched for with simd_find(),
+    longer ones with bm_find(), whose skips then become long enough to be faster.
+*/
+static constexpr qsizetype SimdMaxNeedleLength = 128;
+
+/*
+    Case-sensitively searches for \a needle (of at least 2 characters) by
+    comparing its first and last characters against 8 (16 with AVX2) consecutive
+    positions of \a haystack at once. The characters in between are compared only
+    at the positions where both of them match.
+*/
+static qsizetype simd_find(QStringView haystack, qsizetype index, QStringView needle)
+{
+    const char16_t *uc = haystack.utf16();
+    const qsizetype l = haystack.size();
+    const char16_t *puc = needle.utf16();
+    const qsizetype pl = needle.size();
+    Q_ASSERT(pl >= 2);
+    const qsizetype pl_minus_one = pl - 1;
+    auto matchesAt = [=](qsizetype pos) {
+        return memcmp(uc + pos + 1, puc + 1, size_t(pl - 2) * sizeof(char16_t)) == 0;
+    };
+
+    // Using the PMOVMSKB instruction, we get two bits for each character
+    // we compare; only the lower one of each pair is kept.
+    qsizetype i = index;
+#  if defined(__AVX2__)
+    const __m256i first256 = _mm256_set1_epi16(short(puc[0]));
+    const __m256i last256 = _mm256_set1_epi16(short(puc[pl_minus_one]));
+    for ( ; i + pl_minus_one + 16 <= l; i += 16) {
+        const __m256i firsts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(uc + i));
+        const __m256i lasts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(uc + i + pl_minus_one));
+        uint mask = uint(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi16(firsts, first256),
+                                                               _mm256_cmpeq_epi16(lasts, last256))));
+        for (mask &= 0x55555555; mask; mask &= mask - 1) {
+            const qsizetype pos = i + qCountTrailingZeroBits(mask) / 2;
+            if (matchesAt(pos))
+                return pos;
+        }
+    }
+#  endif
+    const __m128i first = _mm_set1_epi16(short(puc[0]));
+    const __m128i last = _mm_set1_epi16(short(puc[pl_minus_one]));
+    for ( ; i + pl_minus_one + 8 <= l; i += 8) {
+        const __m128i firsts = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i));
+        const __m128i lasts = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i + pl_minus_one));
+        uint mask = uint(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(firsts, first),
+                                                         _mm_cmpeq_epi16(lasts, last))));
+        for (mask &= 0x5555; mask; mask &= mask - 1) {
+            const qsizetype pos = i + qCountTrailingZeroBits(mask) / 2;
+            if (matchesAt(pos))
+                return pos;
+        }
+    }
+
+    for ( ; i + pl_minus_one < l; ++i) {
+        if (uc[i] == puc[0] && uc[i + pl_minus_one] == puc[pl_minus_one] && matchesAt(i))
+            return i;
+    }
+    return -1; // not found
+}
+#endif
+
+/*
+    Dispatches to the fastest of the search functions above for \a needle.
+*/
+static inline qsizetype matcher_find(QStringView haystack, qsizetype index, QStringView needle,
+                                     const uchar *skiptable, Qt::CaseSensitivity cs)
+{
+#ifdef __SSE2__
+    if (cs == Qt::CaseSensitive && needle.size() >= 2 && needle.size() <= SimdMaxNeedleLength)
+        return simd_find(haystack, index, needle);
+#endif
+    return bm_find(haystack, index, needle, skiptable, cs);
+}
+
 void QStringMatcher::updateSkipTable()
 {
     bm_init_skiptable(q_sv, q_skiptable, q_cs);
@@ -310,7 +392,7 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find(str, from, q_sv, q_skiptable, q_cs);
+    return matcher_find(str, from, q_sv, q_skiptable, q_cs);
 }
 
 /*!
@@ -321,6 +403,246 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
     \sa setCaseSensitivity()
 */
 
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QMultiStringMatcher class finds the first occurrence of any of
+    several strings in a Unicode string.
+
+    \since 6.0
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    A QMultiStringMatcher holds a list of patterns and searches strings for all
+    of them at once, looking at each character of the searched string only
+    once however many patterns there are. This is much faster than calling
+    QString::indexOf() or QStringMatcher::indexIn() for each pattern in turn,
+    for instance to find any of a list of keywords:
+
+    \code
+    const QMultiStringMatcher keywords({ QStringLiteral("TODO"), QStringLiteral("FIXME") });
+    qsizetype keyword;
+    for (qsizetype pos = keywords.indexIn(text, 0, &keyword); pos >= 0;
+         pos = keywords.indexIn(text, pos + 1, &keyword)) {
+        ...
+    }
+    \endcode
+
+    The patterns are compiled into an Aho-Corasick automaton when they are set,
+    so a matcher should be created once and reused. When the matcher is case
+    insensitive, the patterns and the searched strings are compared after case
+    folding, as QStringMatcher does.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+struct QMultiStringMatcherPrivate : QSharedData
+{
+    void buildAutomaton();
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    QMultiMatcherAutomaton automaton;
+    // the characters that the patterns start with, if matching case
+    // sensitively and there are few enough of them to look for all at once
+    QString firstChars;
+};
+
+#ifdef __SSE2__
+/*
+    Returns the position of the first character in [\a i, \a end) of \a uc
+    that is one of the up to 4 \a firstChars, or \a end.
+*/
+static qsizetype skipToFirstChars(const char16_t *uc, qsizetype i, qsizetype end,
+                                  QStringView firstChars)
+{
+    const char16_t *chars = firstChars.utf16();
+    const qsizetype count = firstChars.size();
+    const __m128i char0 = _mm_set1_epi16(short(chars[0]));
+    const __m128i char1 = _mm_set1_epi16(short(chars[qMin(count - 1, qsizetype(1))]));
+    const __m128i char2 = _mm_set1_epi16(short(chars[qMin(count - 1, qsizetype(2))]));
+    const __m128i char3 = _mm_set1_epi16(short(chars[qMin(count - 1, qsizetype(3))]));
+    for ( ; i + 8 <= end; i += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i));
+        const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(data, char0),
+                                                        _mm_cmpeq_epi16(data, char1)),
+                                           _mm_or_si128(_mm_cmpeq_epi16(data, char2),
+                                                        _mm_cmpeq_epi16(data, char3)));
+        if (const uint mask = uint(_mm_movemask_epi8(found)))
+            return i + qCountTrailingZeroBits(mask) / 2;
+    }
+    for ( ; i != end; ++i) {
+        if (firstChars.contains(QChar(uc[i])))
+            return i;
+    }
+    return end;
+}
+#endif
+
+void QMultiStringMatcherPrivate::buildAutomaton()
+{
+    QList<QList<char32_t>> symbols;
+    symbols.reserve(patterns.size());
+    for (const QString &pattern : qAsConst(patterns)) {
+        const char16_t *uc = QStringView(pattern).utf16();
+        QList<char32_t> patternSymbols;
+        patternSymbols.reserve(pattern.size());
+        for (qsizetype i = 0; i < pattern.size(); ++i)
+            patternSymbols.append(cs == Qt::CaseSensitive ? char32_t(uc[i]) : foldCase(uc + i, uc));
+        symbols.append(patternSymbols);
+    }
+    automaton.build(symbols);
+
+    firstChars.clear();
+#ifdef __SSE2__
+    const QList<char32_t> &firstSymbols = automaton.firstSymbols();
+    if (cs == Qt::CaseSensitive && firstSymbols.size() <= 4) {
+        for (char32_t symbol : firstSymbols)
+            firstChars.append(QChar(char16_t(symbol)));
+    }
+#endif
+}
+
+/*!
+    Constructs a matcher without patterns, which matches nothing.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate)
+{
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a patterns, with
+    case sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->patterns = patterns;
+    d->cs = cs;
+    d->buildAutomaton();
+}
+
+/*!
+    Constructs a matcher as a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is very fast
+    and never fails.
+*/
+
+/*!
+    Sets the patterns that this matcher searches for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d->patterns = patterns;
+    d->buildAutomaton();
+}
+
+/*!
+    Returns the patterns that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity setting of this matcher to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == d->cs)
+        return;
+    d->cs = cs;
+    d->buildAutomaton();
+}
+
+/*!
+    Returns the case sensitivity setting of this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the string \a str, from character position \a from (default 0,
+    i.e. from the first character), for the patterns() and returns the position
+    where the first occurrence of any of them starts, or -1 if none of them
+    occurs.
+
+    If \a matchedPattern is not \nullptr, the index of the pattern that was
+    found is stored in it, or -1 if none was. If several patterns occur at
+    the returned position, the one coming first in patterns() is reported.
+    An empty pattern matches at \a from.
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from,
+                                       qsizetype *matchedPattern) const
+{
+    const char16_t *uc = str.utf16();
+    if (d->cs == Qt::CaseSensitive) {
+        auto charAt = [uc](qsizetype i) { return char32_t(uc[i]); };
+#ifdef __SSE2__
+        if (!d->firstChars.isEmpty()) {
+            auto skip = [this, uc](qsizetype i, qsizetype end) {
+                return skipToFirstChars(uc, i, end, d->firstChars);
+            };
+            return d->automaton.indexIn(str.size(), from, charAt, skip, matchedPattern);
+        }
+#endif
+        auto skip = [this, charAt](qsizetype i, qsizetype end) {
+            return d->automaton.skipToFirstSymbol(i, end, charAt);
+        };
+        return d->automaton.indexIn(str.size(), from, charAt, skip, matchedPattern);
+    }
+
+    auto foldedAt = [uc](qsizetype i) {
+        const char16_t ch = uc[i];
+        // US-ASCII characters fold to their lower case
+        if (ch < 0x80)
+            return char32_t(ch >= u'A' && ch <= u'Z' ? ch + 0x20 : ch);
+        return foldCase(uc + i, uc);
+    };
+    auto skip = [this, foldedAt](qsizetype i, qsizetype end) {
+        return d->automaton.skipToFirstSymbol(i, end, foldedAt);
+    };
+    return d->automaton.indexIn(str.size(), from, foldedAt, skip, matchedPattern);
+}
+
 /*!
     \internal
 */
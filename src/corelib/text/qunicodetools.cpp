@@ -43,6 +43,8 @@
 #include "qvarlengtharray.h"
 #include "qlibrary.h"
 
+#include "private/qsimd_p.h"
+
 #define FLAG(x) (1 << (x))
 
 QT_BEGIN_NAMESPACE
@@ -58,6 +60,77 @@ namespace QUnicodeTools {
 //
 // -----------------------------------------------------------------------------------------------------
 
+/*
+ * Most text is dominated by runs of US-ASCII, whose break classes are fixed: all printable
+ * characters are GraphemeBreak_Any and all letters are LineBreak_AL. The grapheme and line
+ * break algorithms use runEnd() to find such runs, 8 characters at a time where SIMD is
+ * available, and step over them without looking up the properties of every code point.
+ */
+
+#ifdef __SSE2__
+// Returns 0xffff in each 16-bit lane of \a data that is in the range [\a first, \a last].
+static inline __m128i mm_inrange_epu16(__m128i data, char16_t first, char16_t last)
+{
+    const __m128i offset = _mm_sub_epi16(data, _mm_set1_epi16(short(first)));
+    const __m128i excess = _mm_subs_epu16(offset, _mm_set1_epi16(short(last - first)));
+    return _mm_cmpeq_epi16(excess, _mm_setzero_si128());
+}
+#endif
+
+namespace {
+
+struct PrintableAscii
+{
+    static bool matches(char16_t ch) { return ch >= 0x20 && ch < 0x7f; }
+#ifdef __SSE2__
+    static __m128i matches(__m128i data) { return mm_inrange_epu16(data, 0x20, 0x7e); }
+#endif
+};
+
+struct AsciiLetter
+{
+    // folds upper case onto lower case; nothing else lands in [a-z]
+    static bool matches(char16_t ch) { return char16_t((ch | 0x20) - u'a') <= u'z' - u'a'; }
+#ifdef __SSE2__
+    static __m128i matches(__m128i data)
+    { return mm_inrange_epu16(_mm_or_si128(data, _mm_set1_epi16(0x20)), u'a', u'z'); }
+#endif
+};
+
+template <typename Class>
+struct Not
+{
+    static bool matches(char16_t ch) { return !Class::matches(ch); }
+#ifdef __SSE2__
+    static __m128i matches(__m128i data)
+    { return _mm_cmpeq_epi16(Class::matches(data), _mm_setzero_si128()); }
+#endif
+};
+
+} // unnamed namespace
+
+// Returns the index of the first character at or after \a i that doesn't match \a Class.
+template <typename Class>
+static inline qsizetype runEnd(const char16_t *string, qsizetype i, qsizetype len)
+{
+    // most runs are short, so don't bother with SIMD before having seen a few characters
+    for (const qsizetype end = qMin(i + 4, len); i != end; ++i) {
+        if (!Class::matches(string[i]))
+            return i;
+    }
+#ifdef __SSE2__
+    for ( ; i + 8 <= len; i += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(string + i));
+        const uint mask = _mm_movemask_epi8(Class::matches(data));
+        if (mask != 0xffff)
+            return i + qCountTrailingZeroBits(~mask) / 2;
+    }
+#endif
+    while (i != len && Class::matches(string[i]))
+        ++i;
+    return i;
+}
+
 namespace GB {
 
 /*
@@ -102,6 +175,20 @@ static void getGraphemeBreaks(const char16_t *string, qsizetype len, QCharAttrib
     QUnicodeTables::GraphemeBreakClass lcls = QUnicodeTables::GraphemeBreak_LF; // to meet GB1
     GB::State state = GB::Break; // only required to track some of the rules
     for (qsizetype i = 0; i != len; ++i) {
+        if (PrintableAscii::matches(string[i])) {
+            // GB999: printable ASCII characters are all of class Any, so each of them is a
+            // cluster of its own (though the first one may belong to a preceding Prepend)
+            if (GB::breakTable[lcls][QUnicodeTables::GraphemeBreak_Any] == GB::Break)
+                attributes[i].graphemeBoundary = true;
+            const qsizetype asciiEnd = runEnd<PrintableAscii>(string, i + 1, len);
+            for (qsizetype j = i + 1; j != asciiEnd; ++j)
+                attributes[j].graphemeBoundary = true;
+            i = asciiEnd - 1;
+            lcls = QUnicodeTables::GraphemeBreak_Any;
+            state = GB::Break;
+            continue;
+        }
+
         qsizetype pos = i;
         char32_t ucs4 = string[i];
         if (QChar::isHighSurrogate(ucs4) && i + 1 != len) {
@@ -669,6 +756,11 @@ static void getLineBreaks(const char16_t *string, qsizetype len, QCharAttributes
         case LB::IndirectBreak:
             if (lcls == QUnicodeTables::LineBreak_SP)
                 attributes[pos].lineBreak = true;
+            if (AsciiLetter::matches(string[i]) && nelast == LB::NS::XX
+                    && i + 1 != len && AsciiLetter::matches(string[i + 1])) {
+                // LB28: nothing breaks or changes state inside the rest of a run of ASCII letters
+                i = runEnd<AsciiLetter>(string, i + 1, len) - 1;
+            }
             break;
         case LB::CombiningIndirectBreak:
             if (lcls != QUnicodeTables::LineBreak_SP)
@@ -17,6 +17,7 @@ HEADERS +=  \
         text/qlocale_p.h \
         text/qlocale_tools_p.h \
         text/qlocale_data_p.h \
+        text/qmultimatcher_p.h \
         text/qstring.h \
         text/qstringalgorithms.h \
         text/qstringalgorithms_p.h \
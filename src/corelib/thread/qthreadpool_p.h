@@ -57,6 +57,8 @@
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qsemaphore.h"
+#include "QtCore/qthreadpool.h"
 #include "private/qobject_p.h"
 
 QT_REQUIRE_CONFIG(thread);
@@ -180,6 +182,31 @@ public:
     uint stackSize = 0;
 };
 
+namespace QtPrivate {
+
+/*
+    Calls \a function(i) for each i in [0, \a count), on the calling thread and
+    on as many threads of \a pool as are free. Only threads that are free right
+    away are used, so this cannot deadlock when called from the pool itself.
+*/
+template <typename Function>
+void runInParallel(QThreadPool *pool, int count, const Function &function)
+{
+    QAtomicInt next;
+    QSemaphore finished;
+    const auto work = [&] {
+        for (int i = next.fetchAndAddRelaxed(1); i < count; i = next.fetchAndAddRelaxed(1))
+            function(i);
+    };
+    int started = 0;
+    while (started < count - 1 && pool->tryStart([&] { work(); finished.release(); }))
+        ++started;
+    work();
+    finished.acquire(started);
+}
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 
 #endif
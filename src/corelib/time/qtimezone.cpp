@@ -599,6 +599,30 @@ int QTimeZone::offsetFromUtc(const QDateTime &atDateTime) const
     return 0;
 }
 
+/*!
+    \since 6.0
+
+    Writes to each of the first \a count entries of \a offsets the total
+    effective offset, as offsetFromUtc() would return it, at the time given by
+    the corresponding entry of \a msecsSinceEpoch, in milliseconds since the
+    start of 1970 UTC.
+
+    This is considerably faster than calling offsetFromUtc() for each time,
+    in particular when the times are mostly in ascending order, as when they
+    come from a log file.  Adding the offset, in milliseconds, to each time
+    gives the local time it corresponds to.
+
+    \sa offsetFromUtc()
+*/
+void QTimeZone::offsetsFromUtc(const qint64 *msecsSinceEpoch, int *offsets,
+                               qsizetype count) const
+{
+    if (isValid())
+        d->offsetsFromUtc(msecsSinceEpoch, offsets, count);
+    else
+        std::fill_n(offsets, count, 0);
+}
+
 /*!
     Returns the standard time offset at the given \a atDateTime, i.e. the
     number of seconds to add to UTC to obtain the local Standard Time.  This
@@ -122,6 +122,7 @@ public:
     QString abbreviation(const QDateTime &atDateTime) const;
 
     int offsetFromUtc(const QDateTime &atDateTime) const;
+    void offsetsFromUtc(const qint64 *msecsSinceEpoch, int *offsets, qsizetype count) const;
     int standardTimeOffset(const QDateTime &atDateTime) const;
     int daylightTimeOffset(const QDateTime &atDateTime) const;
 
@@ -215,6 +215,13 @@ int QTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
     return standardTimeOffset(atMSecsSinceEpoch) + daylightTimeOffset(atMSecsSinceEpoch);
 }
 
+void QTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                      qsizetype count) const
+{
+    for (qsizetype i = 0; i < count; ++i)
+        offsets[i] = offsetFromUtc(atMSecsSinceEpoch[i]);
+}
+
 int QTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
     Q_UNUSED(atMSecsSinceEpoch);
@@ -892,6 +899,13 @@ QString QUtcTimeZonePrivate::abbreviation(qint64 atMSecsSinceEpoch) const
     return m_abbreviation;
 }
 
+void QUtcTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                         qsizetype count) const
+{
+    Q_UNUSED(atMSecsSinceEpoch);
+    std::fill_n(offsets, count, m_offsetFromUtc);
+}
+
 qint32 QUtcTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
     Q_UNUSED(atMSecsSinceEpoch);
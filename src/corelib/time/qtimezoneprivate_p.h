@@ -112,6 +112,8 @@ public:
     virtual QString abbreviation(qint64 atMSecsSinceEpoch) const;
 
     virtual int offsetFromUtc(qint64 atMSecsSinceEpoch) const;
+    virtual void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                qsizetype count) const;
     virtual int standardTimeOffset(qint64 atMSecsSinceEpoch) const;
     virtual int daylightTimeOffset(qint64 atMSecsSinceEpoch) const;
 
@@ -203,6 +205,8 @@ public:
                         const QLocale &locale) const override;
     QString abbreviation(qint64 atMSecsSinceEpoch) const override;
 
+    void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                        qsizetype count) const override;
     int standardTimeOffset(qint64 atMSecsSinceEpoch) const override;
     int daylightTimeOffset(qint64 atMSecsSinceEpoch) const override;
 
@@ -298,6 +302,19 @@ struct QTzTimeZoneCacheEntry
     QList<QTzTransitionRule> m_tranRules;
     QList<QByteArray> m_abbreviations;
     QByteArray m_posixRule;
+    // The transitions m_posixRule implies up to some decades ahead, computed
+    // once so that times in [m_posixBeginMSecs, m_posixEndMSecs) don't need the
+    // rule to be parsed on every query:
+    QList<QTimeZonePrivate::Data> m_posixTransitions;
+    qint64 m_posixBeginMSecs = 0;
+    qint64 m_posixEndMSecs = 0;
+    // A flat table of all transition times, explicit or from the POSIX rule,
+    // with the offsets that apply from each on; binary-searchable for times in
+    // [m_lookupBeginMSecs, m_lookupEndMSecs):
+    QList<qint64> m_lookupTimes;
+    QList<QTzTransitionRule> m_lookupRules;
+    qint64 m_lookupBeginMSecs = 0;
+    qint64 m_lookupEndMSecs = 0;
 };
 
 class Q_AUTOTEST_EXPORT QTzTimeZonePrivate final : public QTimeZonePrivate
@@ -324,6 +341,8 @@ public:
     QString abbreviation(qint64 atMSecsSinceEpoch) const override;
 
     int offsetFromUtc(qint64 atMSecsSinceEpoch) const override;
+    void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                        qsizetype count) const override;
     int standardTimeOffset(qint64 atMSecsSinceEpoch) const override;
     int daylightTimeOffset(qint64 atMSecsSinceEpoch) const override;
 
@@ -345,13 +364,14 @@ public:
 private:
     void init(const QByteArray &ianaId);
     QList<QTimeZonePrivate::Data> getPosixTransitions(qint64 msNear) const;
+    qsizetype lookupIndex(qint64 atMSecsSinceEpoch) const;
 
     Data dataForTzTransition(QTzTransitionTime tran) const;
 #if QT_CONFIG(icu)
     mutable QSharedDataPointer<QTimeZonePrivate> m_icu;
 #endif
     QTzTimeZoneCacheEntry cached_data;
-    QList<QTzTransitionTime> tranCache() const { return cached_data.m_tranTimes; }
+    const QList<QTzTransitionTime> &tranCache() const { return cached_data.m_tranTimes; }
 };
 #endif // Q_OS_UNIX
 
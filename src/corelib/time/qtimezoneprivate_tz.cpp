@@ -55,6 +55,7 @@
 #include <algorithm>
 #include <errno.h>
 #include <limits.h>
+#include <limits>
 #ifndef Q_OS_INTEGRITY
 #include <sys/param.h> // to use MAXSYMLINKS constant
 #endif
@@ -658,6 +659,83 @@ QTzTimeZonePrivate *QTzTimeZonePrivate::clone() const
     return new QTzTimeZonePrivate(*this);
 }
 
+// The last year for which the transitions of a POSIX rule are precomputed:
+static constexpr int PosixHorizonYear = 2100;
+
+static qint64 utcYearStartMSecs(int year)
+{
+    return QDateTime(QDate(year, 1, 1), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch();
+}
+
+static void buildLookupTable(QTzTimeZoneCacheEntry &entry)
+{
+    const bool hasTransitions = !entry.m_tranTimes.isEmpty();
+    const qint64 lastTranMSecs = hasTransitions ? entry.m_tranTimes.last().atMSecsSinceEpoch : 0;
+
+    /*
+      QTzTimeZonePrivate::getPosixTransitions() computes the rule's transitions
+      for the year before and after the one it's asked about; for any time at
+      least a year after the start of a longer list of them, and a year before
+      its end, the transitions nearest to it are the same in both.  Without any
+      rules for DST, only the name part of the rule matters and the single
+      result depends on the time asked about, unless it's the last transition.
+    */
+    if (!entry.m_posixRule.isEmpty() && (hasTransitions || entry.m_posixRule.contains(','))) {
+        const int firstYear = hasTransitions
+            ? QDateTime::fromMSecsSinceEpoch(lastTranMSecs, Qt::UTC).date().year() - 1
+            : 1969;
+        const int lastYear = qMax(PosixHorizonYear, firstYear + 3);
+        entry.m_posixTransitions = calculatePosixTransitions(entry.m_posixRule, firstYear,
+                                                             lastYear, lastTranMSecs);
+        entry.m_posixBeginMSecs = utcYearStartMSecs(firstYear + 1);
+        entry.m_posixEndMSecs = utcYearStartMSecs(lastYear);
+    }
+
+    // Flatten what QTzTimeZonePrivate::data() would find into one table:
+    const qsizetype size = entry.m_tranTimes.size() + entry.m_posixTransitions.size() + 1;
+    entry.m_lookupTimes.reserve(size);
+    entry.m_lookupRules.reserve(size);
+    for (const QTzTransitionTime &tran : qAsConst(entry.m_tranTimes)) {
+        entry.m_lookupTimes.append(tran.atMSecsSinceEpoch);
+        entry.m_lookupRules.append(entry.m_tranRules.at(tran.ruleIndex));
+    }
+    entry.m_lookupBeginMSecs = std::numeric_limits<qint64>::min();
+    entry.m_lookupEndMSecs = std::numeric_limits<qint64>::max();
+    if (entry.m_posixRule.isEmpty())
+        return;
+
+    const auto ruleFor = [](const QTimeZonePrivate::Data &data) {
+        return QTzTransitionRule{ data.standardTimeOffset, data.daylightTimeOffset, 0 };
+    };
+    if (entry.m_posixTransitions.isEmpty()) {
+        // Just the name part of a rule, so the offsets never change:
+        const auto constant = calculatePosixTransitions(entry.m_posixRule, 1970, 1970, 0);
+        entry.m_lookupTimes.append(0);
+        entry.m_lookupRules.append(ruleFor(constant.first()));
+        return;
+    }
+    auto it = entry.m_posixTransitions.cbegin();
+    if (hasTransitions) {
+        // After the last transition, the most recent one of the rule applies,
+        // even if it came before the last transition:
+        it = std::partition_point(it, entry.m_posixTransitions.cend(),
+                                  [lastTranMSecs](const QTimeZonePrivate::Data &at) {
+                                      return at.atMSecsSinceEpoch <= lastTranMSecs;
+                                  });
+        if (it != entry.m_posixTransitions.cbegin()) {
+            entry.m_lookupTimes.append(lastTranMSecs + 1);
+            entry.m_lookupRules.append(ruleFor(*(it - 1)));
+        }
+    } else {
+        entry.m_lookupBeginMSecs = entry.m_posixBeginMSecs;
+    }
+    for (; it != entry.m_posixTransitions.cend(); ++it) {
+        entry.m_lookupTimes.append(it->atMSecsSinceEpoch);
+        entry.m_lookupRules.append(ruleFor(*it));
+    }
+    entry.m_lookupEndMSecs = entry.m_posixEndMSecs;
+}
+
 class QTzTimeZoneCache
 {
 public:
@@ -691,6 +769,7 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
                     && (begin == zoneInfo.constEnd()
                         || PosixZone::parse(begin, zoneInfo.constEnd()).hasValidOffset())) {
                     ret.m_posixRule = ianaId;
+                    buildLookupTable(ret);
                 }
                 return ret;
             }
@@ -839,6 +918,7 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
         ret.m_tranTimes.append(tran);
     }
 
+    buildLookupTable(ret);
     return ret;
 }
 
@@ -976,19 +1056,79 @@ QString QTzTimeZonePrivate::abbreviation(qint64 atMSecsSinceEpoch) const
     return data(atMSecsSinceEpoch).abbreviation;
 }
 
+// Returns the index in the lookup table of the rule in effect at the given
+// time, or -1 if the table doesn't cover it.
+qsizetype QTzTimeZonePrivate::lookupIndex(qint64 atMSecsSinceEpoch) const
+{
+    const QList<qint64> &times = cached_data.m_lookupTimes;
+    if (times.isEmpty() || atMSecsSinceEpoch < cached_data.m_lookupBeginMSecs
+        || atMSecsSinceEpoch >= cached_data.m_lookupEndMSecs) {
+        return -1;
+    }
+
+    // Branch-free search for the last entry not after atMSecsSinceEpoch, or
+    // the first one if all are after it:
+    const qint64 *base = times.constData();
+    qsizetype length = times.size();
+    while (length > 1) {
+        const qsizetype half = length / 2;
+        base = base[half] <= atMSecsSinceEpoch ? base + half : base;
+        length -= half;
+    }
+    return base - times.constData();
+}
+
 int QTzTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
 {
+    const qsizetype index = lookupIndex(atMSecsSinceEpoch);
+    if (index >= 0) {
+        const QTzTransitionRule &rule = cached_data.m_lookupRules.at(index);
+        return rule.stdOffset + rule.dstOffset;
+    }
     const QTimeZonePrivate::Data tran = data(atMSecsSinceEpoch);
     return tran.offsetFromUtc; // == tran.standardTimeOffset + tran.daylightTimeOffset
 }
 
+void QTzTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                        qsizetype count) const
+{
+    const QList<qint64> &times = cached_data.m_lookupTimes;
+    // Times from logs and the like mostly arrive in order, so most share the
+    // interval between two transitions with their predecessor:
+    qint64 from = 0, to = 0;
+    int offset = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 msecs = atMSecsSinceEpoch[i];
+        if (msecs >= from && msecs < to) {
+            offsets[i] = offset;
+            continue;
+        }
+        const qsizetype index = lookupIndex(msecs);
+        if (index < 0) {
+            offsets[i] = offsetFromUtc(msecs);
+            from = to = 0;
+            continue;
+        }
+        const QTzTransitionRule &rule = cached_data.m_lookupRules.at(index);
+        offset = offsets[i] = rule.stdOffset + rule.dstOffset;
+        from = index > 0 ? times.at(index) : cached_data.m_lookupBeginMSecs;
+        to = index + 1 < times.size() ? times.at(index + 1) : cached_data.m_lookupEndMSecs;
+    }
+}
+
 int QTzTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
+    const qsizetype index = lookupIndex(atMSecsSinceEpoch);
+    if (index >= 0)
+        return cached_data.m_lookupRules.at(index).stdOffset;
     return data(atMSecsSinceEpoch).standardTimeOffset;
 }
 
 int QTzTimeZonePrivate::daylightTimeOffset(qint64 atMSecsSinceEpoch) const
 {
+    const qsizetype index = lookupIndex(atMSecsSinceEpoch);
+    if (index >= 0)
+        return cached_data.m_lookupRules.at(index).dstOffset;
     return data(atMSecsSinceEpoch).daylightTimeOffset;
 }
 
@@ -1021,6 +1161,8 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataForTzTransition(QTzTransitionTime
 
 QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msNear) const
 {
+    if (msNear >= cached_data.m_posixBeginMSecs && msNear < cached_data.m_posixEndMSecs)
+        return cached_data.m_posixTransitions;
     const int year = QDateTime::fromMSecsSinceEpoch(msNear, Qt::UTC).date().year();
     // The Data::atMSecsSinceEpoch of the single entry if zone is constant:
     qint64 atTime = tranCache().isEmpty() ? msNear : tranCache().last().atMSecsSinceEpoch;
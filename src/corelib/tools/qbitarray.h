@@ -67,6 +67,7 @@ public:
     inline qsizetype size() const { return (d.size() << 3) - *d.constData(); }
     inline qsizetype count() const { return (d.size() << 3) - *d.constData(); }
     qsizetype count(bool on) const;
+    qsizetype findNextSetBit(qsizetype from = 0) const;
 
     inline bool isEmpty() const { return d.isEmpty(); }
     inline bool isNull() const { return d.isNull(); }
@@ -39,7 +39,17 @@
 ****************************************************************************/
 
 #include <qcryptographichash.h>
+#include <qbytearraylist.h>
 #include <qiodevice.h>
+#include <private/qsimd_p.h>
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#  if QT_CONFIG(thread)
+#    include <qfiledevice.h>
+#    include <private/qthreadpool_p.h>
+#  endif
+#endif
+
+#include <utility>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -138,6 +148,125 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+/*
+    BLAKE2bp and BLAKE2sp hash the message with four BLAKE2b or eight BLAKE2s
+    instances (the leaves), each of which gets every fourth or eighth block of
+    the message, and then hash the leaves' results with a root instance. The
+    leaves are independent of each other, so they can be updated in parallel.
+
+    The parameter blocks are filled in byte by byte, since the layout of the
+    parameter structs differs between the bundled sources and libb2.
+*/
+namespace {
+struct Blake2bTreeTraits
+{
+    using State = blake2b_state;
+    using Param = blake2b_param;
+    enum { Leaves = 4, BlockBytes = BLAKE2B_BLOCKBYTES, OutBytes = BLAKE2B_OUTBYTES, NodeDepthIndex = 16 };
+    static void init(State *state, const Param *param) { blake2b_init_param(state, param); }
+    static void update(State *state, const uchar *data, size_t length) { blake2b_update(state, data, length); }
+    static void finalize(State *state, uchar *out) { blake2b_final(state, out, OutBytes); }
+};
+
+struct Blake2sTreeTraits
+{
+    using State = blake2s_state;
+    using Param = blake2s_param;
+    enum { Leaves = 8, BlockBytes = BLAKE2S_BLOCKBYTES, OutBytes = BLAKE2S_OUTBYTES, NodeDepthIndex = 14 };
+    static void init(State *state, const Param *param) { blake2s_init_param(state, param); }
+    static void update(State *state, const uchar *data, size_t length) { blake2s_update(state, data, length); }
+    static void finalize(State *state, uchar *out) { blake2s_final(state, out, OutBytes); }
+};
+
+template <typename Traits>
+struct Blake2TreeState
+{
+    enum { Stride = Traits::Leaves * Traits::BlockBytes, OutBytes = Traits::OutBytes };
+
+    typename Traits::State leaf[Traits::Leaves];
+    typename Traits::State root;
+    uchar buffer[Stride];
+    size_t bufferLength;
+
+    void init()
+    {
+        uchar param[sizeof(typename Traits::Param)] = {};
+        param[0] = Traits::OutBytes;            // digest length
+        param[2] = Traits::Leaves;              // fanout
+        param[3] = 2;                           // depth
+        param[Traits::NodeDepthIndex + 1] = Traits::OutBytes; // inner length
+        typename Traits::Param p;
+        for (int i = 0; i < Traits::Leaves; ++i) {
+            param[8] = uchar(i);                // node offset
+            memcpy(&p, param, sizeof(p));
+            Traits::init(&leaf[i], &p);
+        }
+        param[8] = 0;
+        param[Traits::NodeDepthIndex] = 1;
+        memcpy(&p, param, sizeof(p));
+        Traits::init(&root, &p);
+        leaf[Traits::Leaves - 1].last_node = 1;
+        root.last_node = 1;
+        bufferLength = 0;
+    }
+
+    // forEachLeaf(count, function) calls function(i) for each i in [0, count)
+    template <typename ForEachLeaf>
+    void update(const uchar *data, size_t length, ForEachLeaf forEachLeaf)
+    {
+        size_t left = bufferLength;
+        if (left && length >= Stride - left) {
+            const size_t fill = Stride - left;
+            memcpy(buffer + left, data, fill);
+            for (int i = 0; i < Traits::Leaves; ++i)
+                Traits::update(&leaf[i], buffer + i * Traits::BlockBytes, Traits::BlockBytes);
+            data += fill;
+            length -= fill;
+            left = 0;
+        }
+        if (const size_t bulk = length - length % Stride) {
+            forEachLeaf(int(Traits::Leaves), [this, data, bulk](int i) {
+                for (size_t offset = i * Traits::BlockBytes; offset < bulk; offset += Stride)
+                    Traits::update(&leaf[i], data + offset, Traits::BlockBytes);
+            });
+            data += bulk;
+            length -= bulk;
+        }
+        memcpy(buffer + left, data, length);
+        bufferLength = left + length;
+    }
+
+    void update(const uchar *data, size_t length)
+    {
+        update(data, length, [](int count, const auto &function) {
+            for (int i = 0; i < count; ++i)
+                function(i);
+        });
+    }
+
+    void finalize(uchar *out)
+    {
+        uchar hash[Traits::Leaves][Traits::OutBytes];
+        for (int i = 0; i < Traits::Leaves; ++i) {
+            const size_t offset = i * Traits::BlockBytes;
+            if (bufferLength > offset) {
+                Traits::update(&leaf[i], buffer + offset,
+                               qMin(bufferLength - offset, size_t(Traits::BlockBytes)));
+            }
+            Traits::finalize(&leaf[i], hash[i]);
+        }
+        for (int i = 0; i < Traits::Leaves; ++i)
+            Traits::update(&root, hash[i], Traits::OutBytes);
+        Traits::finalize(&root, out);
+    }
+};
+
+using Blake2bpState = Blake2TreeState<Blake2bTreeTraits>;
+using Blake2spState = Blake2TreeState<Blake2sTreeTraits>;
+} // unnamed namespace
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 class QCryptographicHashPrivate
 {
 public:
@@ -154,6 +283,8 @@ public:
         SHA3Context sha3Context;
         blake2b_state blake2bContext;
         blake2s_state blake2sContext;
+        Blake2bpState blake2bpContext;
+        Blake2spState blake2spContext;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -167,6 +298,375 @@ public:
     QByteArray result;
 };
 
+#if !defined(QT_BOOTSTRAPPED) && QT_COMPILER_SUPPORTS_HERE(SHA)
+#  define QCRYPTOGRAPHICHASH_SHA_NI
+#endif
+#if !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) \
+    && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define QCRYPTOGRAPHICHASH_AVX2
+#endif
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) \
+    && (defined(QCRYPTOGRAPHICHASH_SHA_NI) || defined(QCRYPTOGRAPHICHASH_AVX2))
+alignas(32) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#ifdef QCRYPTOGRAPHICHASH_SHA_NI
+/*
+    SHA-1 and SHA-256 using the SHA extensions of x86 processors. Both process
+    the message in groups of four rounds; group G uses the four message words
+    in msg[G % 4] and computes (part of) the message schedule for the groups
+    that follow.
+*/
+template <int G>
+QT_FUNCTION_TARGET(SHA)
+static inline void sha1RoundGroup(__m128i &abcd, __m128i (&e)[2], __m128i (&msg)[4])
+{
+    __m128i &current = msg[G % 4];
+    __m128i &in = e[G % 2];
+    __m128i &out = e[(G + 1) % 2];
+    if constexpr (G == 0)
+        in = _mm_add_epi32(in, current);
+    else
+        in = _mm_sha1nexte_epu32(in, current);
+    out = abcd;
+    if constexpr (G >= 3 && G <= 18)
+        msg[(G + 1) % 4] = _mm_sha1msg2_epu32(msg[(G + 1) % 4], current);
+    abcd = _mm_sha1rnds4_epu32(abcd, in, G / 5);
+    if constexpr (G >= 1 && G <= 16)
+        msg[(G + 3) % 4] = _mm_sha1msg1_epu32(msg[(G + 3) % 4], current);
+    if constexpr (G >= 2 && G <= 17)
+        msg[(G + 2) % 4] = _mm_xor_si128(msg[(G + 2) % 4], current);
+}
+
+template <int... G>
+QT_FUNCTION_TARGET(SHA)
+static inline void sha1RoundGroups(__m128i &abcd, __m128i (&e)[2], __m128i (&msg)[4],
+                                   const uchar *data, std::integer_sequence<int, G...>)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    for (int i = 0; i < 4; ++i)
+        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i), byteSwap);
+    (sha1RoundGroup<G>(abcd, e, msg), ...);
+}
+
+QT_FUNCTION_TARGET(SHA)
+static void sha1ProcessBlocksShaNi(Sha1State *state, const uchar *data, size_t blocks)
+{
+    __m128i abcd = _mm_set_epi32(state->h0, state->h1, state->h2, state->h3);
+    __m128i e[2] = { _mm_set_epi32(state->h4, 0, 0, 0), _mm_setzero_si128() };
+    __m128i msg[4];
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e[0];
+        sha1RoundGroups(abcd, e, msg, data, std::make_integer_sequence<int, 20>());
+        e[0] = _mm_sha1nexte_epu32(e[0], eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    state->h0 = _mm_extract_epi32(abcd, 3);
+    state->h1 = _mm_extract_epi32(abcd, 2);
+    state->h2 = _mm_extract_epi32(abcd, 1);
+    state->h3 = _mm_extract_epi32(abcd, 0);
+    state->h4 = _mm_extract_epi32(e[0], 3);
+}
+
+// Same as sha1Update(), but processes whole blocks with the SHA extensions
+static void sha1UpdateShaNi(Sha1State *state, const uchar *data, size_t len)
+{
+    const size_t rest = state->messageSize & 63;
+    state->messageSize += len;
+    if (rest) {
+        const size_t n = qMin(64 - rest, len);
+        memcpy(state->buffer + rest, data, n);
+        if (rest + n < 64)
+            return;
+        sha1ProcessBlocksShaNi(state, state->buffer, 1);
+        data += n;
+        len -= n;
+    }
+    if (const size_t blocks = len / 64) {
+        sha1ProcessBlocksShaNi(state, data, blocks);
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+    memcpy(state->buffer, data, len);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+template <int G>
+QT_FUNCTION_TARGET(SHA)
+static inline void sha256RoundGroup(__m128i &abef, __m128i &cdgh, __m128i (&msg)[4])
+{
+    __m128i &current = msg[G % 4];
+    __m128i k = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants) + G));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, k);
+    if constexpr (G >= 3 && G <= 14) {
+        __m128i &next = msg[(G + 1) % 4];
+        next = _mm_add_epi32(next, _mm_alignr_epi8(current, msg[(G + 3) % 4], 4));
+        next = _mm_sha256msg2_epu32(next, current);
+    }
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(k, 0x0e));
+    if constexpr (G >= 1 && G <= 12)
+        msg[(G + 3) % 4] = _mm_sha256msg1_epu32(msg[(G + 3) % 4], current);
+}
+
+template <int... G>
+QT_FUNCTION_TARGET(SHA)
+static inline void sha256RoundGroups(__m128i &abef, __m128i &cdgh, __m128i (&msg)[4],
+                                     const uchar *data, std::integer_sequence<int, G...>)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    for (int i = 0; i < 4; ++i)
+        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i), byteSwap);
+    (sha256RoundGroup<G>(abef, cdgh, msg), ...);
+}
+
+QT_FUNCTION_TARGET(SHA)
+static void sha256ProcessBlocksShaNi(uint32_t *hash, const uchar *data, size_t blocks)
+{
+    // the instructions want the state as ABEF and CDGH
+    __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hash));
+    __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hash + 4));
+    __m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+    __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+    __m128i msg[4];
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        sha256RoundGroups(abef, cdgh, msg, data, std::make_integer_sequence<int, 16>());
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+// Same as SHA224Input() and SHA256Input(), which otherwise process the message byte by byte
+static void sha256InputShaNi(SHA256Context *context, const uchar *data, size_t len)
+{
+    const quint64 bitCount = ((quint64(context->Length_High) << 32) | context->Length_Low)
+            + quint64(len) * 8;
+    context->Length_High = uint32_t(bitCount >> 32);
+    context->Length_Low = uint32_t(bitCount);
+
+    const size_t rest = context->Message_Block_Index;
+    if (rest) {
+        const size_t n = qMin(SHA256_Message_Block_Size - rest, len);
+        memcpy(context->Message_Block + rest, data, n);
+        if (rest + n < SHA256_Message_Block_Size) {
+            context->Message_Block_Index = int_least16_t(rest + n);
+            return;
+        }
+        sha256ProcessBlocksShaNi(context->Intermediate_Hash, context->Message_Block, 1);
+        data += n;
+        len -= n;
+    }
+    if (const size_t blocks = len / SHA256_Message_Block_Size) {
+        sha256ProcessBlocksShaNi(context->Intermediate_Hash, data, blocks);
+        data += blocks * SHA256_Message_Block_Size;
+        len -= blocks * SHA256_Message_Block_Size;
+    }
+    memcpy(context->Message_Block, data, len);
+    context->Message_Block_Index = int_least16_t(len);
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#endif // QCRYPTOGRAPHICHASH_SHA_NI
+
+#ifdef QCRYPTOGRAPHICHASH_AVX2
+/*
+    SHA-224 and SHA-256 of eight independent messages at once, one message per
+    32-bit lane of the AVX2 registers. This is what QCryptographicHash::hashMany()
+    uses on processors without the SHA extensions.
+*/
+namespace {
+struct Sha256Lanes
+{
+    enum { Count = 8 };
+    alignas(32) quint32 state[8][Count]; // state[word][lane]
+};
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i sha256Rotr(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Loads eight consecutive words of each lane's block, in lane order
+QT_FUNCTION_TARGET(AVX2)
+static inline void sha256LoadTransposed(__m256i *w, const uchar *const *blocks, int offset)
+{
+    const __m256i byteSwap = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                               0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m256i r[8];
+    for (int i = 0; i < 8; ++i)
+        r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[i] + offset));
+
+    // 8x8 transpose of 32-bit elements
+    __m256i t[8];
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        w[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x20), byteSwap);
+        w[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x31), byteSwap);
+    }
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static void sha256ProcessBlock8Lanes(Sha256Lanes *lanes, const uchar *const *blocks)
+{
+    __m256i w[16];
+    sha256LoadTransposed(w, blocks, 0);
+    sha256LoadTransposed(w + 8, blocks, 32);
+
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i)
+        v[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes->state[i]));
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            const __m256i w2 = w[(t - 2) & 15];
+            const __m256i w15 = w[(t - 15) & 15];
+            const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(w2, 17), sha256Rotr(w2, 19)),
+                                                _mm256_srli_epi32(w2, 10));
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(w15, 7), sha256Rotr(w15, 18)),
+                                                _mm256_srli_epi32(w15, 3));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                         _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+        const __m256i bigSigma1 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(e, 6), sha256Rotr(e, 11)),
+                                                   sha256Rotr(e, 25));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i k = _mm256_set1_epi32(int(sha256RoundConstants[t]));
+        const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigSigma1),
+                                            _mm256_add_epi32(_mm256_add_epi32(ch, k), w[t & 15]));
+        const __m256i bigSigma0 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(a, 2), sha256Rotr(a, 13)),
+                                                   sha256Rotr(a, 22));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(bigSigma0, maj));
+    }
+
+    const __m256i result[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes->state[i]),
+                           _mm256_add_epi32(v[i], result[i]));
+    }
+}
+
+static void sha256HashMany8Lanes(const QByteArrayList &data, QCryptographicHash::Algorithm method,
+                                 QByteArrayList &result)
+{
+    static const quint32 sha224InitialHash[8] = {
+        0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+    };
+    static const quint32 sha256InitialHash[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    static const uchar idleBlock[SHA256_Message_Block_Size] = {};
+    const quint32 *initialHash = method == QCryptographicHash::Sha224 ? sha224InitialHash
+                                                                      : sha256InitialHash;
+    const int hashLength = QCryptographicHash::hashLength(method);
+
+    struct Lane {
+        qsizetype message = -1;
+        const uchar *data;
+        qsizetype fullBlocks;
+        qsizetype block;
+        int totalBlocks;
+        uchar tail[2 * SHA256_Message_Block_Size];
+    };
+    Lane lane[Sha256Lanes::Count];
+    Sha256Lanes lanes;
+    const uchar *blocks[Sha256Lanes::Count];
+
+    for (int i = 0; i < data.size(); ++i)
+        result.append(QByteArray(hashLength, Qt::Uninitialized));
+
+    qsizetype nextMessage = 0;
+    forever {
+        int active = 0;
+        for (int i = 0; i < Sha256Lanes::Count; ++i) {
+            Lane &l = lane[i];
+            if (l.message < 0 && nextMessage < data.size()) {
+                // start hashing the next message in this lane; the last one
+                // or two blocks (with the padding) come from the tail buffer
+                const QByteArray &message = data.at(nextMessage);
+                const qsizetype size = message.size();
+                const qsizetype rest = size % SHA256_Message_Block_Size;
+                l.message = nextMessage++;
+                l.data = reinterpret_cast<const uchar *>(message.constData());
+                l.fullBlocks = size / SHA256_Message_Block_Size;
+                l.block = 0;
+                const int tailBlocks = rest + 9 <= SHA256_Message_Block_Size ? 1 : 2;
+                l.totalBlocks = tailBlocks;
+                memcpy(l.tail, l.data + l.fullBlocks * SHA256_Message_Block_Size, rest);
+                l.tail[rest] = 0x80;
+                memset(l.tail + rest + 1, 0, tailBlocks * SHA256_Message_Block_Size - rest - 9);
+                qToBigEndian(quint64(size) * 8, l.tail + tailBlocks * SHA256_Message_Block_Size - 8);
+                for (int w = 0; w < 8; ++w)
+                    lanes.state[w][i] = initialHash[w];
+            }
+            if (l.message < 0) {
+                blocks[i] = idleBlock;
+                continue;
+            }
+            ++active;
+            blocks[i] = l.block < l.fullBlocks
+                    ? l.data + l.block * SHA256_Message_Block_Size
+                    : l.tail + (l.block - l.fullBlocks) * SHA256_Message_Block_Size;
+        }
+        if (!active)
+            break;
+
+        sha256ProcessBlock8Lanes(&lanes, blocks);
+
+        for (int i = 0; i < Sha256Lanes::Count; ++i) {
+            Lane &l = lane[i];
+            if (l.message < 0 || ++l.block < l.fullBlocks + l.totalBlocks)
+                continue;
+            uchar digest[SHA256HashSize];
+            for (int w = 0; w < 8; ++w)
+                qToBigEndian(lanes.state[w][i], digest + 4 * w);
+            memcpy(result[l.message].data(), digest, hashLength);
+            l.message = -1;
+        }
+    }
+}
+#endif // QCRYPTOGRAPHICHASH_AVX2
+
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
 void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant)
 {
@@ -257,6 +757,10 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Blake2s_160 Generate a BLAKE2s-160 hash sum. Introduced in Qt 6.0
   \value Blake2s_224 Generate a BLAKE2s-224 hash sum. Introduced in Qt 6.0
   \value Blake2s_256 Generate a BLAKE2s-256 hash sum. Introduced in Qt 6.0
+  \value Blake2bp_512 Generate a BLAKE2bp-512 hash sum, the 4-way parallel
+         variant of BLAKE2b-512. Introduced in Qt 6.0
+  \value Blake2sp_256 Generate a BLAKE2sp-256 hash sum, the 8-way parallel
+         variant of BLAKE2s-256. Introduced in Qt 6.0
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
@@ -346,6 +850,14 @@ void QCryptographicHash::reset()
         new (&d->blake2sContext) blake2s_state;
         blake2s_init(&d->blake2sContext, hashLength(d->method));
         break;
+    case Blake2bp_512:
+        new (&d->blake2bpContext) Blake2bpState;
+        d->blake2bpContext.init();
+        break;
+    case Blake2sp_256:
+        new (&d->blake2spContext) Blake2spState;
+        d->blake2spContext.init();
+        break;
 #endif
     }
     d->result.clear();
@@ -372,6 +884,12 @@ void QCryptographicHash::addData(const char *data, qsizetype length)
 #endif
         switch (d->method) {
         case Sha1:
+#ifdef QCRYPTOGRAPHICHASH_SHA_NI
+            if (qCpuHasFeature(SHA)) {
+                sha1UpdateShaNi(&d->sha1Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             sha1Update(&d->sha1Context, (const unsigned char *)data, length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -387,9 +905,21 @@ void QCryptographicHash::addData(const char *data, qsizetype length)
             MD5Update(&d->md5Context, (const unsigned char *)data, length);
             break;
         case Sha224:
+#ifdef QCRYPTOGRAPHICHASH_SHA_NI
+            if (qCpuHasFeature(SHA)) {
+                sha256InputShaNi(&d->sha224Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA224Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case Sha256:
+#ifdef QCRYPTOGRAPHICHASH_SHA_NI
+            if (qCpuHasFeature(SHA)) {
+                sha256InputShaNi(&d->sha256Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case Sha384:
@@ -426,6 +956,12 @@ void QCryptographicHash::addData(const char *data, qsizetype length)
         case Blake2s_256:
             blake2s_update(&d->blake2sContext, reinterpret_cast<const uint8_t *>(data), length);
             break;
+        case Blake2bp_512:
+            d->blake2bpContext.update(reinterpret_cast<const uchar *>(data), length);
+            break;
+        case Blake2sp_256:
+            d->blake2spContext.update(reinterpret_cast<const uchar *>(data), length);
+            break;
 #endif
         }
     }
@@ -575,6 +1111,18 @@ QByteArray QCryptographicHash::result() const
         blake2s_final(&copy, reinterpret_cast<uint8_t *>(d->result.data()), length);
         break;
     }
+    case Blake2bp_512: {
+        Blake2bpState copy = d->blake2bpContext;
+        d->result.resize(hashLength(d->method));
+        copy.finalize(reinterpret_cast<uchar *>(d->result.data()));
+        break;
+    }
+    case Blake2sp_256: {
+        Blake2spState copy = d->blake2spContext;
+        d->result.resize(hashLength(d->method));
+        copy.finalize(reinterpret_cast<uchar *>(d->result.data()));
+        break;
+    }
 #endif
     }
     return d->result;
@@ -590,6 +1138,221 @@ QByteArray QCryptographicHash::hash(const QByteArray &data, Algorithm method)
     return hash.result();
 }
 
+/*!
+  Returns the hashes of each of the byte arrays in \a data using \a method,
+  in the same order.
+
+  This gives the same result as calling hash() for each element, but can be
+  considerably faster for large numbers of short messages: where the
+  processor supports it, several messages are hashed in parallel.
+
+  \since 6.0
+  \sa hash()
+*/
+QByteArrayList QCryptographicHash::hashMany(const QByteArrayList &data, Algorithm method)
+{
+    QByteArrayList result;
+    result.reserve(data.size());
+
+#ifdef QCRYPTOGRAPHICHASH_AVX2
+    // with the SHA extensions, hashing one message at a time is faster
+    if ((method == Sha224 || method == Sha256) && qCpuHasFeature(AVX2)
+#  ifdef QCRYPTOGRAPHICHASH_SHA_NI
+            && !qCpuHasFeature(SHA)
+#  endif
+            ) {
+        sha256HashMany8Lanes(data, method, result);
+        return result;
+    }
+#endif
+
+    QCryptographicHash hash(method);
+    for (const QByteArray &message : data) {
+        hash.reset();
+        hash.addData(message);
+        result.append(hash.result());
+    }
+    return result;
+}
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) && QT_CONFIG(thread)
+/*
+    Passes the rest of \a device to \a consume(data, length). Files that can be
+    mapped are passed in one piece; everything else is read in pieces of
+    \a pieceSize bytes (only the last one may be shorter). Returns false if
+    the device could not be read to the end.
+*/
+template <typename Consumer>
+static bool consumeDevice(QIODevice *device, qint64 pieceSize, const Consumer &consume)
+{
+    if (!device->isOpen() || !device->isReadable())
+        return false;
+
+    if (auto file = qobject_cast<QFileDevice *>(device); file && !file->isSequential()) {
+        const qint64 offset = file->pos();
+        const qint64 size = file->size() - offset;
+        if (size <= 0)
+            return true;
+        if (uchar *data = file->map(offset, size)) {
+            consume(data, size);
+            file->unmap(data);
+            return file->seek(offset + size);
+        }
+    }
+
+    QByteArray buffer(pieceSize, Qt::Uninitialized);
+    forever {
+        qint64 length = 0;
+        while (length < pieceSize) {
+            const qint64 read = device->read(buffer.data() + length, pieceSize - length);
+            if (read < 0)
+                return false;
+            if (read == 0)
+                break;
+            length += read;
+        }
+        if (length)
+            consume(reinterpret_cast<const uchar *>(buffer.constData()), length);
+        if (length < pieceSize)
+            return device->atEnd();
+    }
+}
+
+template <typename State>
+static QByteArray blake2TreeHashParallel(QIODevice *device, QThreadPool *pool)
+{
+    State state;
+    state.init();
+    const auto forEachLeaf = [pool](int count, const auto &function) {
+        QtPrivate::runInParallel(pool, count, function);
+    };
+    if (!consumeDevice(device, 16 * State::Stride * 1024, [&](const uchar *data, qint64 length) {
+            state.update(data, size_t(length), forEachLeaf);
+        })) {
+        return QByteArray();
+    }
+    QByteArray result(State::OutBytes, Qt::Uninitialized);
+    state.finalize(reinterpret_cast<uchar *>(result.data()));
+    return result;
+}
+
+static QByteArray merkleTreeRoot(const QByteArray *nodes, qsizetype count,
+                                 QCryptographicHash::Algorithm method)
+{
+    if (count == 1)
+        return nodes[0];
+
+    // the left subtree is the largest complete tree with fewer than count leaves
+    qsizetype split = 1;
+    while (split * 2 < count)
+        split *= 2;
+    QCryptographicHash hash(method);
+    hash.addData("\1", 1);
+    hash.addData(merkleTreeRoot(nodes, split, method));
+    hash.addData(merkleTreeRoot(nodes + split, count - split, method));
+    return hash.result();
+}
+
+/*!
+  Returns the hash of the data read from \a device using \a method, hashing
+  on several threads of \a pool where the algorithm allows it. If \a pool is
+  \nullptr, QThreadPool::globalInstance() is used.
+
+  Only Blake2bp_512 and Blake2sp_256 can be computed in parallel, by four
+  and eight threads respectively; other algorithms are computed on the
+  calling thread. The result is the same as hashing the data with
+  addData().
+
+  If \a device is a file that can be mapped into memory, it is hashed
+  directly from the mapping. The device is left at its end. Returns an
+  empty byte array if \a device could not be read.
+
+  \since 6.0
+  \sa merkleTreeHash(), QFileDevice::map()
+*/
+QByteArray QCryptographicHash::hashParallel(QIODevice *device, Algorithm method, QThreadPool *pool)
+{
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    switch (method) {
+    case Blake2bp_512:
+        return blake2TreeHashParallel<Blake2bpState>(device, pool);
+    case Blake2sp_256:
+        return blake2TreeHashParallel<Blake2spState>(device, pool);
+    default:
+        break;
+    }
+
+    QCryptographicHash hash(method);
+    if (!consumeDevice(device, 1024 * 1024, [&hash](const uchar *data, qint64 length) {
+            hash.addData(reinterpret_cast<const char *>(data), length);
+        })) {
+        return QByteArray();
+    }
+    return hash.result();
+}
+
+/*!
+  Returns the root of a Merkle tree over the data read from \a device, using
+  \a method. The data is split into chunks of \a chunkSize bytes, which are
+  hashed in parallel on the calling thread and the threads of \a pool. If
+  \a pool is \nullptr, QThreadPool::globalInstance() is used.
+
+  The tree is the one of RFC 6962: each chunk is hashed prefixed by a zero
+  byte, each inner node is the hash of a one byte followed by the hashes of
+  its left and right subtree, and the left subtree of a node with \e n
+  leaves has the largest power of two below \e n leaves. Empty input gives
+  the hash of no data.
+
+  If \a device is a file that can be mapped into memory, it is hashed
+  directly from the mapping. The device is left at its end. Returns an
+  empty byte array if \a device could not be read.
+
+  \since 6.0
+  \sa hashParallel()
+*/
+QByteArray QCryptographicHash::merkleTreeHash(QIODevice *device, Algorithm method,
+                                              qint64 chunkSize, QThreadPool *pool)
+{
+    if (chunkSize <= 0) {
+        qWarning("QCryptographicHash::merkleTreeHash: chunkSize must be positive");
+        return QByteArray();
+    }
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    // read enough to keep all threads busy when the device cannot be mapped
+    const qint64 chunksPerPiece = qMax(1, pool->maxThreadCount() + 1);
+    const qint64 pieceSize = chunkSize > std::numeric_limits<qint64>::max() / chunksPerPiece
+            ? chunkSize : chunkSize * chunksPerPiece;
+
+    QByteArrayList leaves;
+    const bool ok = consumeDevice(device, pieceSize, [&](const uchar *data, qint64 length) {
+        const qint64 chunks = (length - 1) / chunkSize + 1;
+        for (qint64 first = 0; first < chunks; first += 65536) {
+            const int count = int(qMin(chunks - first, qint64(65536)));
+            const qsizetype leafOffset = leaves.size();
+            leaves.resize(leafOffset + count);
+            QByteArray *out = leaves.data() + leafOffset;
+            QtPrivate::runInParallel(pool, count, [&](int i) {
+                const qint64 offset = (first + i) * chunkSize;
+                QCryptographicHash hash(method);
+                hash.addData("\0", 1);
+                hash.addData(reinterpret_cast<const char *>(data + offset),
+                             qMin(chunkSize, length - offset));
+                out[i] = hash.result();
+            });
+        }
+    });
+    if (!ok)
+        return QByteArray();
+    if (leaves.isEmpty())
+        return hash(QByteArray(), method);
+    return merkleTreeRoot(leaves.constData(), leaves.size(), method);
+}
+#endif // !QT_CRYPTOGRAPHICHASH_ONLY_SHA1 && QT_CONFIG(thread)
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -626,6 +1389,7 @@ int QCryptographicHash::hashLength(QCryptographicHash::Algorithm method)
     case QCryptographicHash::Keccak_256:
     case QCryptographicHash::Blake2b_256:
     case QCryptographicHash::Blake2s_256:
+    case QCryptographicHash::Blake2sp_256:
         return 256 / 8;
     case QCryptographicHash::RealSha3_384:
     case QCryptographicHash::Keccak_384:
@@ -634,6 +1398,7 @@ int QCryptographicHash::hashLength(QCryptographicHash::Algorithm method)
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
     case QCryptographicHash::Blake2b_512:
+    case QCryptographicHash::Blake2bp_512:
         return 512 / 8;
 #endif
     }
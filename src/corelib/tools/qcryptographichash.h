@@ -49,6 +49,7 @@ QT_BEGIN_NAMESPACE
 
 class QCryptographicHashPrivate;
 class QIODevice;
+class QThreadPool;
 
 class Q_CORE_EXPORT QCryptographicHash
 {
@@ -94,6 +95,8 @@ public:
         Blake2s_160,
         Blake2s_224,
         Blake2s_256,
+        Blake2bp_512,
+        Blake2sp_256,
 #endif
     };
     Q_ENUM(Algorithm)
@@ -110,6 +113,12 @@ public:
     QByteArray result() const;
 
     static QByteArray hash(const QByteArray &data, Algorithm method);
+    static QByteArrayList hashMany(const QByteArrayList &data, Algorithm method);
+#if QT_CONFIG(thread)
+    static QByteArray hashParallel(QIODevice *device, Algorithm method, QThreadPool *pool = nullptr);
+    static QByteArray merkleTreeHash(QIODevice *device, Algorithm method,
+                                     qint64 chunkSize = 1024 * 1024, QThreadPool *pool = nullptr);
+#endif
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
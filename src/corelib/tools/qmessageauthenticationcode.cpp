@@ -86,11 +86,13 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::Blake2b_256:
     case QCryptographicHash::Blake2b_384:
     case QCryptographicHash::Blake2b_512:
+    case QCryptographicHash::Blake2bp_512:
         return BLAKE2B_BLOCKBYTES;
     case QCryptographicHash::Blake2s_128:
     case QCryptographicHash::Blake2s_160:
     case QCryptographicHash::Blake2s_224:
     case QCryptographicHash::Blake2s_256:
+    case QCryptographicHash::Blake2sp_256:
         return BLAKE2S_BLOCKBYTES;
     }
     return 0;
@@ -466,8 +466,10 @@
 
 #include "qabstractsocket.h"
 #include "qabstractsocket_p.h"
+#include "qtcpsocket.h"
 
 #include "private/qhostinfo_p.h"
+#include "private/qnativesocketengine_p.h"
 
 #include <qabstracteventdispatcher.h>
 #include <qhostaddress.h>
@@ -847,8 +849,26 @@ bool QAbstractSocketPrivate::writeToSocket()
     qint64 nextSize = writeBuffer.nextDataBlockSize();
     const char *ptr = writeBuffer.readPointer();
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    qint64 written;
+    QNativeSocketEngine *nativeEngine = nullptr;
+    if (nextSize < writeBuffer.size() && socketType == QAbstractSocket::TcpSocket
+        && (nativeEngine = qobject_cast<QNativeSocketEngine *>(socketEngine))) {
+        // The buffer holds several chunks, e.g. byte arrays shared by
+        // consecutive write() calls. Hand them to the kernel in one go
+        // instead of one system call per chunk.
+        const int MaxGatheredChunks = 16;
+        QVarLengthArray<QByteArrayView, MaxGatheredChunks> blocks;
+        for (qint64 pos = 0; pos < writeBuffer.size() && blocks.size() < MaxGatheredChunks; ) {
+            qint64 length;
+            const char *block = writeBuffer.readPointerAtPosition(pos, length);
+            blocks.append(QByteArrayView(block, length));
+            pos += length;
+        }
+        written = nativeEngine->writeVectored(blocks.constData(), blocks.size());
+    } else {
+        // Attempt to write it all in one chunk.
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -897,6 +917,32 @@ bool QAbstractSocketPrivate::flush()
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Lets QFileDevice::transferTo() send file data straight to a connected
+    TCP socket, if the caller asks for it. Subclasses such as QSslSocket
+    transform the data in writeData(), so this is only done for plain
+    sockets, and only once the write buffer has been drained completely.
+    Subclasses without Q_OBJECT cannot be told apart here, which is why
+    the caller has to opt in.
+*/
+qintptr QAbstractSocketPrivate::nativeWriteDescriptor()
+{
+    Q_Q(QAbstractSocket);
+    if (socketType != QAbstractSocket::TcpSocket || state != QAbstractSocket::ConnectedState
+        || !qobject_cast<QNativeSocketEngine *>(socketEngine)) {
+        return -1;
+    }
+    const QMetaObject *mo = q->metaObject();
+    if (mo != &QTcpSocket::staticMetaObject && mo != &QAbstractSocket::staticMetaObject)
+        return -1;
+
+    flush();
+    if (!allWriteBuffersEmpty())
+        return -1;
+    return socketEngine->socketDescriptor();
+}
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
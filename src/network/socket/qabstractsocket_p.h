@@ -131,6 +131,8 @@ public:
     void resetSocketLayer();
     virtual bool flush();
 
+    qintptr nativeWriteDescriptor() override;
+
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
     virtual void configureCreatedSocket();
     void startConnectingByName(const QString &host);
@@ -146,6 +146,89 @@ QT_BEGIN_NAMESPACE
     \sa setSocketDescriptor()
 */
 
+/*!
+    \fn qint64 QLocalSocket::writeDescriptors(const QByteArray &data, const QList<qintptr> &descriptors)
+    \since 6.0
+
+    Writes \a data to the socket like write(), and passes the file
+    descriptors in \a descriptors to the peer along with it. The peer
+    receives duplicates of the descriptors, which refer to the same open
+    files, pipes, sockets or shared memory objects; the descriptors remain
+    open in this process. This allows handing over large payloads, such as
+    memory-mapped files, without copying them through the socket.
+
+    Descriptors travel with the first byte of \a data, so \a data must not
+    be empty. Any data written earlier is flushed before they are sent,
+    which may block for up to 30 seconds if the peer is not reading. At most
+    253 descriptors can be passed in one call.
+
+    The peer only keeps the descriptors if it has enabled receiving them
+    with setDescriptorReceivingEnabled(); otherwise they are closed on its
+    side.
+
+    Returns the number of bytes written, or -1 if an error occurred, in
+    which case no descriptors were sent.
+
+    Passing descriptors is only supported by the Unix domain socket
+    implementation; on other platforms this function fails with
+    UnsupportedSocketOperationError.
+
+    \sa readDescriptors()
+*/
+
+/*!
+    \fn QList<qintptr> QLocalSocket::readDescriptors()
+    \since 6.0
+
+    Returns the file descriptors the peer passed with writeDescriptors()
+    that have been received so far, in the order they were sent, and
+    removes them from the socket. The caller takes ownership of the
+    returned descriptors and must close them.
+
+    Descriptors are only received while setDescriptorReceivingEnabled()
+    is on; otherwise this function returns an empty list.
+
+    Descriptors arrive together with the data they were written with: they
+    are available as soon as that data has been received into the read
+    buffer, which happens before readyRead() is emitted for it. Descriptors
+    that have not been read when the socket is destroyed are closed.
+
+    \sa writeDescriptors(), setDescriptorReceivingEnabled()
+*/
+
+/*!
+    \fn void QLocalSocket::setDescriptorReceivingEnabled(bool enabled)
+    \since 6.0
+
+    If \a enabled is true, the socket keeps the file descriptors the peer
+    passes with writeDescriptors(), for readDescriptors() to return. Every
+    received descriptor uses up one of the process's descriptors until it
+    is closed, so only enable this for peers that are trusted to send a
+    reasonable number of them, and read and close them promptly.
+
+    Receiving is disabled by default. The descriptors that arrive with
+    data read while it is disabled are closed by the system. If the
+    process runs out of descriptors while receiving, all descriptors that
+    arrived with the same data are closed.
+
+    Enable receiving before the peer can send descriptors, for instance
+    right after the connection is set up. The setting is kept across
+    connections. Passing descriptors is only supported by the Unix domain
+    socket implementation; on other platforms this function does nothing.
+
+    \sa isDescriptorReceivingEnabled(), readDescriptors()
+*/
+
+/*!
+    \fn bool QLocalSocket::isDescriptorReceivingEnabled() const
+    \since 6.0
+
+    Returns \c true if the socket keeps the file descriptors passed by
+    the peer; otherwise returns \c false.
+
+    \sa setDescriptorReceivingEnabled()
+*/
+
 /*!
     \fn qint64 QLocalSocket::readData(char *data, qint64 c)
     \reimp
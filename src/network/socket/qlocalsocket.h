@@ -42,6 +42,7 @@
 
 #include <QtNetwork/qtnetworkglobal.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qlist.h>
 #include <QtNetwork/qabstractsocket.h>
 
 QT_REQUIRE_CONFIG(localserver);
@@ -108,6 +109,11 @@ public:
                              OpenMode openMode = ReadWrite);
     qintptr socketDescriptor() const;
 
+    qint64 writeDescriptors(const QByteArray &data, const QList<qintptr> &descriptors);
+    QList<qintptr> readDescriptors();
+    void setDescriptorReceivingEnabled(bool enabled);
+    bool isDescriptorReceivingEnabled() const;
+
     LocalSocketState state() const;
     bool waitForBytesWritten(int msecs = 30000) override;
     bool waitForConnected(int msecs = 30000);
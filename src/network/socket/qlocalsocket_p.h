@@ -138,6 +138,12 @@ public:
     QWindowsPipeReader *pipeReader;
     QLocalSocket::LocalSocketError error;
 #else
+    ~QLocalSocketPrivate();
+    qintptr nativeWriteDescriptor() override;
+    void setDescriptorReceiver();
+
+    QList<qintptr> receivedDescriptors;
+    bool descriptorReceivingEnabled = false;
     QLocalUnixSocket unixSocket;
     QString generateErrorString(QLocalSocket::LocalSocketError, const QString &function) const;
     void setErrorAndEmit(QLocalSocket::LocalSocketError, const QString &function);
@@ -295,6 +295,32 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->tcpSocket->socketDescriptor();
 }
 
+qint64 QLocalSocket::writeDescriptors(const QByteArray &data, const QList<qintptr> &descriptors)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(descriptors);
+    Q_D(QLocalSocket);
+    d->tcpSocket->setSocketError(QAbstractSocket::UnsupportedSocketOperationError);
+    setErrorString(d->generateErrorString(UnsupportedSocketOperationError,
+                                          QLatin1String("QLocalSocket::writeDescriptors")));
+    return -1;
+}
+
+QList<qintptr> QLocalSocket::readDescriptors()
+{
+    return QList<qintptr>();
+}
+
+void QLocalSocket::setDescriptorReceivingEnabled(bool enabled)
+{
+    Q_UNUSED(enabled);
+}
+
+bool QLocalSocket::isDescriptorReceivingEnabled() const
+{
+    return false;
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
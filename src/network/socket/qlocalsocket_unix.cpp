@@ -40,6 +40,8 @@
 #include "qlocalsocket.h"
 #include "qlocalsocket_p.h"
 #include "qnet_unix_p.h"
+#include "private/qabstractsocket_p.h"
+#include "private/qnativesocketengine_p.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -68,6 +70,12 @@ QLocalSocketPrivate::QLocalSocketPrivate() : QIODevicePrivate(),
 {
 }
 
+QLocalSocketPrivate::~QLocalSocketPrivate()
+{
+    for (qintptr descriptor : qAsConst(receivedDescriptors))
+        qt_safe_close(int(descriptor));
+}
+
 void QLocalSocketPrivate::init()
 {
     Q_Q(QLocalSocket);
@@ -87,6 +95,30 @@ void QLocalSocketPrivate::init()
     unixSocket.setParent(q);
 }
 
+qintptr QLocalSocketPrivate::nativeWriteDescriptor()
+{
+    // subclasses may transform the data in writeData()
+    Q_Q(QLocalSocket);
+    if (q->metaObject() != &QLocalSocket::staticMetaObject || !allWriteBuffersEmpty())
+        return -1;
+    return static_cast<QIODevicePrivate *>(QObjectPrivate::get(&unixSocket))
+            ->nativeWriteDescriptor();
+}
+
+/*! \internal
+
+    Makes the socket engine collect the file descriptors that the peer
+    passes along with the data, if the user asked for them. Otherwise the
+    kernel closes them when the data is read.
+*/
+void QLocalSocketPrivate::setDescriptorReceiver()
+{
+    QAbstractSocketPrivate *socketPrivate =
+            static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(&unixSocket));
+    if (auto engine = qobject_cast<QNativeSocketEngine *>(socketPrivate->socketEngine))
+        engine->setDescriptorReceiver(descriptorReceivingEnabled ? &receivedDescriptors : nullptr);
+}
+
 void QLocalSocketPrivate::_q_errorOccurred(QAbstractSocket::SocketError socketError)
 {
     Q_Q(QLocalSocket);
@@ -327,6 +359,7 @@ void QLocalSocketPrivate::_q_connectToSocket()
     fullServerName = connectingPathName;
     if (unixSocket.setSocketDescriptor(connectingSocket,
         QAbstractSocket::ConnectedState, connectingOpenMode)) {
+        setDescriptorReceiver();
         q->QIODevice::open(connectingOpenMode | QIODevice::Unbuffered);
         q->emit connected();
     } else {
@@ -359,8 +392,10 @@ bool QLocalSocket::setSocketDescriptor(qintptr socketDescriptor,
     }
     QIODevice::open(openMode);
     d->state = socketState;
-    return d->unixSocket.setSocketDescriptor(socketDescriptor,
-                                             newSocketState, openMode);
+    if (!d->unixSocket.setSocketDescriptor(socketDescriptor, newSocketState, openMode))
+        return false;
+    d->setDescriptorReceiver();
+    return true;
 }
 
 void QLocalSocketPrivate::_q_abortConnectionAttempt()
@@ -401,7 +436,94 @@ qint64 QLocalSocket::skipData(qint64 maxSize)
 qint64 QLocalSocket::writeData(const char *data, qint64 c)
 {
     Q_D(QLocalSocket);
-    return d->unixSocket.writeData(data, c);
+    // Pass on the byte array given to write(), if any, so that the
+    // socket's write buffer can share it instead of copying the data.
+    QIODevicePrivate *socketPrivate =
+            static_cast<QIODevicePrivate *>(QObjectPrivate::get(&d->unixSocket));
+    socketPrivate->currentWriteChunk = d->currentWriteChunk;
+    const qint64 written = d->unixSocket.writeData(data, c);
+    socketPrivate->currentWriteChunk = nullptr;
+    return written;
+}
+
+qint64 QLocalSocket::writeDescriptors(const QByteArray &data, const QList<qintptr> &descriptors)
+{
+    Q_D(QLocalSocket);
+    if (data.isEmpty()) {
+        qWarning("QLocalSocket::writeDescriptors: Cannot pass descriptors without data");
+        return -1;
+    }
+    if (descriptors.size() > QNativeSocketEngine::MaxDescriptorsPerWrite) {
+        qWarning("QLocalSocket::writeDescriptors: Cannot pass more than %d descriptors at once",
+                 int(QNativeSocketEngine::MaxDescriptorsPerWrite));
+        return -1;
+    }
+
+    const QString function = QLatin1String("QLocalSocket::writeDescriptors");
+    QAbstractSocketPrivate *socketPrivate =
+            static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(&d->unixSocket));
+    QNativeSocketEngine *engine = qobject_cast<QNativeSocketEngine *>(socketPrivate->socketEngine);
+    if (d->state != ConnectedState || !engine || !isWritable()) {
+        d->unixSocket.setSocketError(QAbstractSocket::OperationError);
+        setErrorString(d->generateErrorString(OperationError, function));
+        return -1;
+    }
+
+    // The descriptors must arrive with their own data, not with whatever
+    // was written before, so drain the write buffer first.
+    while (d->unixSocket.bytesToWrite() > 0) {
+        if (!d->unixSocket.waitForBytesWritten(QT_CONNECT_TIMEOUT))
+            return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 written;
+    while ((written = engine->writeWithDescriptors(data.constData(), data.size(),
+                                                   descriptors)) == 0) {
+        // The kernel's send buffer is full.
+        const int timeout = QT_CONNECT_TIMEOUT - int(timer.elapsed());
+        if (timeout <= 0 || !engine->waitForWrite(timeout)) {
+            d->unixSocket.setSocketError(QAbstractSocket::SocketTimeoutError);
+            setErrorString(d->generateErrorString(SocketTimeoutError, function));
+            return -1;
+        }
+    }
+    if (written < 0) {
+        if (engine->isValid()) {
+            // Nothing was sent, e.g. because a descriptor was invalid.
+            d->unixSocket.setSocketError(QAbstractSocket::UnknownSocketError);
+            setErrorString(d->generateErrorString(UnknownSocketError, function));
+        } else {
+            d->setErrorAndEmit(LocalSocketError(engine->error()), function);
+        }
+        return -1;
+    }
+
+    emit bytesWritten(written);
+    // Whatever did not fit is sent like any other data.
+    if (written < data.size())
+        d->unixSocket.writeData(data.constData() + written, data.size() - written);
+    return data.size();
+}
+
+QList<qintptr> QLocalSocket::readDescriptors()
+{
+    Q_D(QLocalSocket);
+    return qExchange(d->receivedDescriptors, {});
+}
+
+void QLocalSocket::setDescriptorReceivingEnabled(bool enabled)
+{
+    Q_D(QLocalSocket);
+    d->descriptorReceivingEnabled = enabled;
+    d->setDescriptorReceiver();
+}
+
+bool QLocalSocket::isDescriptorReceivingEnabled() const
+{
+    Q_D(const QLocalSocket);
+    return d->descriptorReceivingEnabled;
 }
 
 void QLocalSocket::abort()
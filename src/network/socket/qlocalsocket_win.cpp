@@ -381,6 +381,32 @@ qintptr QLocalSocket::socketDescriptor() const
     return reinterpret_cast<qintptr>(d->handle);
 }
 
+qint64 QLocalSocket::writeDescriptors(const QByteArray &data, const QList<qintptr> &descriptors)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(descriptors);
+    Q_D(QLocalSocket);
+    d->error = UnsupportedSocketOperationError;
+    d->errorString = tr("%1: The socket operation is not supported")
+            .arg(QLatin1String("QLocalSocket::writeDescriptors"));
+    return -1;
+}
+
+QList<qintptr> QLocalSocket::readDescriptors()
+{
+    return QList<qintptr>();
+}
+
+void QLocalSocket::setDescriptorReceivingEnabled(bool enabled)
+{
+    Q_UNUSED(enabled);
+}
+
+bool QLocalSocket::isDescriptorReceivingEnabled() const
+{
+    return false;
+}
+
 qint64 QLocalSocket::readBufferSize() const
 {
     Q_D(const QLocalSocket);
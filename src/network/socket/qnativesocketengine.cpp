@@ -918,6 +918,52 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the \a count blocks in \a buffers to the socket, in order,
+    with as few system calls as the platform allows. Returns the number
+    of bytes written, which may end in the middle of any block, or -1 if
+    an error occurred.
+*/
+qint64 QNativeSocketEngine::writeVectored(const QByteArrayView *buffers, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVectored(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVectored(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteVectored(buffers, count);
+}
+
+#ifdef Q_OS_UNIX
+/*!
+    Writes a block of \a size bytes from \a data to the socket and passes
+    \a descriptors to the peer along with its first byte. The descriptors
+    stay open in this process. Returns the number of bytes written, or -1
+    if an error occurred; if nothing was written, the descriptors were not
+    sent either.
+
+    This is only meaningful for Unix domain sockets.
+*/
+qint64 QNativeSocketEngine::writeWithDescriptors(const char *data, qint64 size,
+                                                 const QList<qintptr> &descriptors)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeWithDescriptors(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeWithDescriptors(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteWithDescriptors(data, size, descriptors);
+}
+
+/*!
+    Makes read() collect the file descriptors that the peer passes along
+    with the data, appending them to \a descriptors, which must outlive
+    the engine or be unset by passing \nullptr. Descriptors that arrive
+    while no list is set are discarded by the system.
+*/
+void QNativeSocketEngine::setDescriptorReceiver(QList<qintptr> *descriptors)
+{
+    Q_D(QNativeSocketEngine);
+    d->descriptorReceiver = descriptors;
+}
+#endif
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -146,6 +146,12 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeVectored(const QByteArrayView *buffers, int count);
+#ifdef Q_OS_UNIX
+    enum { MaxDescriptorsPerWrite = 253 }; // SCM_MAX_FD on Linux
+    qint64 writeWithDescriptors(const char *data, qint64 len, const QList<qintptr> &descriptors);
+    void setDescriptorReceiver(QList<qintptr> *descriptors);
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -216,6 +222,11 @@ public:
     LPFN_WSASENDMSG sendmsg;
     LPFN_WSARECVMSG recvmsg;
 #  endif
+#ifdef Q_OS_UNIX
+    // Where SCM_RIGHTS descriptors arriving with stream data are stored;
+    // nullptr if the owner of the socket does not expect any.
+    QList<qintptr> *descriptorReceiver = nullptr;
+#endif
     enum ErrorString {
         NonBlockingInitFailedErrorString,
         BroadcastingInitFailedErrorString,
@@ -279,6 +290,12 @@ public:
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+    qint64 nativeWriteVectored(const QByteArrayView *buffers, int count);
+#ifdef Q_OS_UNIX
+    qint64 nativeWriteWithDescriptors(const char *data, qint64 length,
+                                      const QList<qintptr> &descriptors);
+    qint64 nativeSendMessage(const msghdr *msg);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -49,6 +49,7 @@
 #include <time.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #ifndef QT_NO_IPV6IFNAME
 #include <net/if.h>
 #endif
@@ -1330,11 +1331,78 @@ void QNativeSocketEnginePrivate::nativeClose()
 }
 
 qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
+{
+    iovec vec;
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = size_t(len);
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    return nativeSendMessage(&msg);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, int count)
+{
+#ifdef IOV_MAX
+    count = qMin(count, int(IOV_MAX));
+#endif
+    QVarLengthArray<iovec, 16> vec(count);
+    for (int i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char *>(buffers[i].data());
+        vec[i].iov_len = size_t(buffers[i].size());
+    }
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vec.data();
+    msg.msg_iovlen = count;
+    return nativeSendMessage(&msg);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeWriteWithDescriptors(const char *data, qint64 len,
+                                                              const QList<qintptr> &descriptors)
+{
+    Q_ASSERT(len > 0);  // no data, no descriptors: the kernel needs a byte to attach them to
+    Q_ASSERT(descriptors.size() <= QNativeSocketEngine::MaxDescriptorsPerWrite);
+    if (descriptors.isEmpty())
+        return nativeWrite(data, len);
+
+    iovec vec;
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = size_t(len);
+
+    const size_t controlSize = CMSG_SPACE(sizeof(int) * descriptors.size());
+    QVarLengthArray<cmsghdr, 16> control((controlSize + sizeof(cmsghdr) - 1) / sizeof(cmsghdr));
+    memset(control.data(), 0, control.size() * sizeof(cmsghdr));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = controlSize;
+
+    cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg);
+    cmsgptr->cmsg_level = SOL_SOCKET;
+    cmsgptr->cmsg_type = SCM_RIGHTS;
+    cmsgptr->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+    uchar *fds = CMSG_DATA(cmsgptr);
+    for (qintptr descriptor : descriptors) {
+        const int fd = int(descriptor);
+        memcpy(fds, &fd, sizeof(fd));
+        fds += sizeof(fd);
+    }
+
+    return nativeSendMessage(&msg);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendMessage(const msghdr *msg)
 {
     Q_Q(QNativeSocketEngine);
 
-    ssize_t writtenBytes;
-    writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, msg, 0);
 
     if (writtenBytes < 0) {
         switch (errno) {
@@ -1356,13 +1424,74 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
-    qDebug("QNativeSocketEnginePrivate::nativeWrite(%p \"%s\", %llu) == %i",
-           data, qt_prettyDebug(data, qMin((int) len, 16),
-                                (int) len).data(), len, (int) writtenBytes);
+    qDebug("QNativeSocketEnginePrivate::nativeSendMessage(%p, %zu buffers, %zu bytes of control data) == %i",
+           msg, size_t(msg->msg_iovlen), size_t(msg->msg_controllen), int(writtenBytes));
 #endif
 
     return qint64(writtenBytes);
 }
+
+/*
+    Reads like read(), additionally appending the file descriptors passed
+    along with the data (SCM_RIGHTS) to \a descriptors.
+*/
+static ssize_t qt_safe_read_with_descriptors(int sockfd, char *data, qint64 maxSize,
+                                             QList<qintptr> *descriptors)
+{
+    iovec vec;
+    vec.iov_base = data;
+    vec.iov_len = size_t(maxSize);
+
+    union {
+        cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int) * QNativeSocketEngine::MaxDescriptorsPerWrite)];
+    } control;
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+    const ssize_t r = qt_safe_recvmsg(sockfd, &msg, flags);
+    if (r < 0)
+        return r;
+
+    const qsizetype firstReceived = descriptors->size();
+    for (cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
+        if (cmsgptr->cmsg_level != SOL_SOCKET || cmsgptr->cmsg_type != SCM_RIGHTS)
+            continue;
+        const uchar *fds = CMSG_DATA(cmsgptr);
+        const size_t count = (cmsgptr->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; ++i) {
+            int fd;
+            memcpy(&fd, fds + i * sizeof(int), sizeof(fd));
+#ifndef MSG_CMSG_CLOEXEC
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+            descriptors->append(fd);
+        }
+    }
+
+    if (msg.msg_flags & MSG_CTRUNC) {
+        // The kernel dropped some of the descriptors, because there were
+        // more than fit into the control buffer or the process ran out of
+        // descriptors. The rest of the set is of no use to the receiver.
+        for (qsizetype i = firstReceived; i < descriptors->size(); ++i)
+            qt_safe_close(int(descriptors->at(i)));
+        descriptors->resize(firstReceived);
+        qWarning("QNativeSocketEngine: Discarded file descriptors passed by the peer, "
+                 "as some of them could not be received");
+    }
+    return r;
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -1374,7 +1503,10 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     }
 
     ssize_t r = 0;
-    r = qt_safe_read(socketDescriptor, data, maxSize);
+    if (descriptorReceiver)
+        r = qt_safe_read_with_descriptors(socketDescriptor, data, maxSize, descriptorReceiver);
+    else
+        r = qt_safe_read(socketDescriptor, data, maxSize);
 
     if (r < 0) {
         r = -1;
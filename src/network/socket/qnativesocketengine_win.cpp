@@ -52,6 +52,7 @@
 #include <qdatetime.h>
 #include <qnetworkinterface.h>
 #include <qoperatingsystemversion.h>
+#include <qvarlengtharray.h>
 
 #include <algorithm>
 
@@ -1481,6 +1482,49 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QNativeSocketEngine);
+    Q_ASSERT(count > 0);
+    QVarLengthArray<WSABUF, 16> buf(count);
+    for (int i = 0; i < count; ++i) {
+        buf[i].buf = const_cast<char *>(buffers[i].data());
+        buf[i].len = ULONG(buffers[i].size());
+    }
+
+    qint64 ret = 0;
+    DWORD bytesWritten = 0;
+    if (::WSASend(socketDescriptor, buf.data(), DWORD(count), &bytesWritten, 0, 0, 0) != SOCKET_ERROR) {
+        ret = qint64(bytesWritten);
+    } else {
+        const int err = WSAGetLastError();
+        switch (err) {
+        case WSAEWOULDBLOCK:
+            break;
+        case WSAENOBUFS:
+            // nativeWrite() knows how to get a single block through
+            ret = nativeWrite(buffers[0].data(), buffers[0].size());
+            break;
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+            WS_ERROR_DEBUG(err);
+            ret = -1;
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            q->close();
+            break;
+        default:
+            WS_ERROR_DEBUG(err);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVectored(%p, %d) == %lli", buffers, count, ret);
+#endif
+
+    return ret;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
@@ -3941,7 +3941,7 @@ QString QDomElementPrivate::attributeNS(const QString& nsURI, const QString& loc
     return n->nodeValue();
 }
 
-void QDomElementPrivate::setAttribute(const QString& aname, const QString& newValue)
+QDomNodePrivate *QDomElementPrivate::setAttribute(const QString& aname, const QString& newValue)
 {
     QDomNodePrivate* n = m_attr->namedItem(aname);
     if (!n) {
@@ -3955,9 +3955,10 @@ void QDomElementPrivate::setAttribute(const QString& aname, const QString& newVa
     } else {
         n->setNodeValue(newValue);
     }
+    return n;
 }
 
-void QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qName, const QString& newValue)
+QDomNodePrivate *QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qName, const QString& newValue)
 {
     QString prefix, localName;
     qt_split_namespace(prefix, localName, qName, true);
@@ -3974,6 +3975,7 @@ void QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qNa
         n->setNodeValue(newValue);
         n->prefix = prefix;
     }
+    return n;
 }
 
 void QDomElementPrivate::removeAttribute(const QString& aname)
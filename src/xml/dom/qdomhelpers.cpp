@@ -105,26 +105,25 @@ bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
                                const QXmlStreamAttributes &atts)
 {
     QDomNodePrivate *n =
-            nsProcessing ? doc->createElementNS(nsURI, qName) : doc->createElement(qName);
+            nsProcessing ? doc->createElementNS(intern(nsURI), intern(qName))
+                         : doc->createElement(intern(qName));
     if (!n)
         return false;
 
+    internNames(n);
     n->setLocation(locator->line(), locator->column());
 
     node->appendChild(n);
     node = n;
 
     // attributes
+    auto domElement = static_cast<QDomElementPrivate *>(node);
     for (const auto &attr : atts) {
-        auto domElement = static_cast<QDomElementPrivate *>(node);
-        if (nsProcessing) {
-            domElement->setAttributeNS(attr.namespaceUri().toString(),
-                                       attr.qualifiedName().toString(),
-                                       attr.value().toString());
-        } else {
-            domElement->setAttribute(attr.qualifiedName().toString(),
-                                     attr.value().toString());
-        }
+        QDomNodePrivate *a = nsProcessing
+                ? domElement->setAttributeNS(intern(attr.namespaceUri()), intern(attr.qualifiedName()),
+                                             attr.value().toString())
+                : domElement->setAttribute(intern(attr.qualifiedName()), attr.value().toString());
+        internNames(a);
     }
 
     return true;
@@ -193,6 +192,44 @@ void QDomBuilder::fatalError(const QString &message)
     errorColumn = static_cast<int>(locator->column());
 }
 
+/*
+    Element and attribute names, prefixes and namespace URIs repeat
+    throughout most documents. Sharing one QString per distinct name between
+    all the nodes that use it keeps the memory used by large documents down
+    to the node structures and the character data.
+*/
+QString QDomBuilder::intern(const QString &s)
+{
+    if (s.isEmpty())
+        return s; // keep null and empty distinct
+    const auto it = names.constFind(s);
+    if (it != names.cend())
+        return *it;
+    names.insert(s, s);
+    return s;
+}
+
+QString QDomBuilder::intern(QStringView s)
+{
+    if (s.isEmpty())
+        return s.toString();
+    const auto it = names.constFind(s);
+    if (it != names.cend())
+        return *it;
+    const QString str = s.toString();
+    names.insert(str, str);
+    return str;
+}
+
+void QDomBuilder::internNames(QDomNodePrivate *n)
+{
+    n->name = intern(n->name);
+    if (!n->prefix.isEmpty())
+        n->prefix = intern(n->prefix);
+    if (!n->namespaceURI.isEmpty())
+        n->namespaceURI = intern(n->namespaceURI);
+}
+
 QDomBuilder::ErrorInfo QDomBuilder::error() const
 {
     return ErrorInfo(errorMsg, errorLine, errorColumn);
@@ -379,7 +416,7 @@ bool QDomParser::parseBody()
             break;
         case QXmlStreamReader::Characters:
             if (!reader->isWhitespace()) { // Skip the content consisting of only whitespaces
-                if (!reader->text().toString().trimmed().isEmpty()) {
+                if (!reader->text().trimmed().isEmpty()) {
                     if (!domBuilder.characters(reader->text().toString(), reader->isCDATA())) {
                         domBuilder.fatalError(QDomParser::tr(
                                 "Error occurred while processing the element content"));
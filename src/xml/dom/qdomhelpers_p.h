@@ -41,6 +41,8 @@
 
 #include <qcoreapplication.h>
 #include <qglobal.h>
+#include <qhash.h>
+#include <qstring.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -129,10 +131,15 @@ public:
     int errorColumn;
 
 private:
+    QString intern(const QString &s);
+    QString intern(QStringView s);
+    void internNames(QDomNodePrivate *n);
+
     QDomDocumentPrivate *doc;
     QDomNodePrivate *node;
     QXmlDocumentLocator *locator;
     QString entityName;
+    QHash<QStringView, QString> names; // each key views the data of its value
     bool nsProcessing;
 };
 
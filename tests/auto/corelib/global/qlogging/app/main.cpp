@@ -82,6 +82,23 @@ int main(int argc, char **argv)
     MyClass cl;
     QMetaObject::invokeMethod(&cl, "mySlot1");
 
+    // for the tests of the asynchronous stderr sink, which count on every
+    // message up to the end being written out, or reported as dropped
+    if (argc > 1) {
+        const QByteArray mode = argv[1];
+        qSetMessagePattern("%{message}");
+        if (mode == "async-dropped") {
+            for (int i = 0; i < 100000; ++i)
+                qDebug("message %d", i);
+        } else if (mode == "async-exit") {
+            for (int i = 0; i < 100; ++i)
+                qDebug("message %d", i);
+        } else if (mode == "async-fatal") {
+            qDebug("before fatal");
+            qFatal("fatal");
+        }
+    }
+
     return 0;
 }
 
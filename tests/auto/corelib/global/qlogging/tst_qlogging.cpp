@@ -56,8 +56,13 @@ private slots:
 
     void qMessagePattern_data();
     void qMessagePattern();
+    void setMessagePattern_data();
     void setMessagePattern();
 
+    void asyncDroppedMessages();
+    void asyncFlushAtExit();
+    void asyncFlushBeforeFatal();
+
     void formatLogMessage_data();
     void formatLogMessage();
 
@@ -813,6 +818,14 @@ void tst_qmessagehandler::qMessagePattern()
 #endif
 }
 
+void tst_qmessagehandler::setMessagePattern_data()
+{
+    QTest::addColumn<bool>("async");
+
+    QTest::newRow("sync") << false;
+    QTest::newRow("async") << true;
+}
+
 void tst_qmessagehandler::setMessagePattern()
 {
 #if !QT_CONFIG(process)
@@ -821,6 +834,7 @@ void tst_qmessagehandler::setMessagePattern()
 #ifdef Q_OS_ANDROID
     QSKIP("This test crashes on Android");
 #endif
+    QFETCH(bool, async);
 
     //
     // test qSetMessagePattern
@@ -842,6 +856,8 @@ void tst_qmessagehandler::setMessagePattern()
     std::copy_if(m_baseEnvironment.cbegin(), m_baseEnvironment.cend(),
                  std::back_inserter(environment),
                  doesNotStartWith(QLatin1String("QT_MESSAGE_PATTERN")));
+    if (async)
+        environment.append(QStringLiteral("QT_LOGGING_ASYNC=1"));
     process.setEnvironment(environment);
 
     process.start(appExe);
@@ -864,6 +880,89 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+#if QT_CONFIG(process)
+// Runs the helper in \a mode with the asynchronous sink and returns its stderr
+static QByteArray runAsyncHelper(const QStringList &baseEnvironment, const QString &mode,
+                                 const QStringList &extraEnvironment = QStringList())
+{
+#ifndef Q_OS_ANDROID
+    const QString appExe(QLatin1String(HELPER_BINARY));
+#else
+    const QString appExe(QCoreApplication::applicationDirPath() + QLatin1String("/libhelper.so"));
+#endif
+    QStringList environment = baseEnvironment;
+    environment.append(QStringLiteral("QT_LOGGING_ASYNC=1"));
+    environment += extraEnvironment;
+
+    QProcess process;
+    process.setEnvironment(environment);
+    process.start(appExe, { mode });
+    if (!process.waitForStarted() || !process.waitForFinished())
+        return QByteArray();
+    QByteArray output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    return output;
+}
+#endif
+
+void tst_qmessagehandler::asyncDroppedMessages()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+    // a tiny buffer, filled much faster than the writer can empty it
+    const QByteArray output = runAsyncHelper(m_baseEnvironment, QStringLiteral("async-dropped"),
+                                             { QStringLiteral("QT_LOGGING_ASYNC_BUFFER_SIZE=16") });
+
+    // every message is either written, in order, or counted in a report
+    const QByteArray droppedPrefix = "Dropped ";
+    const QByteArray droppedSuffix = " messages because the asynchronous logging buffer was full";
+    int written = 0;
+    int dropped = 0;
+    int last = -1;
+    for (const QByteArray &line : output.split('\n')) {
+        if (line.startsWith("message ")) {
+            const int i = line.mid(8).toInt();
+            QVERIFY2(i > last, line.constData());
+            last = i;
+            ++written;
+        } else if (line.startsWith(droppedPrefix) && line.endsWith(droppedSuffix)) {
+            dropped += line.mid(droppedPrefix.size(),
+                                line.size() - droppedPrefix.size() - droppedSuffix.size()).toInt();
+        }
+    }
+    QVERIFY(dropped > 0);
+    QCOMPARE(written + dropped, 100000);
+#endif
+}
+
+void tst_qmessagehandler::asyncFlushAtExit()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+    const QByteArray output = runAsyncHelper(m_baseEnvironment, QStringLiteral("async-exit"));
+
+    QByteArray expected;
+    for (int i = 0; i < 100; ++i)
+        expected += "message " + QByteArray::number(i) + '\n';
+    QVERIFY2(output.contains(expected), output.constData());
+#endif
+}
+
+void tst_qmessagehandler::asyncFlushBeforeFatal()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+    const QByteArray output = runAsyncHelper(m_baseEnvironment, QStringLiteral("async-fatal"));
+
+    QVERIFY2(output.contains("before fatal\nfatal\n"), output.constData());
+#endif
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
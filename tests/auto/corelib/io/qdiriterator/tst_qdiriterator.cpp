@@ -92,6 +92,9 @@ private slots:
     void cleanupTestCase();
     void iterateRelativeDirectory_data();
     void iterateRelativeDirectory();
+    void walk_data() { iterateRelativeDirectory_data(); }
+    void walk();
+    void walkMaxDepth();
     void iterateResource_data();
     void iterateResource();
     void stopLinkLoop();
@@ -386,6 +389,63 @@ void tst_QDirIterator::iterateRelativeDirectory()
     QCOMPARE(list, sortedEntries);
 }
 
+void tst_QDirIterator::walk()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QStringList, entries);
+
+    QStringList list;
+    QDirIterator::walk(dirName, nameFilters, filters, flags, -1,
+                       [&list](const QFileInfoList &batch) {
+        QVERIFY(!batch.isEmpty());
+        for (const QFileInfo &info : batch)
+            list << info.canonicalFilePath();
+    });
+    list.sort();
+
+    QStringList sortedEntries;
+    for (const QString &item : qAsConst(entries))
+        sortedEntries.append(QFileInfo(item).canonicalFilePath());
+    sortedEntries.sort();
+
+    QCOMPARE(list, sortedEntries);
+}
+
+void tst_QDirIterator::walkMaxDepth()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QVERIFY(QDir(dir.path()).mkpath("a/b/c/d"));
+    QVERIFY(QDir(dir.path()).mkpath("e/f"));
+
+    const auto walkedEntries = [&dir](int maxDepth) {
+        QStringList list;
+        QDirIterator::walk(dir.path(), QStringList(), QDir::Dirs | QDir::NoDotAndDotDot,
+                           QDirIterator::Subdirectories, maxDepth,
+                           [&](const QFileInfoList &batch) {
+            for (const QFileInfo &info : batch)
+                list << QDir(dir.path()).relativeFilePath(info.filePath());
+        });
+        list.sort();
+        return list;
+    };
+
+    QCOMPARE(walkedEntries(0), QStringList({ "a", "e" }));
+    QCOMPARE(walkedEntries(1), QStringList({ "a", "a/b", "e", "e/f" }));
+    QCOMPARE(walkedEntries(-1), QStringList({ "a", "a/b", "a/b/c", "a/b/c/d", "e", "e/f" }));
+
+    // without Subdirectories, only the top level is listed
+    qsizetype count = 0;
+    QDirIterator::walk(dir.path(), QStringList(), QDir::Dirs | QDir::NoDotAndDotDot,
+                       QDirIterator::NoIteratorFlags, -1, [&](const QFileInfoList &batch) {
+        count += batch.size();
+    });
+    QCOMPARE(count, 2);
+}
+
 void tst_QDirIterator::iterateResource_data()
 {
     QTest::addColumn<QString>("dirName"); // relative from current path or abs
@@ -51,6 +51,12 @@ QT_END_NAMESPACE
 
 #if !defined(QT_NO_NETWORK)
 #include <QHostInfo>
+#include <QTcpServer>
+#include <QTcpSocket>
+#  if QT_CONFIG(localserver)
+#    include <QLocalServer>
+#    include <QLocalSocket>
+#  endif
 #endif
 #if QT_CONFIG(process)
 # include <QProcess>
@@ -282,6 +288,14 @@ private slots:
 
     void stdfilesystem();
 
+    void readWriteAsync();
+    void transferTo_data();
+    void transferTo();
+    void transferToPartialWrites_data();
+    void transferToPartialWrites();
+    void transferToSocket_data();
+    void transferToSocket();
+
 private:
 #ifdef BUILTIN_TESTDATA
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -3854,5 +3868,289 @@ void tst_QFile::stdfilesystem()
 #endif
 }
 
+void tst_QFile::readWriteAsync()
+{
+    QFile file("readWriteAsync.txt");
+    QVERIFY2(file.open(QIODevice::ReadWrite | QIODevice::Truncate), msgOpenFailed(file).constData());
+    QCOMPARE(file.write("0123456789"), qint64(10));
+
+    // buffered data is flushed first; the position is not touched
+    QFuture<qint64> written = file.writeAsync(4, "abcd");
+    QCOMPARE(written.result(), qint64(4));
+    QCOMPARE(file.pos(), qint64(10));
+
+    QFuture<QByteArray> data = file.readAsync(2, 6);
+    QCOMPARE(data.result(), QByteArray("23abcd"));
+    QCOMPARE(file.pos(), qint64(10));
+
+    // reading past the end yields what is there
+    QCOMPARE(file.readAsync(8, 100).result(), QByteArray("89"));
+    QCOMPARE(file.readAsync(20, 100).result(), QByteArray());
+    // the buffer is sized for the file, not for maxSize
+    QCOMPARE(file.readAsync(4, std::numeric_limits<qint64>::max()).result(),
+             QByteArray("abcd89"));
+
+    // the file may go away while requests are pending
+    QList<QFuture<QByteArray>> pending;
+    for (int i = 0; i < 10; ++i)
+        pending.append(file.readAsync(i, 1));
+    file.close();
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(pending.at(i).result(), QByteArray(1, "0123abcd89"[i]));
+
+    // without a native handle, the read is synchronous and sized for the file as well
+    QFile resource(":/copy-fallback.qrc");
+    QVERIFY(resource.open(QIODevice::ReadOnly));
+    const QByteArray contents = resource.readAll();
+    QCOMPARE(resource.readAsync(4, std::numeric_limits<qint64>::max()).result(), contents.mid(4));
+    QCOMPARE(resource.readAsync(contents.size() + 10, 100).result(), QByteArray());
+    QCOMPARE(resource.pos(), qint64(contents.size()));
+
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::readAsync: File not open for reading");
+    QCOMPARE(file.readAsync(0, 1).result(), QByteArray());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::writeAsync: File not open for writing");
+    QCOMPARE(file.writeAsync(0, "x").result(), qint64(-1));
+
+#ifdef Q_OS_LINUX
+    // files in /proc claim to be empty
+    QFile status("/proc/self/status");
+    QVERIFY(status.open(QIODevice::ReadOnly));
+    QVERIFY(status.readAsync(0, std::numeric_limits<qint64>::max()).result().contains("Pid:"));
+#endif
+}
+
+void tst_QFile::transferTo_data()
+{
+    QTest::addColumn<bool>("toFile");
+    QTest::addColumn<qint64>("maxSize");
+    QTest::addColumn<bool>("direct");
+
+    QTest::newRow("file") << true << qint64(-1) << false;
+    QTest::newRow("file-partial") << true << qint64(100000) << false;
+    QTest::newRow("file-direct") << true << qint64(-1) << true;
+    QTest::newRow("file-direct-partial") << true << qint64(100000) << true;
+    QTest::newRow("buffer") << false << qint64(-1) << false;
+    QTest::newRow("buffer-direct") << false << qint64(-1) << true;
+    QTest::newRow("buffer-direct-partial") << false << qint64(100000) << true;
+}
+
+void tst_QFile::transferTo()
+{
+    QFETCH(bool, toFile);
+    QFETCH(qint64, maxSize);
+    QFETCH(bool, direct);
+    const QFileDevice::TransferOptions options = direct ? QFileDevice::DirectTransferOption
+                                                        : QFileDevice::NoTransferOptions;
+
+    QByteArray data;
+    for (int i = 0; i < 50000; ++i)
+        data += QByteArray::number(i) + ' ';
+
+    QFile source("transferTo-source.txt");
+    QVERIFY2(source.open(QIODevice::ReadWrite | QIODevice::Truncate),
+             msgOpenFailed(source).constData());
+    QCOMPARE(source.write(data), qint64(data.size()));
+    QVERIFY(source.seek(10));
+
+    QFile targetFile("transferTo-target.txt");
+    QBuffer targetBuffer;
+    QIODevice *target = &targetBuffer;
+    if (toFile) {
+        QVERIFY2(targetFile.open(QIODevice::ReadWrite | QIODevice::Truncate),
+                 msgOpenFailed(targetFile).constData());
+        target = &targetFile;
+    } else {
+        QVERIFY(targetBuffer.open(QIODevice::ReadWrite));
+    }
+    QCOMPARE(target->write("head:"), qint64(5));
+
+    const qint64 expectedSize = maxSize < 0 ? data.size() - 10 : maxSize;
+    QCOMPARE(source.transferTo(target, maxSize, options), expectedSize);
+    QCOMPARE(source.pos(), 10 + expectedSize);
+    QCOMPARE(target->pos(), 5 + expectedSize);
+
+    // both devices keep working normally afterwards
+    QCOMPARE(target->write(":tail"), qint64(5));
+    QVERIFY(target->seek(0));
+    QCOMPARE(target->readAll(), "head:" + data.mid(10, expectedSize) + ":tail");
+    QCOMPARE(source.readAll(), data.mid(10 + expectedSize));
+
+    // nothing left to transfer
+    QCOMPARE(source.transferTo(target, -1, options), qint64(0));
+}
+
+// A target that only takes part of each write, like a full pipe or socket
+class PartialWriteBuffer : public QBuffer
+{
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        return QBuffer::writeData(data, qMin<qint64>(len, 1000));
+    }
+};
+
+void tst_QFile::transferToPartialWrites_data()
+{
+    QTest::addColumn<bool>("sequential");
+
+    QTest::newRow("file") << false;
+#ifdef Q_OS_UNIX
+    QTest::newRow("pipe") << true;
+#endif
+}
+
+void tst_QFile::transferToPartialWrites()
+{
+    QFETCH(bool, sequential);
+
+    // less than a pipe can hold
+    QByteArray data;
+    for (int i = 0; i < 5000; ++i)
+        data += QByteArray::number(i) + ' ';
+
+    QFile source("transferToPartialWrites-source.txt");
+    if (sequential) {
+#ifdef Q_OS_UNIX
+        int fds[2];
+        QCOMPARE(::pipe(fds), 0);
+        QCOMPARE(qint64(QT_WRITE(fds[1], data.constData(), data.size())), qint64(data.size()));
+        QT_CLOSE(fds[1]);
+        QVERIFY(source.open(fds[0], QIODevice::ReadOnly, QFileDevice::AutoCloseHandle));
+        QVERIFY(source.isSequential());
+#endif
+    } else {
+        QVERIFY2(source.open(QIODevice::ReadWrite | QIODevice::Truncate),
+                 msgOpenFailed(source).constData());
+        QCOMPARE(source.write(data), qint64(data.size()));
+        QVERIFY(source.seek(0));
+    }
+
+    PartialWriteBuffer target;
+    QVERIFY(target.open(QIODevice::WriteOnly));
+
+    // every call stops at the first short write, and keeps the rest for the next one
+    qint64 transferred = 0;
+    for (int i = 0; i <= data.size() / 1000; ++i) {
+        const qint64 r = source.transferTo(&target);
+        QCOMPARE(r, qMin<qint64>(1000, data.size() - transferred));
+        transferred += r;
+        if (!sequential)
+            QCOMPARE(source.pos(), transferred);
+    }
+    QCOMPARE(source.transferTo(&target), qint64(0));
+    QCOMPARE(target.data(), data);
+}
+
+#if !defined(QT_NO_NETWORK)
+// A socket whose reimplementation of writeData() has to see all the data,
+// without a meta object of its own to tell it apart from QTcpSocket
+class CountingTcpSocket : public QTcpSocket
+{
+public:
+    qint64 counted = 0;
+
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        const qint64 written = QTcpSocket::writeData(data, len);
+        if (written > 0)
+            counted += written;
+        return written;
+    }
+};
+#endif
+
+void tst_QFile::transferToSocket_data()
+{
+    QTest::addColumn<bool>("local");
+    QTest::addColumn<bool>("counting");
+    QTest::addColumn<bool>("direct");
+
+    QTest::newRow("tcp") << false << false << false;
+    QTest::newRow("tcp-direct") << false << false << true;
+    QTest::newRow("tcp-subclass") << false << true << false;
+    QTest::newRow("local") << true << false << false;
+    QTest::newRow("local-direct") << true << false << true;
+}
+
+void tst_QFile::transferToSocket()
+{
+#if defined(QT_NO_NETWORK)
+    QSKIP("This test requires Qt Network");
+#else
+    QFETCH(bool, local);
+    QFETCH(bool, counting);
+    QFETCH(bool, direct);
+#  if !QT_CONFIG(localserver)
+    if (local)
+        QSKIP("This test requires QLocalServer");
+#  endif
+
+    QByteArray data;
+    for (int i = 0; i < 50000; ++i)
+        data += QByteArray::number(i) + ' ';
+
+    QFile source("transferToSocket-source.txt");
+    QVERIFY2(source.open(QIODevice::ReadWrite | QIODevice::Truncate),
+             msgOpenFailed(source).constData());
+    QCOMPARE(source.write(data), qint64(data.size()));
+    QVERIFY(source.seek(0));
+
+    QTcpServer tcpServer;
+    CountingTcpSocket tcpSocket;
+    QIODevice *sender = &tcpSocket;
+    QIODevice *receiver = nullptr;
+#  if QT_CONFIG(localserver)
+    QLocalServer localServer;
+    QLocalSocket localSocket;
+    if (local) {
+        const QString name = QLatin1String("tst_qfile_transferToSocket");
+        QLocalServer::removeServer(name);
+        QVERIFY2(localServer.listen(name), qPrintable(localServer.errorString()));
+        localSocket.connectToServer(name);
+        QVERIFY(localSocket.waitForConnected(5000));
+        QVERIFY(localServer.waitForNewConnection(5000));
+        receiver = localServer.nextPendingConnection();
+        sender = &localSocket;
+    }
+#  endif
+    if (!local) {
+        QVERIFY2(tcpServer.listen(QHostAddress::LocalHost), qPrintable(tcpServer.errorString()));
+        tcpSocket.connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+        QVERIFY(tcpSocket.waitForConnected(5000));
+        QVERIFY(tcpServer.waitForNewConnection(5000));
+        receiver = tcpServer.nextPendingConnection();
+    }
+    QVERIFY(receiver);
+
+    // still in the socket's write buffer, so it has to go out first
+    QCOMPARE(sender->write("head:"), qint64(5));
+    QCOMPARE(source.transferTo(sender, -1, direct ? QFileDevice::DirectTransferOption
+                                                  : QFileDevice::NoTransferOptions),
+             qint64(data.size()));
+    QCOMPARE(source.pos(), qint64(data.size()));
+#  ifdef Q_OS_LINUX
+    // the kernel took some or all of the data
+    if (direct)
+        QVERIFY(sender->bytesToWrite() < data.size());
+#  endif
+    QCOMPARE(sender->write(":tail"), qint64(5));
+
+    const QByteArray expected = "head:" + data + ":tail";
+    QByteArray received;
+    QDeadlineTimer deadline(30000);
+    while (received.size() < expected.size() && !deadline.hasExpired()) {
+        if (sender->bytesToWrite())
+            sender->waitForBytesWritten(10);
+        receiver->waitForReadyRead(10);
+        received += receiver->readAll();
+    }
+    QCOMPARE(received, expected);
+    if (counting)
+        QCOMPARE(tcpSocket.counted, qint64(expected.size()));
+#endif
+}
+
 QTEST_MAIN(tst_QFile)
 #include "tst_qfile.moc"
@@ -85,6 +85,9 @@ private slots:
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
+#if defined(Q_OS_LINUX)
+    void watchRecursively();
+#endif
 
 private:
     QString m_tempDirPattern;
@@ -841,5 +844,77 @@ void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 }
 #endif
 
+#if defined(Q_OS_LINUX)
+void tst_QFileSystemWatcher::watchRecursively()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    QDir testDir(root);
+    QVERIFY(testDir.mkpath("a/b"));
+
+    QFileSystemWatcher watcher;
+    watcher.setLatency(50);
+    QCOMPARE(watcher.latency(), 50);
+    if (!watcher.addRecursivePath(root))
+        QSKIP("Recursive watches are not available");
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(root));
+    QVERIFY(!watcher.addRecursivePath(root));
+    QVERIFY(watcher.directories().isEmpty());
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+    QStringList changed;
+    const auto collect = [&] {
+        while (!changedSpy.isEmpty())
+            changed += changedSpy.takeFirst().at(0).toStringList();
+        return changed;
+    };
+
+    // changes in nested directories are reported
+    for (int i = 0; i < 10; ++i) {
+        QFile file(root + QString::fromLatin1("/a/b/file%1").arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write("hello"), qint64(5));
+    }
+    QTRY_VERIFY(collect().contains(root + "/a/b/file9"));
+    QVERIFY(changed.contains(root + "/a/b/file0"));
+
+    // new directories are watched automatically
+    changed.clear();
+    QVERIFY(testDir.mkdir("c"));
+    QTRY_VERIFY(collect().contains(root + "/c"));
+    changed.clear();
+    {
+        QFile file(root + "/c/file");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QTRY_VERIFY(collect().contains(root + "/c/file"));
+
+    // directories renamed inside the tree are watched under their new name
+    changed.clear();
+    QVERIFY(testDir.rename("c", "d"));
+    QTRY_VERIFY(collect().contains(root + "/d"));
+    changed.clear();
+    {
+        QFile file(root + "/d/other");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QTRY_VERIFY(collect().contains(root + "/d/other"));
+
+    QVERIFY(watcher.removeRecursivePath(root));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+    QVERIFY(!watcher.removeRecursivePath(root));
+    changed.clear();
+    changedSpy.clear();
+    {
+        QFile file(root + "/a/unwatched");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QTest::qWait(200);
+    QVERIFY(collect().isEmpty());
+}
+#endif
+
 QTEST_MAIN(tst_QFileSystemWatcher)
 #include "tst_qfilesystemwatcher.moc"
@@ -166,6 +166,12 @@ void tst_QResourceEngine::compressedResource()
     QCOMPARE(data.size(), expectedData.size());
     QCOMPARE(data, expectedData);
 
+    if (compressionAlgo != QResource::NoCompression) {
+        // small resources are decompressed only once
+        QCOMPARE(static_cast<const void *>(resource.uncompressedData().constData()),
+                 static_cast<const void *>(data.constData()));
+    }
+
     // decompression through the engine
     data = f.readAll();
     QCOMPARE(data.size(), expectedData.size());
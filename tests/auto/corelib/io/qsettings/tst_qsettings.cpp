@@ -138,6 +138,7 @@ private slots:
     void testChildKeysAndGroups_data();
     void testChildKeysAndGroups();
     void testUpdateRequestEvent();
+    void testBackgroundSync();
     void testThreadSafety();
     void testEmptyData();
     void testEmptyKey();
@@ -2023,6 +2024,56 @@ void tst_QSettings::testUpdateRequestEvent()
     QDir::setCurrent(oldCur);
 }
 
+void tst_QSettings::testBackgroundSync()
+{
+    const QString oldCur = QDir::currentPath();
+    QString dataLocation = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QVERIFY(QDir::root().mkpath(dataLocation));
+    QDir::setCurrent(dataLocation);
+
+    QFile::remove("bar");
+    QVERIFY(!QFile::exists("bar"));
+
+    {
+        QSettings settings1("bar", QSettings::IniFormat);
+        QVERIFY(!settings1.isBackgroundSyncEnabled());
+        settings1.setBackgroundSyncEnabled(true);
+        QVERIFY(settings1.isBackgroundSyncEnabled());
+        for (int i = 0; i < 100; ++i)
+            settings1.setValue(QString("key%1").arg(i), i);
+        QCOMPARE(QFileInfo("bar").size(), qint64(0));
+
+        QTRY_VERIFY(QFileInfo("bar").size() > 0);
+
+        // Other objects for the same file see the changes right away
+        settings1.setValue("key100", 100);
+        QSettings settings2("bar", QSettings::IniFormat);
+        QCOMPARE(settings2.value("key100").toInt(), 100);
+        settings1.remove("key0");
+        // the destructor queues the write instead of doing it
+    }
+
+    auto fileContents = []() {
+        QFile file("bar");
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+    QTRY_VERIFY(!fileContents().contains("key0="));
+    QVERIFY(fileContents().contains("key99=99"));
+    QVERIFY(fileContents().contains("key100=100"));
+
+    {
+        QSettings settings3("bar", QSettings::IniFormat);
+        settings3.setBackgroundSyncEnabled(true);
+        settings3.clear();
+        // sync() still writes on the calling thread
+        settings3.sync();
+        QCOMPARE(settings3.status(), QSettings::NoError);
+        QCOMPARE(QFileInfo("bar").size(), qint64(0));
+    }
+
+    QDir::setCurrent(oldCur);
+}
+
 const int NumIterations = 5;
 const int NumThreads = 4;
 int numThreadSafetyFailures;
@@ -17,6 +17,7 @@ SUBDIRS=\
     qobject \
     qpointer \
     qsharedmemory \
+    qsharedmemorychannel \
     qsignalblocker \
     qsignalmapper \
     qsocketnotifier \
@@ -48,7 +49,10 @@ android: SUBDIRS -= qeventdispatcher
 # This test is only applicable on Windows
 !win32*: SUBDIRS -= qwineventnotifier
 
-android|uikit: SUBDIRS -= qobject qsharedmemory qsystemsemaphore
+android|uikit: SUBDIRS -= qobject qsharedmemory qsharedmemorychannel qsystemsemaphore
+
+!qtConfig(sharedmemory): SUBDIRS -= \
+    qsharedmemorychannel
 
 !qtConfig(systemsemaphore): SUBDIRS -= \
     qsystemsemaphore
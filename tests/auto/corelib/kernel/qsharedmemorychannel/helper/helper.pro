@@ -0,0 +1,6 @@
+QT = core
+TARGET = sharedmemorychannel_helper
+
+SOURCES += main.cpp
+
+load(qt_test_helper)
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSharedMemoryChannel>
+#include <QtCore/QThread>
+#include <stdio.h>
+
+// Tells the test that the channel is set up; it kills some modes after that.
+static void ready()
+{
+    puts("ready");
+    fflush(stdout);
+}
+
+static void waitToBeKilled()
+{
+    for (;;)
+        QThread::sleep(1);
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+    if (arguments.size() < 3) {
+        fprintf(stderr, "usage: %s writer|stalled-writer|partial-reader <key> [count]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const QString mode = arguments.at(1);
+    QSharedMemoryChannel channel(arguments.at(2));
+
+    if (mode == QLatin1String("writer")) {
+        // writes numbered messages and exits
+        if (!channel.open(QIODevice::WriteOnly))
+            return EXIT_FAILURE;
+        ready();
+        const int count = arguments.value(3).toInt();
+        for (int i = 0; i < count; ++i) {
+            if (!channel.writeMessage(QByteArray::number(i).repeated(i % 13)))
+                return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (mode == QLatin1String("stalled-writer")) {
+        // writes one message and stays attached until killed
+        if (!channel.open(QIODevice::WriteOnly) || !channel.writeMessage("stalled"))
+            return EXIT_FAILURE;
+        ready();
+        waitToBeKilled();
+    }
+
+    if (mode == QLatin1String("partial-reader")) {
+        // reads part of the first message and stays attached until killed
+        if (!channel.open(QIODevice::ReadOnly) || !channel.waitForReadyRead(-1))
+            return EXIT_FAILURE;
+        char buffer[10];
+        if (channel.read(buffer, sizeof buffer) != qint64(sizeof buffer))
+            return EXIT_FAILURE;
+        ready();
+        waitToBeKilled();
+    }
+
+    fprintf(stderr, "unknown mode %s\n", qPrintable(mode));
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,5 @@
+CONFIG += testcase
+QT = core testlib
+
+SOURCES += tst_qsharedmemorychannel.cpp
+TARGET = tst_qsharedmemorychannel
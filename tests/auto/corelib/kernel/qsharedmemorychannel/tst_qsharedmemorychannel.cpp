@@ -0,0 +1,605 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QSharedMemoryChannel>
+#include <QtCore/QSharedMemory>
+#include <QtCore/QThread>
+#if QT_CONFIG(process)
+#include <QtCore/QProcess>
+#endif
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void createAndOpen();
+    void invalidModes();
+    void messages();
+    void mixStreamAndMessages();
+    void wrapAround();
+    void bytesAvailable();
+    void writerCloses();
+    void readerCloses();
+    void reopenReader();
+    void threadedStream();
+    void threadedMessages();
+    void corruptRecordLength();
+    void invalidCapacity();
+    void multipleWriters();
+    void multipleReaders();
+#if QT_CONFIG(process)
+    void crossProcess();
+    void deadWriter();
+    void deadReader();
+#endif
+
+private:
+    QString uniqueKey();
+#if QT_CONFIG(process)
+    bool startHelper(QProcess &process, const QStringList &arguments);
+#endif
+    int keyCounter = 0;
+};
+
+QString tst_QSharedMemoryChannel::uniqueKey()
+{
+    return QStringLiteral("tst_qsharedmemorychannel_%1_%2")
+            .arg(QCoreApplication::applicationPid()).arg(++keyCounter);
+}
+
+void tst_QSharedMemoryChannel::createAndOpen()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QCOMPARE(writer.key(), key);
+    QCOMPARE(writer.capacity(), 0);
+    QVERIFY2(writer.create(1000, QIODevice::WriteOnly), qPrintable(writer.errorString()));
+    QVERIFY(writer.isOpen());
+    QVERIFY(writer.isSequential());
+    QCOMPARE(writer.capacity(), 1024);
+
+    // a second writer is refused
+    QSharedMemoryChannel writer2(key);
+    QVERIFY(!writer2.open(QIODevice::WriteOnly));
+    QVERIFY(!writer2.errorString().isEmpty());
+
+    // creating it again is refused too
+    QSharedMemoryChannel creator(key);
+    QVERIFY(!creator.create(1000, QIODevice::ReadOnly));
+
+    QSharedMemoryChannel reader(key);
+    QVERIFY2(reader.open(QIODevice::ReadOnly), qPrintable(reader.errorString()));
+    QCOMPARE(reader.capacity(), 1024);
+
+    QSharedMemoryChannel reader2(key);
+    QVERIFY(!reader2.open(QIODevice::ReadOnly));
+
+    QSharedMemoryChannel missing(uniqueKey());
+    QVERIFY(!missing.open(QIODevice::ReadOnly));
+    QVERIFY(!missing.errorString().isEmpty());
+}
+
+void tst_QSharedMemoryChannel::invalidModes()
+{
+    QSharedMemoryChannel channel(uniqueKey());
+    QVERIFY(!channel.create(1024, QIODevice::ReadWrite));
+    QVERIFY(!channel.create(1024, QIODevice::NotOpen));
+    QVERIFY(!channel.create(0, QIODevice::WriteOnly));
+    QVERIFY(!channel.create(-1, QIODevice::WriteOnly));
+    QVERIFY(!channel.isOpen());
+}
+
+void tst_QSharedMemoryChannel::messages()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    QVERIFY(!reader.hasPendingMessages());
+    QVERIFY(reader.readMessage().isNull());
+
+    QVERIFY(writer.writeMessage("first"));
+    QVERIFY(writer.writeMessage(QByteArray()));
+    QVERIFY(writer.writeMessage("third"));
+    // too large for the ring
+    QVERIFY(!writer.writeMessage(QByteArray(256, 'x')));
+
+    QVERIFY(reader.hasPendingMessages());
+    QCOMPARE(reader.readMessage(), QByteArray("first"));
+    const QByteArray empty = reader.readMessage();
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(reader.readMessage(), QByteArray("third"));
+}
+
+void tst_QSharedMemoryChannel::mixStreamAndMessages()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    QCOMPARE(writer.write("hello world"), 11);
+    QVERIFY(writer.writeMessage("second"));
+    QCOMPARE(reader.read(5), QByteArray("hello"));
+    QCOMPARE(reader.readMessage(), QByteArray(" world"));
+    QCOMPARE(reader.readMessage(), QByteArray("second"));
+
+    // reading as a stream concatenates messages
+    QVERIFY(writer.writeMessage("abc"));
+    QVERIFY(writer.writeMessage(QByteArray()));
+    QVERIFY(writer.writeMessage("def"));
+    QCOMPARE(reader.readAll(), QByteArray("abcdef"));
+    QVERIFY(!reader.hasPendingMessages());
+}
+
+void tst_QSharedMemoryChannel::wrapAround()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(64, QIODevice::WriteOnly));
+    QCOMPARE(writer.capacity(), 64);
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    // odd sizes, so that record headers and payloads straddle the end
+    for (int i = 0; i < 1000; ++i) {
+        const QByteArray message(i % 29 + 1, char('a' + i % 26));
+        QVERIFY(writer.writeMessage(message));
+        if (i % 2)
+            QVERIFY(writer.writeMessage(QByteArray::number(i)));
+        QCOMPARE(reader.readMessage(), message);
+        if (i % 2)
+            QCOMPARE(reader.readMessage(), QByteArray::number(i));
+    }
+    QVERIFY(!reader.hasPendingMessages());
+}
+
+void tst_QSharedMemoryChannel::bytesAvailable()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(1024, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    QCOMPARE(reader.bytesAvailable(), 0);
+    QCOMPARE(writer.bytesToWrite(), 0);
+    QVERIFY(!writer.waitForBytesWritten(0));
+    QVERIFY(!reader.waitForReadyRead(10));
+
+    writer.write(QByteArray(100, 'a'));
+    writer.writeMessage(QByteArray(50, 'b'));
+    QCOMPARE(reader.bytesAvailable(), 150);
+    QCOMPARE(writer.bytesToWrite(), 150);
+    QVERIFY(reader.waitForReadyRead(0));
+
+    QCOMPARE(reader.read(30).size(), 30);
+    QCOMPARE(reader.bytesAvailable(), 120);
+    QCOMPARE(writer.bytesToWrite(), 120);
+
+    reader.readAll();
+    QCOMPARE(reader.bytesAvailable(), 0);
+    QCOMPARE(writer.bytesToWrite(), 0);
+}
+
+void tst_QSharedMemoryChannel::writerCloses()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(1024, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    writer.write("last words");
+    writer.close();
+
+    // the data written before closing is still there
+    QVERIFY(reader.waitForReadyRead(0));
+    QCOMPARE(reader.readAll(), QByteArray("last words"));
+    QVERIFY(!reader.waitForReadyRead(-1));
+    char c;
+    QCOMPARE(reader.read(&c, 1), qint64(-1));
+}
+
+void tst_QSharedMemoryChannel::readerCloses()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(64, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    reader.close();
+
+    // does not block, even though the message does not fit
+    QVERIFY(!writer.writeMessage(QByteArray(60, 'x')));
+    QCOMPARE(writer.write("x"), qint64(-1));
+}
+
+void tst_QSharedMemoryChannel::reopenReader()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(1024, QIODevice::WriteOnly));
+
+    {
+        QSharedMemoryChannel reader(key);
+        QVERIFY(reader.open(QIODevice::ReadOnly));
+        QVERIFY(writer.writeMessage("discarded"));
+        QVERIFY(writer.writeMessage("kept"));
+        QCOMPARE(reader.read(3), QByteArray("dis"));
+    }
+    QVERIFY(!writer.writeMessage("no reader"));
+
+    // a new reader starts at a message boundary, and the writer can write
+    // again
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QCOMPARE(reader.readMessage(), QByteArray("kept"));
+    QVERIFY(writer.writeMessage("more"));
+    QCOMPARE(reader.readMessage(), QByteArray("more"));
+}
+
+static QByteArray pattern(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i * 7 + i / 251);
+    return data;
+}
+
+void tst_QSharedMemoryChannel::threadedStream()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.create(4096, QIODevice::ReadOnly));
+
+    const QByteArray data = pattern(1024 * 1024);
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QSharedMemoryChannel writer(key);
+        if (!writer.open(QIODevice::WriteOnly))
+            return;
+        // uneven chunks, some larger than the ring
+        qsizetype pos = 0;
+        for (int i = 0; pos < data.size(); ++i) {
+            const qsizetype chunk = qMin(qsizetype(1 + (i * 997) % 10000), data.size() - pos);
+            if (writer.write(data.constData() + pos, chunk) != chunk)
+                return;
+            pos += chunk;
+        }
+    }));
+    thread->start();
+
+    QByteArray received;
+    while (reader.waitForReadyRead(5000))
+        received += reader.readAll();
+    QVERIFY(thread->wait(5000));
+    received += reader.readAll();
+    QCOMPARE(received.size(), data.size());
+    QCOMPARE(received, data);
+}
+
+void tst_QSharedMemoryChannel::threadedMessages()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly));
+
+    const int count = 20000;
+    QList<QByteArray> received;
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QSharedMemoryChannel reader(key);
+        if (!reader.open(QIODevice::ReadOnly))
+            return;
+        while (received.size() < count && reader.waitForReadyRead(5000)) {
+            while (reader.hasPendingMessages())
+                received << reader.readMessage();
+        }
+    }));
+    thread->start();
+
+    // the writer blocks until the reader has attached and makes room
+    for (int i = 0; i < count; ++i)
+        QVERIFY(writer.writeMessage(QByteArray::number(i).repeated(i % 7)));
+    QVERIFY(thread->wait(5000));
+
+    QCOMPARE(received.size(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(received.at(i), QByteArray::number(i).repeated(i % 7));
+}
+
+void tst_QSharedMemoryChannel::corruptRecordLength()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly));
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QVERIFY(writer.writeMessage("good"));
+    QVERIFY(writer.writeMessage("corrupted message"));
+    QCOMPARE(reader.readMessage(), QByteArray("good"));
+
+    // make the length of the second record point past what was written
+    QSharedMemory memory(key);
+    QVERIFY(memory.attach());
+    const QByteArray raw = QByteArray::fromRawData(static_cast<const char *>(memory.constData()),
+                                                   memory.size());
+    const qsizetype payload = raw.indexOf("corrupted message");
+    QVERIFY(payload >= 4);
+    const quint32 length = 1000;
+    memcpy(static_cast<char *>(memory.data()) + payload - 4, &length, sizeof length);
+
+    QVERIFY(reader.readMessage().isNull());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.hasPendingMessages());
+    char buffer[16];
+    QCOMPARE(reader.read(buffer, sizeof buffer), qint64(-1));
+    QVERIFY(!reader.waitForReadyRead(0));
+}
+
+void tst_QSharedMemoryChannel::invalidCapacity()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly));
+
+    // the capacity follows the magic number and the version
+    QSharedMemory memory(key);
+    QVERIFY(memory.attach());
+    quint32 *capacity = static_cast<quint32 *>(memory.data()) + 2;
+    QCOMPARE(*capacity, quint32(256));
+
+    for (quint32 invalid : {quint32(200), quint32(32), quint32(512), quint32(0)}) {
+        *capacity = invalid;
+        QSharedMemoryChannel reader(key);
+        QVERIFY(!reader.open(QIODevice::ReadOnly));
+        QVERIFY(!reader.errorString().isEmpty());
+    }
+    *capacity = 256;
+    QSharedMemoryChannel reader(key);
+    QVERIFY2(reader.open(QIODevice::ReadOnly), qPrintable(reader.errorString()));
+}
+
+void tst_QSharedMemoryChannel::multipleWriters()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.create(256, QIODevice::ReadOnly, QSharedMemoryChannel::MultipleWriters));
+    QCOMPARE(reader.options(), QSharedMemoryChannel::MultipleWriters);
+
+    // a second reader is still refused
+    QSharedMemoryChannel reader2(key);
+    QVERIFY(!reader2.open(QIODevice::ReadOnly));
+
+    const int writerCount = 4;
+    const int count = 2000;
+    QList<QThread *> threads;
+    for (int w = 0; w < writerCount; ++w) {
+        threads << QThread::create([&key, w] {
+            QSharedMemoryChannel writer(key);
+            if (!writer.open(QIODevice::WriteOnly))
+                return;
+            for (int i = 0; i < count; ++i) {
+                QByteArray message = QByteArray::number(w) + ':' + QByteArray::number(i);
+                if (!writer.writeMessage(message.repeated(1 + i % 5)))
+                    return;
+            }
+        });
+        threads.last()->start();
+    }
+
+    QList<int> next(writerCount, 0);
+    int received = 0;
+    while (received < writerCount * count && reader.waitForReadyRead(5000)) {
+        while (reader.hasPendingMessages()) {
+            const QByteArray message = reader.readMessage();
+            const int w = message.left(message.indexOf(':')).toInt();
+            QVERIFY(w >= 0 && w < writerCount);
+            const QByteArray expected = QByteArray::number(w) + ':' + QByteArray::number(next[w]);
+            QCOMPARE(message, expected.repeated(1 + next[w] % 5));
+            ++next[w];
+            ++received;
+        }
+    }
+    for (QThread *thread : qAsConst(threads))
+        QVERIFY(thread->wait(5000));
+    qDeleteAll(threads);
+    QCOMPARE(received, writerCount * count);
+
+    // all writers are gone now
+    QVERIFY(!reader.waitForReadyRead(0));
+    QCOMPARE(reader.read(1), QByteArray());
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QSharedMemoryChannel::multipleReaders()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(256, QIODevice::WriteOnly, QSharedMemoryChannel::MultipleReaders));
+
+    QSharedMemoryChannel writer2(key);
+    QVERIFY(!writer2.open(QIODevice::WriteOnly));
+
+    const int readerCount = 3;
+    const int count = 6000;
+    QList<QList<QByteArray>> received(readerCount);
+    QList<QThread *> threads;
+    for (int r = 0; r < readerCount; ++r) {
+        threads << QThread::create([&key, &received, r] {
+            QSharedMemoryChannel reader(key);
+            if (!reader.open(QIODevice::ReadOnly))
+                return;
+            // alternate between whole messages and reading them in pieces
+            while (reader.waitForReadyRead(5000)) {
+                if (r == 0) {
+                    while (reader.hasPendingMessages())
+                        received[r] << reader.readMessage();
+                } else {
+                    char c;
+                    while (reader.getChar(&c)) {
+                        const QByteArray rest = reader.readMessage();
+                        received[r] << c + rest;
+                    }
+                }
+            }
+        });
+        threads.last()->start();
+    }
+
+    const auto message = [](int i) { return QByteArray::number(i) + QByteArray(i % 5, '-'); };
+    for (int i = 0; i < count; ++i)
+        QVERIFY(writer.writeMessage(message(i)));
+    writer.close();
+    for (QThread *thread : qAsConst(threads))
+        QVERIFY(thread->wait(10000));
+    qDeleteAll(threads);
+
+    // every message arrives exactly once, and each reader gets its share in order
+    QList<bool> seen(count, false);
+    for (const QList<QByteArray> &messages : qAsConst(received)) {
+        int previous = -1;
+        for (const QByteArray &m : messages) {
+            const int i = m.split('-').first().toInt();
+            QVERIFY(i > previous && i < count);
+            QCOMPARE(m, message(i));
+            QVERIFY(!seen.at(i));
+            seen[i] = true;
+            previous = i;
+        }
+    }
+    QVERIFY(!seen.contains(false));
+}
+
+#if QT_CONFIG(process)
+bool tst_QSharedMemoryChannel::startHelper(QProcess &process, const QStringList &arguments)
+{
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.start(QStringLiteral("sharedmemorychannel_helper"), arguments);
+    if (!process.waitForStarted()) {
+        qWarning("Could not start helper: %s", qPrintable(process.errorString()));
+        return false;
+    }
+    // the helper prints a line once it has set up its end of the channel
+    return process.waitForReadyRead(10000) && process.readLine().trimmed() == "ready";
+}
+
+void tst_QSharedMemoryChannel::crossProcess()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.create(1024, QIODevice::ReadOnly));
+
+    const int count = 10000;
+    QProcess helper;
+    QVERIFY(startHelper(helper, {QStringLiteral("writer"), key, QString::number(count)}));
+
+    int received = 0;
+    while (reader.waitForReadyRead(10000)) {
+        while (reader.hasPendingMessages()) {
+            QCOMPARE(reader.readMessage(), QByteArray::number(received).repeated(received % 13));
+            ++received;
+        }
+    }
+    QCOMPARE(received, count);
+    QVERIFY(helper.waitForFinished(10000));
+    QCOMPARE(helper.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(helper.exitCode(), 0);
+}
+
+void tst_QSharedMemoryChannel::deadWriter()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel reader(key);
+    QVERIFY(reader.create(256, QIODevice::ReadOnly));
+
+    QProcess helper;
+    QVERIFY(startHelper(helper, {QStringLiteral("stalled-writer"), key}));
+    QVERIFY(reader.waitForReadyRead(5000));
+    QCOMPARE(reader.readMessage(), QByteArray("stalled"));
+
+    helper.kill();
+    QVERIFY(helper.waitForFinished(5000));
+
+    // the reader notices the end of the stream instead of waiting forever
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!reader.waitForReadyRead(-1));
+    QVERIFY(timer.elapsed() < 5000);
+    char c;
+    QCOMPARE(reader.read(&c, 1), qint64(-1));
+
+    // and a new writer can take over
+    QSharedMemoryChannel writer(key);
+    QVERIFY2(writer.open(QIODevice::WriteOnly), qPrintable(writer.errorString()));
+    QVERIFY(writer.writeMessage("replacement"));
+    QVERIFY(reader.waitForReadyRead(5000));
+    QCOMPARE(reader.readMessage(), QByteArray("replacement"));
+}
+
+void tst_QSharedMemoryChannel::deadReader()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel writer(key);
+    QVERIFY(writer.create(64, QIODevice::WriteOnly));
+    QVERIFY(writer.writeMessage("abcdefghijklmnopqrstuvwxyz"));
+
+    QProcess helper;
+    QVERIFY(startHelper(helper, {QStringLiteral("partial-reader"), key}));
+    helper.kill();
+    QVERIFY(helper.waitForFinished(5000));
+
+    // filling the ring fails once the dead reader has been noticed
+    QElapsedTimer timer;
+    timer.start();
+    int written = 0;
+    while (writer.writeMessage(QByteArray(20, 'x')))
+        QVERIFY(++written < 10);
+    QVERIFY(timer.elapsed() < 5000);
+    QVERIFY(!writer.errorString().isEmpty());
+
+    // a new reader can attach, and skips what the dead one started reading
+    QSharedMemoryChannel reader(key);
+    QVERIFY2(reader.open(QIODevice::ReadOnly), qPrintable(reader.errorString()));
+    QCOMPARE(reader.bytesAvailable(), writer.bytesToWrite());
+    for (int i = 0; i < written; ++i)
+        QCOMPARE(reader.readMessage(), QByteArray(20, 'x'));
+    QVERIFY(!reader.hasPendingMessages());
+    QCOMPARE(writer.bytesToWrite(), 0);
+    QVERIFY(writer.writeMessage("again"));
+    QCOMPARE(reader.readMessage(), QByteArray("again"));
+}
+#endif
+
+QTEST_APPLESS_MAIN(tst_QSharedMemoryChannel)
+#include "tst_qsharedmemorychannel.moc"
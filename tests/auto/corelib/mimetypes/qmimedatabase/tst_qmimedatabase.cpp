@@ -27,6 +27,8 @@
 ****************************************************************************/
 
 #include <qmimedatabase.h>
+#include <private/qmimeprovider_p.h>
+#include <private/qmimetype_p.h>
 
 #include "qstandardpaths.h"
 
@@ -41,6 +43,7 @@
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTemporaryDir>
 #include <QtCore/QTextStream>
+#include <QtCore/QXmlStreamReader>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <QtTest/QtTest>
@@ -670,6 +673,7 @@ void tst_QMimeDatabase::knownSuffix()
     QCOMPARE(db.suffixForFileName(QString::fromLatin1("foo.TAR")), QString::fromLatin1("TAR")); // preserve case
     QCOMPARE(db.suffixForFileName(QString::fromLatin1("foo.flatpakrepo")), QString::fromLatin1("flatpakrepo"));
     QCOMPARE(db.suffixForFileName(QString::fromLatin1("foo.anim2")), QString()); // the glob is anim[0-9], no way to extract the extension without expensive regexp capturing
+    QCOMPARE(db.suffixForFileName(QString::fromLatin1("foo,v")), QString()); // the glob is *,v, which is not an extension
 }
 
 void tst_QMimeDatabase::symlinkToFifo() // QTBUG-48529
@@ -869,6 +873,160 @@ void tst_QMimeDatabase::fromThreads()
     QVERIFY(tp.waitForDone(60000));
 }
 
+#if QT_CONFIG(mimetype_database)
+// A file name that the glob pattern matches, e.g. "file.txt" for "*.txt"
+static QString fileNameForPattern(const QString &pattern)
+{
+    QString fileName;
+    for (int i = 0; i < pattern.size(); ++i) {
+        const QChar c = pattern.at(i);
+        if (c == QLatin1Char('*')) {
+            fileName += QLatin1String("file");
+        } else if (c == QLatin1Char('?')) {
+            fileName += QLatin1Char('x');
+        } else if (c == QLatin1Char('[') && i + 1 < pattern.size()) {
+            const int end = pattern.indexOf(QLatin1Char(']'), i + 2);
+            if (end == -1)
+                break;
+            fileName += pattern.at(i + 1); // the first character of the set, e.g. '0' for [0-9]
+            i = end;
+        } else {
+            fileName += c;
+        }
+    }
+    return fileName;
+}
+
+static QString fileNameMatches(QMimeProviderBase &provider, const QString &fileName)
+{
+    QMimeGlobMatchResult result;
+    provider.addFileNameMatches(fileName, result);
+    QStringList mimeTypes = result.m_matchingMimeTypes;
+    mimeTypes.sort();
+    return fileName + QLatin1String(": weight ") + QString::number(result.m_weight)
+            + QLatin1String(", suffix length ") + QString::number(result.m_knownSuffixLength)
+            + QLatin1String(", ") + mimeTypes.join(QLatin1Char(' '));
+}
+
+// Data matching the string magic rules at the top level of the database, e.g. "%PDF-"
+static QList<QByteArray> magicSamples()
+{
+    QList<QByteArray> samples;
+    QFile file(QLatin1String(RESOURCE_PREFIX "packages/freedesktop.org.xml"));
+    if (!file.open(QIODevice::ReadOnly))
+        return samples;
+    QXmlStreamReader reader(&file);
+    int matchDepth = 0;
+    while (!reader.atEnd()) {
+        const QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::EndElement && reader.name() == QLatin1String("magic")) {
+            matchDepth = 0;
+        } else if (token == QXmlStreamReader::StartElement) {
+            if (reader.name() == QLatin1String("magic")) {
+                matchDepth = 1;
+            } else if (reader.name() == QLatin1String("match") && matchDepth++ == 1) {
+                const QXmlStreamAttributes attributes = reader.attributes();
+                const QString value = attributes.value(QLatin1String("value")).toString();
+                // Escape sequences and masks are not worth decoding here
+                if (attributes.value(QLatin1String("type")) != QLatin1String("string")
+                    || attributes.hasAttribute(QLatin1String("mask")) || value.contains(QLatin1Char('\\'))) {
+                    continue;
+                }
+                const int offset = attributes.value(QLatin1String("offset")).split(QLatin1Char(':')).first().toInt();
+                samples.append(QByteArray(offset, ' ') + value.toUtf8());
+            }
+        } else if (token == QXmlStreamReader::EndElement && reader.name() == QLatin1String("match")) {
+            --matchDepth;
+        }
+    }
+    return samples;
+}
+#endif // QT_CONFIG(mimetype_database)
+
+void tst_QMimeDatabase::builtinDatabaseCache()
+{
+#if !QT_CONFIG(mimetype_database)
+    QSKIP("This test requires the built-in MIME database");
+#else
+    // Compile the built-in database into a cache, and check that the binary provider
+    // reading it gives the same answers as the XML provider it was written from
+    QTemporaryDir cacheDir;
+    QVERIFY2(cacheDir.isValid(), qPrintable(cacheDir.errorString()));
+    QMimeXMLProvider xmlProvider(nullptr, QMimeXMLProvider::InternalDatabase);
+    QVERIFY(xmlProvider.writeCache(cacheDir.path()));
+    QMimeBinaryProvider binaryProvider(nullptr, cacheDir.path(), QMimeBinaryProvider::InternalDatabase);
+    QVERIFY(binaryProvider.isValid());
+    QVERIFY(binaryProvider.isInternalDatabase());
+
+    QList<QMimeType> xmlMimeTypes;
+    xmlProvider.addAllMimeTypes(xmlMimeTypes);
+    QList<QMimeType> binaryMimeTypes;
+    binaryProvider.addAllMimeTypes(binaryMimeTypes);
+    const auto sortedNames = [](const QList<QMimeType> &mimeTypes) {
+        QStringList names;
+        for (const QMimeType &mime : mimeTypes)
+            names.append(mime.name());
+        names.sort();
+        return names;
+    };
+    QVERIFY(xmlMimeTypes.size() > 500);
+    QCOMPARE(sortedNames(binaryMimeTypes), sortedNames(xmlMimeTypes));
+
+    for (const QMimeType &mime : qAsConst(xmlMimeTypes)) {
+        const QString name = mime.name();
+        QVERIFY2(binaryProvider.mimeTypeForName(name).isValid(), qPrintable(name));
+
+        QStringList xmlParents;
+        xmlProvider.addParents(name, xmlParents);
+        QStringList binaryParents;
+        binaryProvider.addParents(name, binaryParents);
+        QCOMPARE(binaryParents, xmlParents);
+
+        QStringList xmlAliases;
+        xmlProvider.addAliases(name, xmlAliases);
+        xmlAliases.sort();
+        QStringList binaryAliases;
+        binaryProvider.addAliases(name, binaryAliases);
+        binaryAliases.sort();
+        QCOMPARE(binaryAliases, xmlAliases);
+        for (const QString &alias : qAsConst(xmlAliases))
+            QCOMPARE(binaryProvider.resolveAlias(alias), xmlProvider.resolveAlias(alias));
+
+        // Icons come from the cache, comments and glob lists from the embedded XML
+        QMimeTypePrivate details;
+        details.name = name;
+        binaryProvider.loadMimeTypePrivate(details);
+        binaryProvider.loadIcon(details);
+        binaryProvider.loadGenericIcon(details);
+        const QMimeType binaryMime(details);
+        QCOMPARE(binaryMime.iconName(), mime.iconName());
+        QCOMPARE(binaryMime.genericIconName(), mime.genericIconName());
+        QCOMPARE(binaryMime.comment(), mime.comment());
+        QCOMPARE(binaryMime.globPatterns(), mime.globPatterns());
+
+        for (const QString &pattern : mime.globPatterns()) {
+            const QString fileName = fileNameForPattern(pattern);
+            QCOMPARE(fileNameMatches(binaryProvider, fileName), fileNameMatches(xmlProvider, fileName));
+            const QString upperFileName = fileName.toUpper();
+            QCOMPARE(fileNameMatches(binaryProvider, upperFileName), fileNameMatches(xmlProvider, upperFileName));
+        }
+    }
+
+    const QList<QByteArray> samples = magicSamples();
+    QVERIFY(samples.size() > 100);
+    for (const QByteArray &data : samples) {
+        int xmlAccuracy = 0;
+        QMimeType xmlCandidate;
+        xmlProvider.findByMagic(data, &xmlAccuracy, xmlCandidate);
+        int binaryAccuracy = 0;
+        QMimeType binaryCandidate;
+        binaryProvider.findByMagic(data, &binaryAccuracy, binaryCandidate);
+        QCOMPARE(binaryCandidate.name(), xmlCandidate.name());
+        QCOMPARE(binaryAccuracy, xmlAccuracy);
+    }
+#endif
+}
+
 #if QT_CONFIG(process)
 
 enum {
@@ -1065,6 +1223,10 @@ void tst_QMimeDatabase::installNewLocalMimeType()
     QCOMPARE(db.mimeTypeForName(QLatin1String("text/x-SuSE-ymu")).comment(), QString("URL of a YaST Meta Package"));
     checkHasMimeType("text/x-suse-ymp");
 
+    // The local magic rule has the higher priority, the global one must not override it
+    QCOMPARE(db.mimeTypeForData(QByteArray("<ar>")).name(),
+             QString::fromLatin1("application/vnd.qt.test-archive"));
+
     { // QTBUG-85436
         QMimeType objcsrc = db.mimeTypeForName(QStringLiteral("text/x-objcsrc"));
         QVERIFY(objcsrc.isValid());
@@ -68,6 +68,7 @@ private slots:
     void knownSuffix();
     void symlinkToFifo();
     void fromThreads();
+    void builtinDatabaseCache();
 
     // shared-mime-info test suite
 
@@ -30,7 +30,13 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
+#if QT_CONFIG(library)
+#include <private/qpluginmetadatacache_p.h>
+#endif
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
 
@@ -52,12 +58,17 @@ public slots:
 
 private slots:
     void usingTwoFactoriesFromSameDir();
+#if QT_CONFIG(library)
+    void metaDataCache();
+#endif
 };
 
 static const char binFolderC[] = "bin";
 
 void tst_QFactoryLoader::initTestCase()
 {
+    // keep the plugin metadata cache out of the user's cache directory
+    QStandardPaths::setTestModeEnabled(true);
 #ifdef Q_OS_ANDROID
     directory = QEXTRACTTESTDATA("android_test_data");
     QVERIFY(directory);
@@ -92,5 +103,80 @@ void tst_QFactoryLoader::usingTwoFactoriesFromSameDir()
     QCOMPARE(plugin2->pluginName(), QLatin1String("Plugin2 ok"));
 }
 
+#if QT_CONFIG(library)
+void tst_QFactoryLoader::metaDataCache()
+{
+#ifdef Q_OS_ANDROID
+    QSKIP("The plugins cannot be copied on Android");
+#endif
+    if (qEnvironmentVariableIsSet("QT_NO_PLUGIN_CACHE"))
+        QSKIP("The plugin cache is disabled");
+
+    // copy plugin1 into a directory of its own
+    const QDir binDir(QFINDTESTDATA(binFolderC));
+    QString pluginFile;
+    for (const QString &entry : binDir.entryList(QDir::Files)) {
+        if (entry.contains(QLatin1String("plugin1")) && QLibrary::isLibrary(entry))
+            pluginFile = entry;
+    }
+    QVERIFY2(!pluginFile.isEmpty(), "Unable to locate plugin1");
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString dir = tempDir.path() + QLatin1Char('/') + QLatin1String(binFolderC);
+    QVERIFY(QDir().mkpath(dir));
+    const QString copy = QFileInfo(dir + QLatin1Char('/') + pluginFile).absoluteFilePath();
+    QVERIFY(QFile::copy(binDir.absoluteFilePath(pluginFile), copy));
+    const QString canonicalCopy = QFileInfo(copy).canonicalFilePath();
+    QFile::remove(QPluginMetaDataCache::cacheFilePath(dir));
+
+    const QStringList libraryPaths = QCoreApplication::libraryPaths();
+    auto cleanup = qScopeGuard([&] {
+        QCoreApplication::setLibraryPaths(libraryPaths);
+        QFile::remove(QPluginMetaDataCache::cacheFilePath(dir));
+    });
+    QCoreApplication::setLibraryPaths(QStringList(tempDir.path()));
+    const QString suffix = QLatin1Char('/') + QLatin1String(binFolderC);
+
+    // the first scan fills the cache
+    {
+        QFactoryLoader loader(PluginInterface1_iid, suffix);
+        QCOMPARE(loader.metaData().size(), 1);
+    }
+    QVERIFY(QFile::exists(QPluginMetaDataCache::cacheFilePath(dir)));
+    {
+        QPluginMetaDataCache cache(dir);
+        const QPluginMetaDataCache::Entry *entry = cache.find(canonicalCopy);
+        QVERIFY(entry);
+        QVERIFY(entry->isPlugin);
+        QCOMPARE(entry->metaData.value(QLatin1String("IID")).toString(),
+                 QLatin1String(PluginInterface1_iid));
+
+        // the cache is believed as long as the file is unchanged
+        cache.insert(canonicalCopy, { false, QJsonObject(), QLatin1String("cached") });
+        QVERIFY(cache.save());
+    }
+    {
+        QFactoryLoader loader(PluginInterface1_iid, suffix);
+        QCOMPARE(loader.metaData().size(), 0);
+    }
+
+    // changing the file invalidates its entry
+    {
+        QFile file(copy);
+        QVERIFY(file.open(QIODevice::Append));
+        QCOMPARE(file.write("x", 1), qint64(1));
+    }
+    {
+        QPluginMetaDataCache cache(dir);
+        QVERIFY(!cache.find(canonicalCopy));
+    }
+    {
+        QFactoryLoader loader(PluginInterface1_iid, suffix);
+        QCOMPARE(loader.metaData().size(), 1);
+    }
+}
+#endif
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
@@ -80,6 +80,7 @@ private slots:
     void readLineMaxlen();
     void readLinesFromBufferCRCR();
     void readLineInto();
+    void readLineView();
 
     // all
     void readAllFromDevice_data();
@@ -661,6 +662,40 @@ void tst_QTextStream::readLineInto()
     QVERIFY(line.isEmpty());
 }
 
+void tst_QTextStream::readLineView()
+{
+    QByteArray data = "1\r\n\n3";
+
+    QTextStream ts(&data);
+    QStringView line = ts.readLineView();
+    QCOMPARE(line, u"1");
+    line = ts.readLineView();
+    QVERIFY(!line.isNull());
+    QVERIFY(line.isEmpty());
+    QCOMPARE(ts.readLineView(), u"3");
+    QVERIFY(ts.readLineView().isNull());
+
+    // compare against readLine() over a file larger than the internal buffer
+    QFile file(m_rfc3261FilePath);
+    QVERIFY(file.open(QFile::ReadOnly));
+    QTextStream reference(&file);
+    QStringList expected;
+    while (!reference.atEnd())
+        expected << reference.readLine();
+    QVERIFY(file.seek(0));
+
+    ts.setDevice(&file);
+    QStringList lines;
+    for (QStringView view = ts.readLineView(); !view.isNull(); view = ts.readLineView())
+        lines << view.toString();
+    QCOMPARE(lines, expected);
+
+    ErrorDevice errorDevice;
+    QVERIFY(errorDevice.open(QIODevice::ReadOnly));
+    ts.setDevice(&errorDevice);
+    QVERIFY(ts.readLineView().isNull());
+}
+
 // ------------------------------------------------------------------------------
 void tst_QTextStream::readLineFromString_data()
 {
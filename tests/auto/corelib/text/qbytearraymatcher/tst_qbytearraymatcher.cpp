@@ -43,7 +43,11 @@ class tst_QByteArrayMatcher : public QObject
 private slots:
     void interface();
     void indexIn();
+    void indexInAllPositions();
     void staticByteArrayMatcher();
+    void multiMatcher_data();
+    void multiMatcher();
+    void multiMatcherRandom();
 };
 
 void tst_QByteArrayMatcher::interface()
@@ -137,6 +141,36 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+void tst_QByteArrayMatcher::indexInAllPositions()
+{
+    // needles of all lengths on either side of the vector boundaries, behind
+    // decoys that only match their first and last bytes
+    for (int length = 2; length <= 140; ++length) {
+        QByteArray needle(length, 'n');
+        needle.front() = 'F';
+        needle.back() = 'L';
+        QByteArray decoy = needle;
+        decoy[length / 2] = 'x';
+        if (length == 2)
+            decoy = "FxL";
+
+        const QByteArrayMatcher matcher(needle);
+        for (int pos = 0; pos < 70; ++pos) {
+            QByteArray haystack;
+            while (haystack.size() < pos)
+                haystack += decoy;
+            haystack.truncate(pos);
+            haystack += needle + QByteArray(pos % 7, 'L');
+
+            QCOMPARE(matcher.indexIn(haystack), pos);
+            QCOMPARE(haystack.indexOf(needle), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos + 1), -1);
+            QCOMPARE(haystack.indexOf(needle, pos + 1), -1);
+            QCOMPARE(matcher.indexIn(haystack.constData(), pos + length - 1), -1);
+        }
+    }
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -208,6 +242,91 @@ void tst_QByteArrayMatcher::staticByteArrayMatcher()
 
 }
 
+void tst_QByteArrayMatcher::multiMatcher_data()
+{
+    QTest::addColumn<QByteArrayList>("patterns");
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("indexIn");
+    QTest::addColumn<int>("matchedPattern");
+
+    QTest::newRow("no-patterns") << QByteArrayList() << QByteArray("foo") << 0 << -1 << -1;
+    QTest::newRow("empty-haystack") << QByteArrayList{ "foo" } << QByteArray() << 0 << -1 << -1;
+    QTest::newRow("empty-pattern") << QByteArrayList{ "foo", "" } << QByteArray("bar") << 1 << 1 << 1;
+    QTest::newRow("empty-pattern-end") << QByteArrayList{ "" } << QByteArray("bar") << 3 << 3 << 0;
+    QTest::newRow("empty-pattern-past-end") << QByteArrayList{ "" } << QByteArray("bar") << 4 << -1 << -1;
+    QTest::newRow("single") << QByteArrayList{ "foo" } << QByteArray("barfoo") << 0 << 3 << 0;
+    QTest::newRow("first-wins") << QByteArrayList{ "bar", "foo" } << QByteArray("xfoobar") << 0 << 1 << 1;
+    QTest::newRow("from") << QByteArrayList{ "bar", "foo" } << QByteArray("xfoobar") << 2 << 4 << 0;
+    QTest::newRow("negative-from") << QByteArrayList{ "bar", "foo" } << QByteArray("xfoobar") << -5 << 1 << 1;
+    QTest::newRow("leftmost-longer") << QByteArrayList{ "cd", "abcde" } << QByteArray("xabcde") << 0 << 1 << 1;
+    QTest::newRow("same-start") << QByteArrayList{ "abcd", "ab", "abc" } << QByteArray("xabcd") << 0 << 1 << 0;
+    QTest::newRow("duplicates") << QByteArrayList{ "b", "ab", "ab" } << QByteArray("xab") << 0 << 1 << 1;
+    QTest::newRow("suffix") << QByteArrayList{ "she", "he", "hers" } << QByteArray("ahers") << 0 << 1 << 1;
+    QTest::newRow("failure-links") << QByteArrayList{ "aab", "abx" } << QByteArray("aaabx") << 0 << 1 << 0;
+    QTest::newRow("no-match") << QByteArrayList{ "abc", "bcd" } << QByteArray("abdbcabd") << 0 << -1 << -1;
+    QTest::newRow("binary") << QByteArrayList{ QByteArray("\0\xff", 2) } << QByteArray("a\xff\0\xff", 4) << 0 << 2 << 0;
+}
+
+void tst_QByteArrayMatcher::multiMatcher()
+{
+    QFETCH(QByteArrayList, patterns);
+    QFETCH(QByteArray, haystack);
+    QFETCH(int, from);
+    QFETCH(int, indexIn);
+    QFETCH(int, matchedPattern);
+
+    QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    qsizetype matched = -2;
+    QCOMPARE(matcher.indexIn(haystack, from, &matched), indexIn);
+    QCOMPARE(matched, matchedPattern);
+
+    QMultiByteArrayMatcher other;
+    QCOMPARE(other.indexIn(haystack, from), -1);
+    other = matcher;
+    QCOMPARE(other.indexIn(haystack, from), indexIn);
+    matcher.setPatterns(QByteArrayList());
+    QCOMPARE(matcher.indexIn(haystack, from), -1);
+    QCOMPARE(other.indexIn(haystack, from), indexIn);
+}
+
+void tst_QByteArrayMatcher::multiMatcherRandom()
+{
+    // compare with searching for each pattern in turn, over a small alphabet so
+    // that patterns overlap a lot
+    QRandomGenerator rng(42);
+    auto randomBytes = [&rng](int length) {
+        QByteArray bytes(length, Qt::Uninitialized);
+        for (char &c : bytes)
+            c = char('a' + rng.bounded(6));
+        return bytes;
+    };
+
+    for (int round = 0; round < 500; ++round) {
+        QByteArrayList patterns;
+        for (int i = rng.bounded(1, 8); i > 0; --i)
+            patterns.append(randomBytes(rng.bounded(1, 6)));
+        const QByteArray haystack = randomBytes(rng.bounded(40));
+        const QMultiByteArrayMatcher matcher(patterns);
+
+        for (int from = 0; from <= haystack.size(); ++from) {
+            qsizetype expected = -1;
+            qsizetype expectedPattern = -1;
+            for (int i = 0; i < patterns.size(); ++i) {
+                const qsizetype pos = haystack.indexOf(patterns.at(i), from);
+                if (pos >= 0 && (expected < 0 || pos < expected)) {
+                    expected = pos;
+                    expectedPattern = i;
+                }
+            }
+            qsizetype matched;
+            QCOMPARE(matcher.indexIn(haystack, from, &matched), expected);
+            QCOMPARE(matched, expectedPattern);
+        }
+    }
+}
+
 #undef LONG_STRING_256
 #undef LONG_STRING_128
 #undef LONG_STRING__64
@@ -46,6 +46,10 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sort_data();
+    void sort();
+    void sortKeys();
 };
 
 static bool dpointer_is_null(QCollator &c)
@@ -354,6 +358,80 @@ void tst_QCollator::state()
     QCOMPARE(c.locale(), QLocale(QLocale::NorwegianBokmal));
 }
 
+// Enough strings for the sorting to be split up, with plenty of ties:
+static QStringList sortSample()
+{
+    const char16_t pieces[][4] = {
+        u"a", u"A", u"b", u"\u00e4", u"\u00c4", u"z", u"1", u"10", u"9", u"-", u" ", u"\u00f8",
+        u"\u00e5", u"th", u"o", u"O"
+    };
+    QStringList result;
+    quint32 state = 4711;
+    for (int i = 0; i < 20000; ++i) {
+        QString string;
+        const int length = i % 7;
+        for (int j = 0; j < length; ++j) {
+            state = state * 1664525 + 1013904223;
+            string += QStringView(pieces[(state >> 16) % std::size(pieces)]);
+        }
+        result << string;
+    }
+    return result;
+}
+
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<bool>("caseInsensitive");
+    QTest::addColumn<bool>("numericMode");
+    QTest::addColumn<bool>("ignorePunctuation");
+
+    for (const char *locale : { "C", "en_US", "de_DE", "sv_SE" }) {
+        QTest::addRow("%s", locale) << QString(locale) << false << false << false;
+#if QT_CONFIG(icu)
+        QTest::addRow("%s-options", locale) << QString(locale) << true << true << true;
+#endif
+    }
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QString, locale);
+    QFETCH(bool, caseInsensitive);
+    QFETCH(bool, numericMode);
+    QFETCH(bool, ignorePunctuation);
+
+    QCollator collator((QLocale(locale)));
+#if !QT_CONFIG(icu)
+    if (collator.locale() != QLocale() && collator.locale() != QLocale::c())
+        QSKIP("Only the default and C locales are reliably supported without ICU");
+#endif
+    collator.setCaseSensitivity(caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    collator.setNumericMode(numericMode);
+    collator.setIgnorePunctuation(ignorePunctuation);
+
+    QStringList expected = sortSample();
+    QStringList sorted = expected;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+    collator.sort(sorted);
+    QCOMPARE(sorted, expected);
+
+    QStringList single = { QStringLiteral("single") };
+    collator.sort(single);
+    QCOMPARE(single, QStringList{ QStringLiteral("single") });
+}
+
+void tst_QCollator::sortKeys()
+{
+    QCollator collator(QLocale("en_US"));
+    const QStringList strings = sortSample();
+    const QList<QCollatorSortKey> keys = collator.sortKeys(strings);
+    QCOMPARE(keys.size(), strings.size());
+    for (qsizetype i = 0; i < strings.size(); i += 97)
+        QCOMPARE(keys.at(i).compare(collator.sortKey(strings.at(i))), 0);
+    QVERIFY(collator.sortKeys(QStringList()).isEmpty());
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
@@ -85,6 +85,11 @@ private slots:
     void testInvalidWildcard_data();
     void testInvalidWildcard();
 
+    void sharedCompiledPattern();
+    void regularExpressionSet_data();
+    void regularExpressionSet();
+    void regularExpressionSetInvalid();
+
 private:
     void provideRegularExpressions();
 };
@@ -2294,6 +2299,114 @@ void tst_QRegularExpression::testInvalidWildcard()
     QCOMPARE(re.isValid(), isValid);
 }
 
+void tst_QRegularExpression::sharedCompiledPattern()
+{
+    // Equal patterns share their compiled code; make sure each object
+    // still behaves independently, including after being changed.
+    const QString pattern = QStringLiteral("(\\w+)@(\\w+)\\.com");
+    QRegularExpression re1(pattern);
+    QRegularExpression re2(pattern);
+    QVERIFY(re1.isValid());
+    QVERIFY(re2.isValid());
+    QCOMPARE(re1.captureCount(), 2);
+    QCOMPARE(re2.captureCount(), 2);
+
+    re2.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(!re1.match(QLatin1String("JOE@EXAMPLE.COM")).hasMatch());
+    QVERIFY(re2.match(QLatin1String("JOE@EXAMPLE.COM")).hasMatch());
+
+    re1 = QRegularExpression();
+    const QRegularExpressionMatch match = QRegularExpression(pattern).match(QLatin1String("joe@example.com"));
+    QVERIFY(match.hasMatch());
+    QCOMPARE(match.captured(2), QLatin1String("example"));
+
+    // a pattern with more groups than any matched before in this thread
+    QRegularExpression many(QStringLiteral("(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)(l)"));
+    const QRegularExpressionMatch manyMatch = many.match(QLatin1String("abcdefghijkl"));
+    QVERIFY(manyMatch.hasMatch());
+    QCOMPARE(manyMatch.lastCapturedIndex(), 12);
+    QCOMPARE(manyMatch.captured(12), QLatin1String("l"));
+}
+
+void tst_QRegularExpression::regularExpressionSet_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<int>("options");
+    QTest::addColumn<QString>("subject");
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("expected");
+
+    const QStringList rules = { "^ERROR\\b", "^WARN(ING)?\\b", "time(out|d out)", "(x)\\1" };
+    QTest::newRow("first") << rules << 0 << "ERROR: disk full" << 0 << 0;
+    QTest::newRow("second") << rules << 0 << "WARNING: low memory" << 0 << 1;
+    QTest::newRow("third") << rules << 0 << "connection timed out" << 0 << 2;
+    QTest::newRow("backreference") << rules << 0 << "a xx b" << 0 << 3;
+    QTest::newRow("earliest-wins") << rules << 0 << "xx then timeout" << 0 << 3;
+    QTest::newRow("earliest-wins-2") << rules << 0 << "timeout then xx" << 0 << 2;
+    QTest::newRow("none") << rules << 0 << "all good" << 0 << -1;
+    QTest::newRow("offset") << rules << 0 << "ERROR timeout" << 1 << 2;
+    QTest::newRow("negative-offset") << rules << 0 << "ERROR timeout" << -7 << 2;
+    QTest::newRow("bad-offset") << rules << 0 << "ERROR" << 10 << -1;
+    QTest::newRow("tie-order") << QStringList{ "abc", "ab", "a" } << 0 << "xxabc" << 0 << 0;
+    QTest::newRow("tie-order-2") << QStringList{ "a", "ab", "abc" } << 0 << "xxabc" << 0 << 0;
+    QTest::newRow("case-insensitive") << QStringList{ "foo", "bar" }
+                                      << int(QRegularExpression::CaseInsensitiveOption)
+                                      << "BAR" << 0 << 1;
+    QTest::newRow("dont-capture") << QStringList{ "(f)oo", "(b)ar" }
+                                  << int(QRegularExpression::DontCaptureOption)
+                                  << "a bar" << 0 << 1;
+    QTest::newRow("named") << QStringList{ "(?<n>q)\\k<n>", "(?<n>z)" } << 0 << "qq z" << 0 << 0;
+    QTest::newRow("recursion") << QStringList{ "\\((?:[^()]|(?R))*\\)", "y" } << 0 << "(())y" << 0 << 0;
+    QTest::newRow("verb") << QStringList{ "(*CR)(?m)a$", "b" } << 0 << "a\rb" << 0 << 0;
+    QTest::newRow("hash") << QStringList{ "#include", "x" } << 0 << "a #include x" << 0 << 0;
+    QTest::newRow("extended-comment") << QStringList{ "a # comment", "b" }
+                                      << int(QRegularExpression::ExtendedPatternSyntaxOption)
+                                      << "b a" << 0 << 1;
+    QTest::newRow("inline-extended-comment") << QStringList{ "(?x) a # comment", "b" } << 0
+                                             << "b a" << 0 << 1;
+    QTest::newRow("empty-set") << QStringList() << 0 << "anything" << 0 << -1;
+}
+
+void tst_QRegularExpression::regularExpressionSet()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(int, options);
+    QFETCH(QString, subject);
+    QFETCH(int, offset);
+    QFETCH(int, expected);
+
+    const QRegularExpressionSet set(patterns, QRegularExpression::PatternOptions(options));
+    QVERIFY(set.isValid());
+    QCOMPARE(set.size(), patterns.size());
+    QCOMPARE(set.patterns(), patterns);
+    QCOMPARE(set.matchingPattern(subject, offset), expected);
+
+    // must agree with matching the patterns one by one
+    int reference = -1;
+    qsizetype referenceStart = -1;
+    for (int i = 0; i < patterns.size(); ++i) {
+        const QRegularExpression re(patterns.at(i), QRegularExpression::PatternOptions(options));
+        const QRegularExpressionMatch match = re.match(subject, offset);
+        if (match.hasMatch() && (reference == -1 || match.capturedStart() < referenceStart)) {
+            reference = i;
+            referenceStart = match.capturedStart();
+        }
+    }
+    QCOMPARE(reference, expected);
+}
+
+void tst_QRegularExpression::regularExpressionSetInvalid()
+{
+    const QRegularExpressionSet set({ "fine", "(broken" });
+    QVERIFY(!set.isValid());
+    QCOMPARE(set.matchingPattern(u"fine"), -1);
+
+    const QRegularExpressionSet empty;
+    QVERIFY(empty.isValid());
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.matchingPattern(u"anything"), -1);
+}
+
 QTEST_APPLESS_MAIN(tst_QRegularExpression)
 
 #include "tst_qregularexpression.moc"
@@ -3680,6 +3680,17 @@ void tst_QString::toDouble_data()
 
     QTest::newRow( "ok10" ) << QString("1.") << 1.0 << true;
     QTest::newRow( "ok11" ) << QString(".1") << 0.1 << true;
+    QTest::newRow( "ok12" ) << QString("-0") << -0.0 << true;
+    QTest::newRow( "ok13" ) << QString("+42.5") << 42.5 << true;
+    QTest::newRow( "ok14" ) << QString("123456789012345") << 123456789012345.0 << true;
+    QTest::newRow( "ok15" ) << QString("1234567890123456789") << 1234567890123456789.0 << true;
+    QTest::newRow( "ok16" ) << QString("9007199254740993") << 9007199254740993.0 << true;
+    QTest::newRow( "ok17" ) << QString("1e22") << 1e22 << true;
+    QTest::newRow( "ok18" ) << QString("1e23") << 1e23 << true;
+    QTest::newRow( "ok19" ) << QString("1.7976931348623157e308") << 1.7976931348623157e308 << true;
+    QTest::newRow( "ok20" ) << QString("4.9e-324") << 4.9e-324 << true;
+    QTest::newRow( "ok21" ) << QString("0.000000000000000000000001") << 1e-24 << true;
+    QTest::newRow( "ok22" ) << QString::fromUtf16(u"\x2212" "2.25E-3") << -2.25e-3 << true;
 
     QTest::newRow( "wrong00" ) << QString("123.45 ") << 123.45 << true;
     QTest::newRow( "wrong01" ) << QString(" 123.45 ") << 123.45 << true;
@@ -3691,6 +3702,10 @@ void tst_QString::toDouble_data()
     QTest::newRow( "wrong05" ) << QString("abc") << 0.0 << false;
     QTest::newRow( "wrong06" ) << QString() << 0.0 << false;
     QTest::newRow( "wrong07" ) << QString("") << 0.0 << false;
+    QTest::newRow( "wrong08" ) << QString("1e") << 0.0 << false;
+    QTest::newRow( "wrong09" ) << QString("1e+") << 0.0 << false;
+    QTest::newRow( "wrong10" ) << QString("-") << 0.0 << false;
+    QTest::newRow( "wrong11" ) << QString("1.5.2") << 0.0 << false;
 }
 
 void tst_QString::toDouble()
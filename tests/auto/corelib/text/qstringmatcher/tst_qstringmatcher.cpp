@@ -41,6 +41,11 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void indexInAllPositions();
+    void multiMatcher_data();
+    void multiMatcher();
+    void multiMatcherRandom();
+    void multiMatcherLarge();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -148,6 +153,167 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::indexInAllPositions()
+{
+    // needles of all lengths on either side of the vector boundaries, behind
+    // decoys that only match their first and last characters
+    for (int length = 2; length <= 140; ++length) {
+        QString needle(length, u'\x4e2d');
+        needle.front() = u'F';
+        needle.back() = u'\x0141';
+        QString decoy = needle;
+        decoy[length / 2] = u'x';
+        if (length == 2)
+            decoy = QStringLiteral("Fx\x0141");
+
+        const QStringMatcher matcher(needle);
+        for (int pos = 0; pos < 40; ++pos) {
+            QString haystack;
+            while (haystack.size() < pos)
+                haystack += decoy;
+            haystack.truncate(pos);
+            haystack += needle + QString(pos % 7, u'\x0141');
+
+            QCOMPARE(matcher.indexIn(haystack), pos);
+            QCOMPARE(haystack.indexOf(needle), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos + 1), -1);
+            QCOMPARE(haystack.indexOf(needle, pos + 1), -1);
+            QCOMPARE(matcher.indexIn(QStringView(haystack).left(pos + length - 1)), -1);
+        }
+    }
+}
+
+void tst_QStringMatcher::multiMatcher_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("cs");
+    QTest::addColumn<int>("indexIn");
+    QTest::addColumn<int>("matchedPattern");
+
+    const int sensitive = Qt::CaseSensitive;
+    const int insensitive = Qt::CaseInsensitive;
+    QTest::newRow("no-patterns") << QStringList() << QString("foo") << 0 << sensitive << -1 << -1;
+    QTest::newRow("empty-pattern") << QStringList{ "foo", "" } << QString("bar") << 1 << sensitive << 1 << 1;
+    QTest::newRow("first-wins") << QStringList{ "bar", "foo" } << QString("xfoobar") << 0 << sensitive << 1 << 1;
+    QTest::newRow("from") << QStringList{ "bar", "foo" } << QString("xfoobar") << 2 << sensitive << 4 << 0;
+    QTest::newRow("leftmost-longer") << QStringList{ "cd", "abcde" } << QString("xabcde") << 0 << sensitive << 1 << 1;
+    QTest::newRow("same-start") << QStringList{ "abcd", "ab" } << QString("xabcd") << 0 << sensitive << 1 << 0;
+    QTest::newRow("sensitive") << QStringList{ "Foo", "bar" } << QString("fooBar foo bar") << 0 << sensitive << 11 << 1;
+    QTest::newRow("insensitive") << QStringList{ "Foo", "bar" } << QString("fOOBar foo bar") << 0 << insensitive << 0 << 0;
+    QTest::newRow("insensitive-latin1") << QStringList{ QString::fromUtf8("STRASSE"), QString::fromUtf8("Ärger") }
+                                        << QString::fromUtf8("kein äRGER") << 0 << insensitive << 5 << 1;
+    QTest::newRow("non-latin1") << QStringList{ QString::fromUtf8("日本"), QString::fromUtf8("本語") }
+                                << QString::fromUtf8("は日本語") << 0 << sensitive << 1 << 0;
+    QTest::newRow("surrogates") << QStringList{ QString::fromUtf8("\U0001F600") }
+                                << QString::fromUtf8("ab\U0001F601\U0001F600") << 0 << sensitive << 4 << 0;
+    QTest::newRow("surrogates-insensitive") << QStringList{ QString::fromUtf8("\U00010400") }
+                                            << QString::fromUtf8("a\U00010428") << 0 << insensitive << 1 << 0;
+}
+
+void tst_QStringMatcher::multiMatcher()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, haystack);
+    QFETCH(int, from);
+    QFETCH(int, cs);
+    QFETCH(int, indexIn);
+    QFETCH(int, matchedPattern);
+
+    QMultiStringMatcher matcher(patterns, Qt::CaseSensitivity(cs));
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitivity(cs));
+    qsizetype matched = -2;
+    QCOMPARE(matcher.indexIn(haystack, from, &matched), indexIn);
+    QCOMPARE(matched, matchedPattern);
+
+    QMultiStringMatcher other;
+    QCOMPARE(other.caseSensitivity(), Qt::CaseSensitive);
+    QCOMPARE(other.indexIn(haystack, from), -1);
+    other.setPatterns(patterns);
+    other.setCaseSensitivity(Qt::CaseSensitivity(cs));
+    QCOMPARE(other.indexIn(haystack, from), indexIn);
+}
+
+void tst_QStringMatcher::multiMatcherRandom()
+{
+    // compare with searching for each pattern in turn, over a small alphabet so
+    // that patterns overlap a lot
+    QRandomGenerator rng(42);
+    auto randomString = [&rng](int length) {
+        static const char16_t alphabet[] = u"aAb\x00e9\x00c9\x4e2d";
+        QString string(length, Qt::Uninitialized);
+        for (QChar &c : string)
+            c = alphabet[rng.bounded(6)];
+        return string;
+    };
+
+    for (Qt::CaseSensitivity cs : { Qt::CaseSensitive, Qt::CaseInsensitive }) {
+        for (int round = 0; round < 500; ++round) {
+            QStringList patterns;
+            for (int i = rng.bounded(1, 8); i > 0; --i)
+                patterns.append(randomString(rng.bounded(1, 5)));
+            const QString haystack = randomString(rng.bounded(40));
+            const QMultiStringMatcher matcher(patterns, cs);
+
+            for (int from = 0; from <= haystack.size(); ++from) {
+                qsizetype expected = -1;
+                qsizetype expectedPattern = -1;
+                for (int i = 0; i < patterns.size(); ++i) {
+                    const qsizetype pos = haystack.indexOf(patterns.at(i), from, cs);
+                    if (pos >= 0 && (expected < 0 || pos < expected)) {
+                        expected = pos;
+                        expectedPattern = i;
+                    }
+                }
+                qsizetype matched;
+                QCOMPARE(matcher.indexIn(haystack, from, &matched), expected);
+                QCOMPARE(matched, expectedPattern);
+            }
+        }
+    }
+}
+
+void tst_QStringMatcher::multiMatcherLarge()
+{
+    // many patterns over thousands of symbols, so that the complete DFA would
+    // be too large and the failure links get followed instead
+    QRandomGenerator rng(42);
+    auto randomString = [&rng](int length) {
+        QString string(length, Qt::Uninitialized);
+        for (QChar &c : string)
+            c = QChar(0x4e00 + rng.bounded(4000));
+        return string;
+    };
+
+    QStringList patterns;
+    for (int i = 0; i < 3000; ++i)
+        patterns.append(randomString(rng.bounded(2, 6)));
+    // pieces of the patterns, so that partial matches get abandoned a lot
+    QString haystack;
+    while (haystack.size() < 2000) {
+        const QString &pattern = patterns.at(rng.bounded(int(patterns.size())));
+        haystack += pattern.left(rng.bounded(1, int(pattern.size()) + 1));
+    }
+    const QMultiStringMatcher matcher(patterns);
+
+    for (int from = 0; from <= haystack.size(); from += 97) {
+        qsizetype expected = -1;
+        qsizetype expectedPattern = -1;
+        for (int i = 0; i < patterns.size(); ++i) {
+            const qsizetype pos = haystack.indexOf(patterns.at(i), from);
+            if (pos >= 0 && (expected < 0 || pos < expected)) {
+                expected = pos;
+                expectedPattern = i;
+            }
+        }
+        qsizetype matched;
+        QCOMPARE(matcher.indexIn(haystack, from, &matched), expected);
+        QCOMPARE(matched, expectedPattern);
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
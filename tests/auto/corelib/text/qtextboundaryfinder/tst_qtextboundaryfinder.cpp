@@ -57,6 +57,9 @@ private slots:
     void lineBoundaries_manual_data();
     void lineBoundaries_manual();
 
+    void asciiRuns_data();
+    void asciiRuns();
+
     void emptyText_data();
     void emptyText();
     void fastConstructor();
@@ -655,6 +658,99 @@ void tst_QTextBoundaryFinder::lineBoundaries_manual()
     doTestData(testString, expectedEndPositions, QTextBoundaryFinder::Line, QTextBoundaryFinder::EndOfItem);
 }
 
+void tst_QTextBoundaryFinder::asciiRuns_data()
+{
+    QTest::addColumn<QString>("run");
+    QTest::addColumn<QString>("before");
+    QTest::addColumn<QString>("after");
+
+    // letters only keep the line breaker in its LB28 fast path, digits interrupt it
+    const QString letters = QStringLiteral("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    const QString alnum = QStringLiteral("The0quick1brown2fox3jumps4over5the6lazy7dog89");
+
+    const struct {
+        const char *name;
+        QString text;
+    } neighbours[] = {
+        { "nothing", QString() },
+        { "latin-1", QStringLiteral("\u00e9") },
+        { "combining", QStringLiteral("\u0301") },
+        { "crlf", QStringLiteral("\r\n") },
+        { "prepend", QStringLiteral("\u0600") },
+        { "space", QStringLiteral(" ") },
+        { "ideograph", QStringLiteral("\u4e00") },
+        { "surrogates", QStringLiteral("\U0001F600") },
+    };
+
+    for (const auto &before : neighbours) {
+        for (const auto &after : neighbours) {
+            QTest::addRow("letters, %s, %s", before.name, after.name) << letters << before.text << after.text;
+            QTest::addRow("alnum, %s, %s", before.name, after.name) << alnum << before.text << after.text;
+        }
+    }
+}
+
+static QList<QPair<int, QTextBoundaryFinder::BoundaryReasons>>
+boundaries(QTextBoundaryFinder::BoundaryType type, const QString &text)
+{
+    QList<QPair<int, QTextBoundaryFinder::BoundaryReasons>> result;
+    QTextBoundaryFinder finder(type, text);
+    do {
+        result.append(qMakePair(finder.position(), finder.boundaryReasons()));
+    } while (finder.toNextBoundary() != -1);
+    return result;
+}
+
+void tst_QTextBoundaryFinder::asciiRuns()
+{
+    QFETCH(QString, run);
+    QFETCH(QString, before);
+    QFETCH(QString, after);
+
+    // Runs of ASCII are skipped in blocks of 8 characters, so try every length up to a few
+    // blocks to make the run end at every offset within a block. The reference replaces the
+    // ASCII characters with non-ASCII ones of the same break classes, which takes the path
+    // that looks up the properties of each character.
+    for (int length = 1; length <= run.size(); ++length) {
+        const QString ascii = before + run.left(length) + after;
+        QString reference = ascii;
+        for (int i = before.size(); i != before.size() + length; ++i) {
+            const QChar ch = reference.at(i);
+            if (ch.isDigit())
+                reference[i] = QChar(0x0660 + ch.digitValue()); // ARABIC-INDIC DIGIT ZERO..NINE
+            else
+                reference[i] = QChar(0x00e9);   // LATIN SMALL LETTER E WITH ACUTE
+        }
+
+        for (auto type : { QTextBoundaryFinder::Grapheme, QTextBoundaryFinder::Word,
+                           QTextBoundaryFinder::Line }) {
+            QVERIFY2(boundaries(type, ascii) == boundaries(type, reference),
+                     qPrintable(QString::fromLatin1("type %1, length %2").arg(type).arg(length)));
+        }
+    }
+
+    // spot-check the reference against what UAX #14 and #29 say about the neighbours
+    const QString ascii = before + run + after;
+    QTextBoundaryFinder grapheme(QTextBoundaryFinder::Grapheme, ascii);
+    QTextBoundaryFinder line(QTextBoundaryFinder::Line, ascii);
+    const int start = before.size();
+    const int end = start + run.size();
+    for (int i = start + 1; i < end; ++i) {
+        grapheme.setPosition(i);
+        QVERIFY(grapheme.isAtBoundary());
+    }
+    grapheme.setPosition(start);
+    QCOMPARE(grapheme.isAtBoundary(), before != QStringLiteral("\u0600"));
+    grapheme.setPosition(end);
+    QCOMPARE(grapheme.isAtBoundary(), after != QStringLiteral("\u0301"));
+    if (run.at(0).isLetter() && before.isEmpty()) {
+        for (int i = 1; i < end; ++i) {
+            line.setPosition(i);
+            QVERIFY(!(line.boundaryReasons() & QTextBoundaryFinder::BreakOpportunity));
+        }
+    }
+}
+
 Q_DECLARE_METATYPE(QTextBoundaryFinder)
 
 void tst_QTextBoundaryFinder::emptyText_data()
@@ -58,6 +58,8 @@ private Q_SLOTS:
     void transitionEachZone();
     void checkOffset_data();
     void checkOffset();
+    void offsetsFromUtc_data();
+    void offsetsFromUtc();
     void stressTest();
     void windowsId();
     void isValidId_data();
@@ -67,6 +69,7 @@ private Q_SLOTS:
     void utcTest();
     void icuTest();
     void tzTest();
+    void tzLookupTable();
     void macTest();
     void darwinTypes();
     void winTest();
@@ -677,6 +680,52 @@ void tst_QTimeZone::checkOffset()
     QCOMPARE(zone.isDaylightTime(when), dstOffset != 0);
 }
 
+void tst_QTimeZone::offsetsFromUtc_data()
+{
+    QTest::addColumn<QByteArray>("zoneName");
+
+    const char *zones[] = {
+        "Etc/UTC", "UTC+05:30", "Europe/Berlin", "America/New_York",
+        "Australia/Sydney", "Asia/Kolkata", "Africa/Casablanca"
+    };
+    for (const char *zone : zones) {
+        if (QTimeZone(zone).isValid())
+            QTest::newRow(zone) << QByteArray(zone);
+        else
+            qWarning("Skipping %s test as zone is invalid", zone);
+    }
+}
+
+void tst_QTimeZone::offsetsFromUtc()
+{
+    QFETCH(QByteArray, zoneName);
+    const QTimeZone zone(zoneName);
+
+    // Every few days for several centuries, in order and then shuffled:
+    const qint64 first = QDate(1850, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    const qint64 last = QDate(2250, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    QList<qint64> times;
+    for (qint64 msecs = first; msecs < last; msecs += 97 * 3600 * 1000LL)
+        times.append(msecs);
+    QList<qint64> shuffled = times;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(4711));
+
+    for (const QList<qint64> &list : { times, shuffled }) {
+        QList<int> offsets(list.size());
+        zone.offsetsFromUtc(list.constData(), offsets.data(), list.size());
+        for (qsizetype i = 0; i < list.size(); ++i) {
+            const QDateTime when = QDateTime::fromMSecsSinceEpoch(list.at(i), Qt::UTC);
+            if (offsets.at(i) != zone.offsetFromUtc(when))
+                qDebug() << "Failing for" << zoneName << "at" << when;
+            QCOMPARE(offsets.at(i), zone.offsetFromUtc(when));
+        }
+    }
+
+    QList<int> offsets(1, -1);
+    QTimeZone().offsetsFromUtc(times.constData(), offsets.data(), 1);
+    QCOMPARE(offsets.at(0), 0);
+}
+
 void tst_QTimeZone::availableTimeZoneIds()
 {
     if (debug) {
@@ -1254,6 +1303,45 @@ void tst_QTimeZone::tzTest()
 #endif // QT_BUILD_INTERNAL && Q_OS_UNIX && !Q_OS_DARWIN
 }
 
+void tst_QTimeZone::tzLookupTable()
+{
+#if defined QT_BUILD_INTERNAL && defined Q_OS_UNIX && !defined Q_OS_DARWIN && !defined Q_OS_ANDROID
+    // The precomputed offsets must match what data() finds, in particular on
+    // either side of each transition and of the ends of the tables:
+    const qint64 first = QDate(1900, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    const qint64 last = QDate(2150, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    QList<QByteArray> zones = QTimeZone::availableTimeZoneIds();
+    zones << "MET-1METDST-2,M3.5.0/02:00:00,M10.5.0/03:00:00" << "BRT+3";
+    for (const QByteArray &zone : qAsConst(zones)) {
+        const QTzTimeZonePrivate tzp(zone);
+        if (!tzp.isValid())
+            continue;
+        QList<qint64> times;
+        for (qint64 msecs = first; msecs < last; msecs += 41 * 24 * 3600 * 1000LL)
+            times << msecs;
+        for (QTimeZonePrivate::Data tran = tzp.nextTransition(first);
+             tran.atMSecsSinceEpoch != QTimeZonePrivate::invalidMSecs()
+                 && tran.atMSecsSinceEpoch < last;
+             tran = tzp.nextTransition(tran.atMSecsSinceEpoch)) {
+            times << tran.atMSecsSinceEpoch - 1 << tran.atMSecsSinceEpoch
+                  << tran.atMSecsSinceEpoch + 1;
+        }
+        QList<int> offsets(times.size());
+        tzp.offsetsFromUtc(times.constData(), offsets.data(), times.size());
+        for (qsizetype i = 0; i < times.size(); ++i) {
+            const qint64 msecs = times.at(i);
+            const QTimeZonePrivate::Data data = tzp.data(msecs);
+            if (tzp.offsetFromUtc(msecs) != data.offsetFromUtc)
+                qDebug() << "Failing for" << zone << "at" << msecs;
+            QCOMPARE(tzp.offsetFromUtc(msecs), data.offsetFromUtc);
+            QCOMPARE(tzp.standardTimeOffset(msecs), data.standardTimeOffset);
+            QCOMPARE(tzp.daylightTimeOffset(msecs), data.daylightTimeOffset);
+            QCOMPARE(offsets.at(i), data.offsetFromUtc);
+        }
+    }
+#endif // QT_BUILD_INTERNAL && Q_OS_UNIX && !Q_OS_DARWIN
+}
+
 void tst_QTimeZone::macTest()
 {
 #if defined(QT_BUILD_INTERNAL) && defined(Q_OS_DARWIN)
@@ -63,6 +63,7 @@ private slots:
     void isEmpty();
     void swap();
     void fill();
+    void fillRandom();
     void toggleBit_data();
     void toggleBit();
     // operator &=
@@ -89,6 +90,10 @@ private slots:
 
     void toUInt32_data();
     void toUInt32();
+
+    void findNextSetBit_data();
+    void findNextSetBit();
+    void longArrays();
 };
 
 void tst_QBitArray::size_data()
@@ -258,6 +263,30 @@ void tst_QBitArray::fill()
     }
 }
 
+void tst_QBitArray::fillRandom()
+{
+    QRandomGenerator rng(42);
+    for (int round = 0; round < 500; ++round) {
+        const int size = rng.bounded(1, 300);
+        QBitArray a(size);
+        QList<bool> expected(size);
+        for (int i = 0; i < size; ++i) {
+            const bool bit = rng.bounded(2);
+            a.setBit(i, bit);
+            expected[i] = bit;
+        }
+        const int begin = rng.bounded(size + 1);
+        const int end = rng.bounded(begin, size + 1);
+        const bool value = rng.bounded(2);
+        a.fill(value, begin, end);
+        for (int i = begin; i < end; ++i)
+            expected[i] = value;
+        for (int i = 0; i < size; ++i)
+            QCOMPARE(a.testBit(i), expected.at(i));
+        QCOMPARE(a.size(), size);
+    }
+}
+
 void tst_QBitArray::toggleBit_data()
 {
     QTest::addColumn<int>("index");
@@ -760,5 +789,100 @@ void tst_QBitArray::toUInt32()
     QCOMPARE(ok, check);
 }
 
+void tst_QBitArray::findNextSetBit_data()
+{
+    QTest::addColumn<QBitArray>("data");
+    QTest::addColumn<QList<qsizetype>>("setBits");
+
+    QTest::newRow("null") << QBitArray() << QList<qsizetype>();
+    QTest::newRow("empty") << QBitArray(0) << QList<qsizetype>();
+    QTest::newRow("one-clear") << QStringToQBitArray("0") << QList<qsizetype>();
+    QTest::newRow("one-set") << QStringToQBitArray("1") << QList<qsizetype>{0};
+    QTest::newRow("byte") << QStringToQBitArray("10010001") << QList<qsizetype>{0, 3, 7};
+    QTest::newRow("two-bytes") << QStringToQBitArray("000000001") << QList<qsizetype>{8};
+
+    QList<qsizetype> sparse{5, 63, 64, 127, 128, 300, 511, 999};
+    QBitArray large(1000);
+    for (qsizetype i : qAsConst(sparse))
+        large.setBit(i);
+    QTest::newRow("sparse") << large << sparse;
+
+    QTest::newRow("last") << QBitArray(4097) << QList<qsizetype>();
+    QBitArray last(4097);
+    last.setBit(4096);
+    QTest::newRow("last-set") << last << QList<qsizetype>{4096};
+
+    QList<qsizetype> all;
+    for (qsizetype i = 0; i < 77; ++i)
+        all << i;
+    QTest::newRow("all") << QBitArray(77, true) << all;
+}
+
+void tst_QBitArray::findNextSetBit()
+{
+    QFETCH(QBitArray, data);
+    QFETCH(QList<qsizetype>, setBits);
+
+    QList<qsizetype> found;
+    for (qsizetype i = data.findNextSetBit(); i != -1; i = data.findNextSetBit(i + 1))
+        found << i;
+    QCOMPARE(found, setBits);
+
+    // starting anywhere finds the next set bit
+    for (qsizetype from = 0; from < data.size(); ++from) {
+        const auto it = std::lower_bound(setBits.cbegin(), setBits.cend(), from);
+        QCOMPARE(data.findNextSetBit(from), it == setBits.cend() ? -1 : *it);
+    }
+    QCOMPARE(data.findNextSetBit(-5), setBits.isEmpty() ? -1 : setBits.first());
+    QCOMPARE(data.findNextSetBit(data.size()), -1);
+}
+
+void tst_QBitArray::longArrays()
+{
+    // compare the word-wise operations against a bit by bit reference,
+    // with sizes covering the vectorized and the tail loops
+    QRandomGenerator rng(42);
+    const int sizes[] = { 1, 7, 63, 64, 65, 127, 128, 129, 255, 256, 257, 2047, 2048, 2049,
+                          8191, 8192, 8200, 66000 };
+    for (int size1 : sizes) {
+        for (int size2 : { size1, size1 / 2, size1 + 100 }) {
+            QBitArray a(size1), b(size2);
+            for (int i = 0; i < size1; ++i)
+                a.setBit(i, rng.bounded(3) == 0);
+            for (int i = 0; i < size2; ++i)
+                b.setBit(i, rng.bounded(2));
+
+            const int size = qMax(size1, size2);
+            const QBitArray andResult = a & b;
+            const QBitArray orResult = a | b;
+            const QBitArray xorResult = a ^ b;
+            const QBitArray notResult = ~a;
+            QCOMPARE(andResult.size(), size);
+            QCOMPARE(orResult.size(), size);
+            QCOMPARE(xorResult.size(), size);
+            QCOMPARE(notResult.size(), size1);
+
+            qsizetype count = 0;
+            for (int i = 0; i < size; ++i) {
+                const bool bitA = i < size1 && a.testBit(i);
+                const bool bitB = i < size2 && b.testBit(i);
+                count += bitA;
+                QCOMPARE(andResult.testBit(i), bitA && bitB);
+                QCOMPARE(orResult.testBit(i), bitA || bitB);
+                QCOMPARE(xorResult.testBit(i), bitA != bitB);
+                if (i < size1)
+                    QCOMPARE(notResult.testBit(i), !bitA);
+            }
+            QCOMPARE(a.count(true), count);
+            QCOMPARE(notResult.count(true), size1 - count);
+            QCOMPARE(notResult.count(false), count);
+
+            // padding bits must stay clear, or comparisons would break
+            QCOMPARE(~notResult, a);
+            QCOMPARE(QBitArray(a) ^= a, QBitArray(size1));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QBitArray)
 #include "tst_qbitarray.moc"
@@ -30,6 +30,9 @@
 #include <QtCore/QCoreApplication>
 #include <QtTest/QtTest>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThreadPool>
 
 Q_DECLARE_METATYPE(QCryptographicHash::Algorithm)
 
@@ -49,8 +52,25 @@ private slots:
     void files_data();
     void files();
     void hashLength();
+    void chunkedInput_data();
+    void chunkedInput();
+    void hashMany_data();
+    void hashMany();
+    void hashParallel_data();
+    void hashParallel();
+    void merkleTreeHash_data();
+    void merkleTreeHash();
 };
 
+// a pattern that does not repeat at block boundaries
+static QByteArray patternData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
 void tst_QCryptographicHash::repeated_result_data()
 {
     intermediary_result_data();
@@ -357,6 +377,41 @@ void tst_QCryptographicHash::blake2_data()
         "The quick brown fox jumps over the lazy dog.",
         "95bca6e1b761dca1323505cc629949a0e03edf11633cc7935bd8b56f393afcf2");
 
+    // BLAKE2bp
+    ROW("blake2bp_512_empty",
+        QCryptographicHash::Blake2bp_512,
+        "",
+        "b5ef811a8038f70b628fa8b294daae7492b1ebe343a80eaabbf1f6ae664dd67b"
+        "9d90b0120791eab81dc96985f28849f6a305186a85501b405114bfa678df9380");
+
+    ROW("blake2bp_512_pangram",
+        QCryptographicHash::Blake2bp_512,
+        "The quick brown fox jumps over the lazy dog",
+        "f10e0523631699102c63412c0701fa19f6550fbac0e9c035803c6033b5046522"
+        "2bb92ee0af0dad53edca32f0e08a72c077a6cafc6f4d24a7fb649079d47ce089");
+
+    ROW("blake2bp_512_pangram_dot",
+        QCryptographicHash::Blake2bp_512,
+        "The quick brown fox jumps over the lazy dog.",
+        "e3c82f707f793ffde046e490ee6e6fa0be2def4ff20aa5a63eb0bf9475381301"
+        "f4b041e3fea156aea06d14042c2d6e00fb29af53633a2b4b83ae4256d923bb72");
+
+    // BLAKE2sp
+    ROW("blake2sp_256_empty",
+        QCryptographicHash::Blake2sp_256,
+        "",
+        "dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f");
+
+    ROW("blake2sp_256_pangram",
+        QCryptographicHash::Blake2sp_256,
+        "The quick brown fox jumps over the lazy dog",
+        "cf192976714bb648e72b29fa90e6bf0fbc5bf2efe7d5c26ed8ff34e855368691");
+
+    ROW("blake2sp_256_pangram_dot",
+        QCryptographicHash::Blake2sp_256,
+        "The quick brown fox jumps over the lazy dog.",
+        "9adcc03dbd57bb170ddd9efbe748f03695251767828ef6a0f0451b366823ebfd");
+
 #undef ROW
 }
 
@@ -409,5 +464,180 @@ void tst_QCryptographicHash::hashLength()
     }
 }
 
+void tst_QCryptographicHash::chunkedInput_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<QByteArray>("hashResult");
+
+    // one million times 'a', from FIPS 180-2
+    const struct {
+        QCryptographicHash::Algorithm algorithm;
+        const char *name;
+        const char *hash;
+    } hashes[] = {
+        { QCryptographicHash::Sha1, "Sha1",
+          "34aa973cd4c4daa4f61eeb2bdbad27316534016f" },
+        { QCryptographicHash::Sha224, "Sha224",
+          "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67" },
+        { QCryptographicHash::Sha256, "Sha256",
+          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+    };
+    for (const auto &h : hashes) {
+        for (int chunkSize : { 1, 7, 63, 64, 65, 1000, 1000000 }) {
+            QTest::addRow("%s-%d", h.name, chunkSize)
+                    << h.algorithm << chunkSize << QByteArray::fromHex(h.hash);
+        }
+    }
+}
+
+void tst_QCryptographicHash::chunkedInput()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(int, chunkSize);
+    QFETCH(QByteArray, hashResult);
+
+    const QByteArray data(1000000, 'a');
+    QCryptographicHash hash(algorithm);
+    for (int i = 0; i < data.size(); i += chunkSize)
+        hash.addData(data.constData() + i, qMin(chunkSize, int(data.size()) - i));
+    QCOMPARE(hash.result(), hashResult);
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+
+    auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (int i = 0, value = metaEnum.value(i); value != -1; value = metaEnum.value(++i))
+        QTest::newRow(metaEnum.key(i)) << QCryptographicHash::Algorithm(value);
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+
+    QCOMPARE(QCryptographicHash::hashMany(QByteArrayList(), algorithm), QByteArrayList());
+
+    // lengths around the block and padding boundaries, in an order that
+    // makes messages of different lengths share the parallel lanes
+    QByteArrayList data;
+    for (int length : { 0, 1, 3, 55, 56, 57, 63, 64, 65, 119, 120, 127, 128, 129, 1000, 4097 }) {
+        for (int i = 0; i < 3; ++i) {
+            QByteArray message(length + i, Qt::Uninitialized);
+            for (int j = 0; j < message.size(); ++j)
+                message[j] = char(j * 7 + length + i);
+            data.append(message);
+        }
+    }
+
+    const QByteArrayList result = QCryptographicHash::hashMany(data, algorithm);
+    QCOMPARE(result.size(), data.size());
+    for (int i = 0; i < data.size(); ++i)
+        QCOMPARE(result.at(i), QCryptographicHash::hash(data.at(i), algorithm));
+}
+
+void tst_QCryptographicHash::hashParallel_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expectedResult");
+    QTest::addColumn<bool>("mapped");
+
+    const QByteArray data = patternData(100000);
+    const struct {
+        const char *name;
+        QCryptographicHash::Algorithm algorithm;
+        const char *hash; // of data
+    } hashes[] = {
+        { "blake2bp_512", QCryptographicHash::Blake2bp_512,
+          "5cdeae115c2491fb0b9c70267e9d3294e47d4f30f3218d8f9b3e2ed58cf7a67e"
+          "05c08ce328a86fd4e0d09fc239d3f397480290a8576f9dbdc97222fae9bba448" },
+        { "blake2sp_256", QCryptographicHash::Blake2sp_256,
+          "eb7050ea034453a75de798404d87f5568c4c0c6a7cccba79bd5863a40a33d10b" },
+        { "sha256", QCryptographicHash::Sha256, nullptr },
+    };
+    for (const auto &h : hashes) {
+        const QByteArray expected = h.hash ? QByteArray::fromHex(h.hash)
+                                           : QCryptographicHash::hash(data, h.algorithm);
+        for (bool mapped : { false, true }) {
+            const char *source = mapped ? "file" : "buffer";
+            QTest::addRow("%s-empty-%s", h.name, source)
+                    << h.algorithm << QByteArray()
+                    << QCryptographicHash::hash(QByteArray(), h.algorithm) << mapped;
+            QTest::addRow("%s-%s", h.name, source) << h.algorithm << data << expected << mapped;
+        }
+    }
+}
+
+void tst_QCryptographicHash::hashParallel()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expectedResult);
+    QFETCH(bool, mapped);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QCOMPARE(QCryptographicHash::hash(data, algorithm), expectedResult);
+    if (mapped) {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        QCOMPARE(file.write(data), qint64(data.size()));
+        QVERIFY(file.seek(0));
+        QCOMPARE(QCryptographicHash::hashParallel(&file, algorithm, &pool), expectedResult);
+        QVERIFY(file.atEnd());
+    } else {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QCOMPARE(QCryptographicHash::hashParallel(&buffer, algorithm, &pool), expectedResult);
+        QVERIFY(buffer.atEnd());
+
+        QBuffer closed(&data);
+        QVERIFY(QCryptographicHash::hashParallel(&closed, algorithm, &pool).isEmpty());
+    }
+}
+
+void tst_QCryptographicHash::merkleTreeHash_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<qint64>("chunkSize");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // RFC 6962 tree hashes with SHA-256 of patternData(size)
+    QTest::newRow("empty") << 0 << qint64(1000) << QByteArray::fromHex(
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    QTest::newRow("10-chunks") << 10000 << qint64(1000) << QByteArray::fromHex(
+            "a8f8a7e941409e0b5c50c6fb0aa7d9860c073d607010de3982ceb06b2e274147");
+    QTest::newRow("4-chunks") << 10000 << qint64(3000) << QByteArray::fromHex(
+            "4b61cf178fc50fe25618020ad0c9abd3a0bc75a647e5091c2bb54dace187dc0b");
+    QTest::newRow("1-chunk") << 10000 << qint64(20000) << QByteArray::fromHex(
+            "28512e5626220268b84046d2806a958cf2e37f6291bce7a6a598aa1e2861e2ab");
+}
+
+void tst_QCryptographicHash::merkleTreeHash()
+{
+    QFETCH(int, size);
+    QFETCH(qint64, chunkSize);
+    QFETCH(QByteArray, expectedResult);
+
+    QByteArray data = patternData(size);
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(size));
+    QVERIFY(file.seek(0));
+    QCOMPARE(QCryptographicHash::merkleTreeHash(&file, QCryptographicHash::Sha256, chunkSize, &pool),
+             expectedResult);
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(QCryptographicHash::merkleTreeHash(&buffer, QCryptographicHash::Sha256, chunkSize, &pool),
+             expectedResult);
+}
+
 QTEST_MAIN(tst_QCryptographicHash)
 #include "tst_qcryptographichash.moc"
@@ -38,6 +38,8 @@ private slots:
     void result();
     void result_incremental_data();
     void result_incremental();
+    void differentKey_data();
+    void differentKey();
     void addData_overloads_data();
     void addData_overloads();
 };
@@ -98,6 +100,16 @@ void tst_QMessageAuthenticationCode::result_data()
             << QByteArray::fromHex(
                        "b42af09057bac1e2d41708e48a902e09b5ff7f12ab428a4fe86653c73dd248fb82f948a549f"
                        "7b791a5b41915ee4d1ec3935357e4e2317250d0372afa2ebeeb3a");
+    QTest::newRow("blake2bp_512")
+            << QCryptographicHash::Blake2bp_512 << QByteArray("key")
+            << QByteArray("The quick brown fox jumps over the lazy dog")
+            << QByteArray::fromHex(
+                       "8d052fd6ab7e0696e798594a50372e29d871803f49c17de07db0c4d6d0bed5c30b866df8297"
+                       "2dcd0f3d211169275a838e87b82d810cc8bafafc2a726b701ce0a");
+    QTest::newRow("blake2sp_256")
+            << QCryptographicHash::Blake2sp_256 << QByteArray("key")
+            << QByteArray("The quick brown fox jumps over the lazy dog")
+            << QByteArray::fromHex("998736468aaebad3f40f0aa66a88e5c6657e0fc9eadebd1a4546de8d5a5c2e8e");
 
     // Some from rfc-2104
     QTest::newRow("rfc-md5-1") << QCryptographicHash::Md5
@@ -159,6 +171,23 @@ void tst_QMessageAuthenticationCode::result_incremental()
     QCOMPARE(result, code);
 }
 
+void tst_QMessageAuthenticationCode::differentKey_data()
+{
+    result_data();
+}
+
+void tst_QMessageAuthenticationCode::differentKey()
+{
+    QFETCH(QCryptographicHash::Algorithm, algo);
+    QFETCH(QByteArray, key);
+    QFETCH(QByteArray, message);
+    QFETCH(QByteArray, code);
+
+    // A different key must give a different code
+    const QByteArray result = QMessageAuthenticationCode::hash(message, key + 'x', algo);
+    QVERIFY(result != code);
+}
+
 void tst_QMessageAuthenticationCode::addData_overloads_data()
 {
     result_data();
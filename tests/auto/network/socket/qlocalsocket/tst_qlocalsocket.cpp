@@ -41,6 +41,8 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h> // for unlink()
+#include <fcntl.h>
+#include <sys/resource.h>
 #endif
 
 #ifdef Q_OS_WIN
@@ -121,6 +123,11 @@ private slots:
     void verifyListenWithDescriptor();
     void verifyListenWithDescriptor_data();
 
+    void writeLargeByteArrays();
+    void writeDescriptors();
+    void writeDescriptorsAfterData();
+    void descriptorReceivingDisabled();
+    void descriptorsTruncated();
 };
 
 tst_QLocalSocket::tst_QLocalSocket()
@@ -1421,6 +1428,252 @@ void tst_QLocalSocket::verifyListenWithDescriptor_data()
 
 }
 
+void tst_QLocalSocket::writeLargeByteArrays()
+{
+    QLocalServer server;
+    QVERIFY(server.listen("writeLargeByteArrays"));
+    QLocalSocket client;
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    QScopedPointer<QLocalSocket> serverSocket(server.nextPendingConnection());
+    QVERIFY(serverSocket);
+
+    // Several chunks in the write buffer at once, some of them large
+    // enough to be shared rather than copied.
+    QByteArray expected;
+    for (int i = 0; i < 40; ++i) {
+        const QByteArray block((i % 3 + 1) * 20000 + i, char('a' + i % 26));
+        QCOMPARE(client.write(block), qint64(block.size()));
+        expected += block;
+    }
+    QCOMPARE(client.bytesToWrite(), qint64(expected.size()));
+
+    QByteArray received;
+    while (received.size() < expected.size()) {
+        client.flush();
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, expected);
+    QCOMPARE(client.bytesToWrite(), qint64(0));
+}
+
+#if defined(Q_OS_UNIX) && !defined(QT_LOCALSOCKET_TCP)
+static QByteArray readFromDescriptor(qintptr descriptor)
+{
+    char buffer[64];
+    const ssize_t r = ::pread(int(descriptor), buffer, sizeof(buffer), 0);
+    return r < 0 ? QByteArray() : QByteArray(buffer, int(r));
+}
+#endif
+
+void tst_QLocalSocket::writeDescriptors()
+{
+    QLocalServer server;
+    QVERIFY(server.listen("writeDescriptors"));
+    QLocalSocket client;
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    QScopedPointer<QLocalSocket> serverSocket(server.nextPendingConnection());
+    QVERIFY(serverSocket);
+    serverSocket->setDescriptorReceivingEnabled(true);
+
+    QTemporaryFile first;
+    QVERIFY(first.open());
+    QCOMPARE(first.write("first"), qint64(5));
+    QVERIFY(first.flush());
+    QTemporaryFile second;
+    QVERIFY(second.open());
+    QCOMPARE(second.write("second"), qint64(6));
+    QVERIFY(second.flush());
+
+#if defined(Q_OS_UNIX) && !defined(QT_LOCALSOCKET_TCP)
+    const QByteArray message("two files");
+    QCOMPARE(client.writeDescriptors(message, { first.handle(), second.handle() }),
+             qint64(message.size()));
+    // Ours remain open.
+    QCOMPARE(readFromDescriptor(first.handle()), QByteArray("first"));
+
+    QByteArray received;
+    while (received.size() < message.size()) {
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, message);
+
+    const QList<qintptr> descriptors = serverSocket->readDescriptors();
+    QCOMPARE(descriptors.size(), 2);
+    QVERIFY(descriptors.at(0) != first.handle());
+    QCOMPARE(readFromDescriptor(descriptors.at(0)), QByteArray("first"));
+    QCOMPARE(readFromDescriptor(descriptors.at(1)), QByteArray("second"));
+    QVERIFY(::fcntl(int(descriptors.at(0)), F_GETFD) & FD_CLOEXEC);
+    for (qintptr descriptor : descriptors)
+        ::close(int(descriptor));
+    QVERIFY(serverSocket->readDescriptors().isEmpty());
+
+    // Descriptors need data to travel with.
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QLocalSocket::writeDescriptors: Cannot pass descriptors without data");
+    QCOMPARE(client.writeDescriptors(QByteArray(), { first.handle() }), qint64(-1));
+    QCOMPARE(client.state(), QLocalSocket::ConnectedState);
+#else
+    QCOMPARE(client.writeDescriptors("unsupported", { first.handle() }), qint64(-1));
+    QCOMPARE(client.error(), QLocalSocket::UnsupportedSocketOperationError);
+    QVERIFY(serverSocket->readDescriptors().isEmpty());
+    QVERIFY(!serverSocket->isDescriptorReceivingEnabled());
+#endif
+}
+
+void tst_QLocalSocket::writeDescriptorsAfterData()
+{
+#if !defined(Q_OS_UNIX) || defined(QT_LOCALSOCKET_TCP)
+    QSKIP("Passing descriptors is only supported with Unix domain sockets");
+#else
+    QLocalServer server;
+    QVERIFY(server.listen("writeDescriptorsAfterData"));
+    QLocalSocket client;
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    QScopedPointer<QLocalSocket> serverSocket(server.nextPendingConnection());
+    QVERIFY(serverSocket);
+    serverSocket->setDescriptorReceivingEnabled(true);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write("payload"), qint64(7));
+    QVERIFY(file.flush());
+
+    // Buffered data goes out first; the descriptor arrives with the
+    // bytes written along with it, and not before them.
+    const QByteArray before(6000, 'x');
+    QCOMPARE(client.write(before), qint64(before.size()));
+    QCOMPARE(client.writeDescriptors("descriptor", { file.handle() }), qint64(10));
+    QCOMPARE(client.write("after"), qint64(5));
+
+    const QByteArray expected = before + "descriptor" + "after";
+    QByteArray received;
+    QList<qintptr> descriptors;
+    while (received.size() < expected.size()) {
+        client.flush();
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+        descriptors += serverSocket->readDescriptors();
+        if (received.size() < before.size())
+            QVERIFY(descriptors.isEmpty());
+    }
+    QCOMPARE(received, expected);
+    QCOMPARE(descriptors.size(), 1);
+    QCOMPARE(readFromDescriptor(descriptors.at(0)), QByteArray("payload"));
+    ::close(int(descriptors.at(0)));
+#endif
+}
+
+void tst_QLocalSocket::descriptorReceivingDisabled()
+{
+#if !defined(Q_OS_UNIX) || defined(QT_LOCALSOCKET_TCP)
+    QSKIP("Passing descriptors is only supported with Unix domain sockets");
+#else
+    QLocalServer server;
+    QVERIFY(server.listen("descriptorReceivingDisabled"));
+    QLocalSocket client;
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    QScopedPointer<QLocalSocket> serverSocket(server.nextPendingConnection());
+    QVERIFY(serverSocket);
+    QVERIFY(!serverSocket->isDescriptorReceivingEnabled());
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    // The data arrives, the descriptor does not.
+    QCOMPARE(client.writeDescriptors("first", { file.handle() }), qint64(5));
+    QByteArray received;
+    while (received.size() < 5) {
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, QByteArray("first"));
+    QVERIFY(serverSocket->readDescriptors().isEmpty());
+
+    serverSocket->setDescriptorReceivingEnabled(true);
+    QVERIFY(serverSocket->isDescriptorReceivingEnabled());
+    QCOMPARE(client.writeDescriptors("second", { file.handle() }), qint64(6));
+    received.clear();
+    while (received.size() < 6) {
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, QByteArray("second"));
+    const QList<qintptr> descriptors = serverSocket->readDescriptors();
+    QCOMPARE(descriptors.size(), 1);
+    ::close(int(descriptors.at(0)));
+#endif
+}
+
+void tst_QLocalSocket::descriptorsTruncated()
+{
+#if !defined(Q_OS_LINUX) || defined(QT_LOCALSOCKET_TCP)
+    QSKIP("This test relies on Linux reporting descriptors it could not install");
+#else
+    QLocalServer server;
+    QVERIFY(server.listen("descriptorsTruncated"));
+    QLocalSocket client;
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    QScopedPointer<QLocalSocket> serverSocket(server.nextPendingConnection());
+    QVERIFY(serverSocket);
+    serverSocket->setDescriptorReceivingEnabled(true);
+
+    QTemporaryFile first;
+    QVERIFY(first.open());
+    QTemporaryFile second;
+    QVERIFY(second.open());
+    QCOMPARE(client.writeDescriptors("two", { first.handle(), second.handle() }), qint64(3));
+
+    // Leave room for just one more descriptor, so that the second one
+    // cannot be received.
+    const int lowestFree = ::dup(0);
+    QVERIFY(lowestFree >= 0);
+    ::close(lowestFree);
+    rlimit original;
+    QCOMPARE(::getrlimit(RLIMIT_NOFILE, &original), 0);
+    rlimit limited = original;
+    limited.rlim_cur = rlim_t(lowestFree + 1);
+    QCOMPARE(::setrlimit(RLIMIT_NOFILE, &limited), 0);
+    auto restore = qScopeGuard([&original] { ::setrlimit(RLIMIT_NOFILE, &original); });
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QNativeSocketEngine: Discarded file descriptors passed by the peer, "
+                         "as some of them could not be received");
+    QByteArray received;
+    while (received.size() < 3) {
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    restore.dismiss();
+    QCOMPARE(::setrlimit(RLIMIT_NOFILE, &original), 0);
+
+    // The data arrives; the incomplete set of descriptors does not, and the
+    // one that was received has been closed again.
+    QCOMPARE(received, QByteArray("two"));
+    QVERIFY(serverSocket->readDescriptors().isEmpty());
+    const int next = ::dup(0);
+    QCOMPARE(next, lowestFree);
+    ::close(next);
+#endif
+}
+
 QTEST_MAIN(tst_QLocalSocket)
 #include "tst_qlocalsocket.moc"
 
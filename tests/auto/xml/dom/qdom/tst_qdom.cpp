@@ -117,6 +117,7 @@ private slots:
     void DTDNotationDecl();
     void DTDEntityDecl();
     void QTBUG49113_dontCrashWithNegativeIndex() const;
+    void sharedNames() const;
 
     void cleanupTestCase() const;
 
@@ -2164,5 +2165,49 @@ void tst_QDom::QTBUG49113_dontCrashWithNegativeIndex() const
     QVERIFY(node.isNull());
 }
 
+void tst_QDom::sharedNames() const
+{
+    const QByteArray input("<root xmlns:p='urn:p'>"
+                               "<p:item p:kind='a' id='1'/>"
+                               "<p:item p:kind='b' id='2'/>"
+                           "</root>");
+
+    for (bool namespaceProcessing : { false, true }) {
+        QDomDocument doc;
+        QString error;
+        QVERIFY2(doc.setContent(input, namespaceProcessing, &error), qPrintable(error));
+
+        const QDomNodeList items = doc.documentElement().childNodes();
+        QCOMPARE(items.count(), 2);
+        QDomElement first = items.at(0).toElement();
+        QDomElement second = items.at(1).toElement();
+        QCOMPARE(first.attribute("id"), QString("1"));
+        QCOMPARE(second.attribute("id"), QString("2"));
+
+        // the parser shares one copy of each name between all nodes using it
+        QVERIFY(first.tagName().isSharedWith(second.tagName()));
+        const QDomAttr firstId = first.attributeNode("id");
+        const QDomAttr secondId = second.attributeNode("id");
+        QVERIFY(firstId.name().isSharedWith(secondId.name()));
+
+        if (namespaceProcessing) {
+            QCOMPARE(first.tagName(), QString("item"));
+            QCOMPARE(first.prefix(), QString("p"));
+            QCOMPARE(first.namespaceURI(), QString("urn:p"));
+            QVERIFY(first.prefix().isSharedWith(second.prefix()));
+            QVERIFY(first.namespaceURI().isSharedWith(second.namespaceURI()));
+            QCOMPARE(first.attributeNS("urn:p", "kind"), QString("a"));
+            QCOMPARE(second.attributeNS("urn:p", "kind"), QString("b"));
+            QVERIFY(firstId.namespaceURI().isEmpty());
+            QVERIFY(firstId.prefix().isEmpty());
+        } else {
+            QCOMPARE(first.tagName(), QString("p:item"));
+            QCOMPARE(first.attribute("p:kind"), QString("a"));
+            QCOMPARE(second.attribute("p:kind"), QString("b"));
+            QVERIFY(first.prefix().isNull());
+        }
+    }
+}
+
 QTEST_MAIN(tst_QDom)
 #include "tst_qdom.moc"
@@ -9,6 +9,7 @@ qtHaveModule(network): SUBDIRS += network
 # removed-by-refactor qtHaveModule(opengl): SUBDIRS += opengl
 qtHaveModule(testlib): SUBDIRS += testlib
 qtHaveModule(widgets): SUBDIRS += widgets
+qtHaveModule(xml): SUBDIRS += xml
 
 check-trusted.CONFIG += recursive
 QMAKE_EXTRA_TARGETS += check-trusted
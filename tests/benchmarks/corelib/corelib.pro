@@ -1,9 +1,11 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        global \
         io \
         json \
         mimetypes \
         kernel \
+        serialization \
         text \
         thread \
         time \
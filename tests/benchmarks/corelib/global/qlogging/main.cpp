@@ -0,0 +1,141 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QProcess>
+#include <QTemporaryFile>
+#include <QThread>
+#include <qtest.h>
+
+#include <vector>
+
+Q_LOGGING_CATEGORY(lcBench, "qt.bench.logging")
+
+static const char childVariable[] = "QT_BENCH_LOGGING_CHILD";
+static const int messageCount = 20000;
+
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+private slots:
+    void emitMessages_data();
+    void emitMessages();
+};
+
+void tst_QLogging::emitMessages_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("sync") << false << 1;
+    QTest::newRow("async") << true << 1;
+    QTest::newRow("sync-4-threads") << false << 4;
+    QTest::newRow("async-4-threads") << true << 4;
+}
+
+// Measures how long the logging threads are blocked by qCDebug(). This needs
+// a process of its own, as the logging backend is chosen at startup.
+void tst_QLogging::emitMessages()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This benchmark requires QProcess support");
+#else
+    QFETCH(bool, async);
+    QFETCH(int, threadCount);
+
+    QTemporaryFile output;
+    QVERIFY(output.open());
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(QLatin1String(childVariable), QString::number(threadCount));
+    env.insert(QStringLiteral("QT_LOGGING_ASYNC"), QLatin1String(async ? "1" : "0"));
+    env.insert(QStringLiteral("QT_LOGGING_ASYNC_BUFFER_SIZE"), QString::number(messageCount));
+    env.insert(QStringLiteral("QT_MESSAGE_PATTERN"),
+               QStringLiteral("%{time yyyy-MM-dd hh:mm:ss.zzz} %{threadid} %{category}: %{message}"));
+    env.remove(QStringLiteral("QT_LOGGING_RULES"));
+
+    QProcess process;
+    process.setProcessEnvironment(env);
+    process.setProgram(QCoreApplication::applicationFilePath());
+    process.setStandardErrorFile(output.fileName());
+    process.start();
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 0);
+
+    // every message made it to stderr
+    QCOMPARE(output.readAll().count('\n'), messageCount);
+
+    const qint64 nsecs = process.readAllStandardOutput().trimmed().toLongLong();
+    QVERIFY(nsecs > 0);
+    QTest::setBenchmarkResult(qreal(nsecs) / messageCount, QTest::WalltimeNanoseconds);
+#endif
+}
+
+static int runChild(int threadCount)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("qt.bench.logging=true"));
+
+    const int perThread = messageCount / threadCount;
+    std::vector<qint64> elapsed(threadCount);
+    std::vector<QThread *> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.push_back(QThread::create([t, perThread, &elapsed] {
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < perThread; ++i)
+                qCDebug(lcBench) << "message" << i << "from thread" << t;
+            elapsed[t] = timer.nsecsElapsed();
+        }));
+    }
+    for (QThread *thread : threads)
+        thread->start();
+    qint64 total = 0;
+    for (int t = 0; t < threadCount; ++t) {
+        threads[t]->wait();
+        delete threads[t];
+        total += elapsed[t];
+    }
+    printf("%lld\n", total);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const int childThreads = qEnvironmentVariableIntValue(childVariable);
+    if (childThreads > 0)
+        return runChild(childThreads);
+
+    tst_QLogging test;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "main.moc"
@@ -5,6 +5,8 @@ SUBDIRS = \
         qfile \
         qfileinfo \
         qiodevice \
+        qresource \
+        qsettings \
         qtemporaryfile \
         qtextstream
 
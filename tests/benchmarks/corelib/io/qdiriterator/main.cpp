@@ -28,6 +28,7 @@
 #include <QDebug>
 #include <QDirIterator>
 #include <QString>
+#include <QTemporaryDir>
 #include <qplatformdefs.h>
 
 #ifdef Q_OS_WIN
@@ -58,10 +59,14 @@ private slots:
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void walk();
+    void walk_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
+    void largeDirectory_data();
+    void largeDirectory();
 };
 
 
@@ -205,6 +210,21 @@ void tst_qdiriterator::diriterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::walk()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        QDirIterator::walk(dirpath, QStringList(), QDir::Files, QDirIterator::Subdirectories, -1,
+                           [&c](const QFileInfoList &batch) { c += batch.size(); });
+        count = c;
+    }
+    qDebug() << count;
+}
+
 void tst_qdiriterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
@@ -237,6 +257,49 @@ void tst_qdiriterator::fsiterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::largeDirectory_data()
+{
+    QTest::addColumn<int>("filters");
+    QTest::addColumn<bool>("useFileInfo");
+
+    QTest::newRow("files, path only") << int(QDir::Files) << false;
+    QTest::newRow("files, file info") << int(QDir::Files) << true;
+    QTest::newRow("all entries, hidden") << int(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot)
+                                         << false;
+}
+
+void tst_qdiriterator::largeDirectory()
+{
+    QFETCH(int, filters);
+    QFETCH(bool, useFileInfo);
+
+    // a flat directory with many entries, where the per-entry overhead of
+    // the iterator dominates
+    const int fileCount = 20000;
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    for (int i = 0; i < fileCount; ++i) {
+        QFile file(dir.filePath(QString::number(i).rightJustified(8, '0') + ".txt"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QVERIFY(QDir(dir.path()).mkdir("subdir"));
+
+    int count = 0;
+    QBENCHMARK {
+        int c = 0;
+        QDirIterator it(dir.path(), QDir::Filters(filters));
+        while (it.hasNext()) {
+            it.next();
+            if (useFileInfo)
+                c += it.fileInfo().isFile();
+            else
+                ++c;
+        }
+        count = c;
+    }
+    QVERIFY(count >= fileCount);
+}
+
 void tst_qdiriterator::stdRecursiveDirectoryIterator()
 {
 #if QT_CONFIG(cxx17_filesystem)
@@ -30,6 +30,7 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#include <QFuture>
 
 #include <private/qfsfileengine_p.h>
 
@@ -107,6 +108,9 @@ private slots:
     void readBigFile_posix();
     void readBigFile_Win32();
 
+    void readBigFile_async_data();
+    void readBigFile_async();
+
 private:
     void readBigFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -214,6 +218,49 @@ void tst_qfile::readBigFile_Win32_data()
 }
 
 
+void tst_qfile::readBigFile_async_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<int>("inFlight");
+
+    for (int blockSize : { 1024*32, 1024*512 }) {
+        for (int inFlight : { 1, 4, 16 }) {
+            QTest::addRow("BS: %d, in flight: %d", blockSize, inFlight)
+                    << blockSize << inFlight;
+        }
+    }
+}
+
+void tst_qfile::readBigFile_async()
+{
+    QFETCH(int, blockSize);
+    QFETCH(int, inFlight);
+
+    createFile();
+    fillFile();
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const qint64 size = file.size();
+
+    QBENCHMARK {
+        QList<QFuture<QByteArray>> pending;
+        qint64 offset = 0;
+        qint64 total = 0;
+        while (offset < size || !pending.isEmpty()) {
+            while (offset < size && pending.size() < inFlight) {
+                pending.append(file.readAsync(offset, blockSize));
+                offset += blockSize;
+            }
+            total += pending.takeFirst().result().size();
+        }
+        QCOMPARE(total, size);
+    }
+
+    file.close();
+    removeFile();
+}
+
 void tst_qfile::readBigFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b)
 {
     QTest::addColumn<tst_qfile::BenchmarkType>("testType");
@@ -37,6 +37,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startLatency_data();
+    void startLatency();
 };
 
 void tst_QProcess::echoTest_performance()
@@ -84,5 +86,39 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startLatency_data()
+{
+    QTest::addColumn<int>("parentRssMB");
+    QTest::addColumn<bool>("useModifier");
+
+    for (int rss : { 0, 256, 1024 }) {
+        QTest::addRow("rss-%dMB", rss) << rss << false;
+        // a modifier forces a full fork()
+        QTest::addRow("rss-%dMB-modifier", rss) << rss << true;
+    }
+}
+
+void tst_QProcess::startLatency()
+{
+    QFETCH(int, parentRssMB);
+    QFETCH(bool, useModifier);
+
+    // touch every page, so that it counts towards our resident set
+    const QByteArray ballast(qsizetype(parentRssMB) * 1024 * 1024, 'x');
+
+    QProcess process;
+    process.setProgram("testProcessLoopback/testProcessLoopback");
+    if (useModifier)
+        process.setChildProcessModifier([] {});
+
+    QBENCHMARK {
+        process.start();
+        QVERIFY2(process.waitForStarted(), qPrintable(process.errorString()));
+        process.closeWriteChannel();
+        QVERIFY(process.waitForFinished());
+    }
+    QCOMPARE(ballast.size(), qsizetype(parentRssMB) * 1024 * 1024);
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QFile>
+#include <QResource>
+#include <QTest>
+
+class tst_QResource : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void lookup_data();
+    void lookup();
+    void readAll_data();
+    void readAll();
+};
+
+void tst_QResource::initTestCase()
+{
+    QResource compressed(":/data/compressible.txt");
+    QVERIFY(compressed.isValid());
+    if (compressed.compressionAlgorithm() == QResource::NoCompression)
+        qWarning("compressible.txt was not compressed by rcc");
+}
+
+void tst_QResource::lookup_data()
+{
+    QTest::addColumn<QString>("path");
+    QTest::addColumn<bool>("exists");
+
+    QTest::newRow("file") << QStringLiteral(":/data/small.txt") << true;
+    QTest::newRow("directory") << QStringLiteral(":/data") << true;
+    QTest::newRow("missing-file") << QStringLiteral(":/data/missing.txt") << false;
+    QTest::newRow("missing-directory") << QStringLiteral(":/missing/small.txt") << false;
+}
+
+void tst_QResource::lookup()
+{
+    QFETCH(QString, path);
+    QFETCH(bool, exists);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            QResource resource(path);
+            if (resource.isValid() != exists)
+                QFAIL("unexpected lookup result");
+        }
+    }
+}
+
+void tst_QResource::readAll_data()
+{
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("small") << QStringLiteral(":/data/small.txt");
+    QTest::newRow("compressed") << QStringLiteral(":/data/compressible.txt");
+}
+
+void tst_QResource::readAll()
+{
+    QFETCH(QString, path);
+
+    const qint64 expectedSize = QResource(path).uncompressedSize();
+    QVERIFY(expectedSize > 0);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly))
+                QFAIL("failed to open resource");
+            if (file.readAll().size() != expectedSize)
+                QFAIL("short read");
+        }
+    }
+}
+
+QTEST_MAIN(tst_QResource)
+
+#include "main.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += benchmark
+QT = core testlib
+
+TARGET = tst_bench_qresource
+SOURCES += main.cpp
+RESOURCES += qresource.qrc
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QCoreApplication>
+#include <qtest.h>
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+private slots:
+    void smallWrites_data();
+    void smallWrites();
+};
+
+void tst_QSettings::smallWrites_data()
+{
+    QTest::addColumn<bool>("background");
+
+    QTest::newRow("sync") << false;
+    QTest::newRow("background") << true;
+}
+
+void tst_QSettings::smallWrites()
+{
+    // Like an application updating its state while the user works:
+    // every change reaches the event loop before the next one is made
+    QFETCH(bool, background);
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QSettings settings(dir.filePath(QStringLiteral("settings.ini")), QSettings::IniFormat);
+    for (int i = 0; i < 1000; ++i)
+        settings.setValue(QStringLiteral("group%1/key%2").arg(i / 100).arg(i % 100), i);
+    settings.sync();
+    settings.setBackgroundSyncEnabled(background);
+
+    int i = 0;
+    QBENCHMARK {
+        settings.setValue(QStringLiteral("state/key%1").arg(i % 10), i);
+        ++i;
+        QCoreApplication::sendPostedEvents(&settings, QEvent::UpdateRequest);
+    }
+
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+QTEST_MAIN(tst_QSettings)
+
+#include "main.moc"
@@ -38,6 +38,10 @@ class tst_qtextstream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLine_data();
+    void readLine();
+    void readIntegers_data();
+    void readIntegers();
 
 private:
 };
@@ -115,6 +119,97 @@ void tst_qtextstream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+enum LineReader { ReadLine, ReadLineInto, ReadLineView };
+Q_DECLARE_METATYPE(LineReader);
+
+static QByteArray makeCsv(int rows)
+{
+    QByteArray csv;
+    for (int i = 0; i < rows; ++i)
+        csv += QByteArray::number(i) + ",some text," + QByteArray::number(i * 31) + ",3.25\n";
+    return csv;
+}
+
+void tst_qtextstream::readLine_data()
+{
+    QTest::addColumn<LineReader>("reader");
+
+    QTest::newRow("readLine") << ReadLine;
+    QTest::newRow("readLineInto") << ReadLineInto;
+    QTest::newRow("readLineView") << ReadLineView;
+}
+
+void tst_qtextstream::readLine()
+{
+    QFETCH(LineReader, reader);
+
+    QByteArray data = makeCsv(100000);
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    qsizetype total = 0;
+    QBENCHMARK {
+        buffer.seek(0);
+        QTextStream stream(&buffer);
+        total = 0;
+        switch (reader) {
+        case ReadLine:
+            while (!stream.atEnd())
+                total += stream.readLine().size();
+            break;
+        case ReadLineInto: {
+            QString line;
+            while (stream.readLineInto(&line))
+                total += line.size();
+            break;
+        }
+        case ReadLineView:
+            for (QStringView line = stream.readLineView(); !line.isNull(); line = stream.readLineView())
+                total += line.size();
+            break;
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_qtextstream::readIntegers_data()
+{
+    QTest::addColumn<bool>("fromDevice");
+
+    QTest::newRow("string") << false;
+    QTest::newRow("device") << true;
+}
+
+void tst_qtextstream::readIntegers()
+{
+    QFETCH(bool, fromDevice);
+
+    QByteArray data;
+    for (int i = 0; i < 200000; ++i)
+        data += QByteArray::number(i * 7919) + ' ';
+    QString string = QString::fromLatin1(data);
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        QTextStream stream;
+        if (fromDevice) {
+            buffer.seek(0);
+            stream.setDevice(&buffer);
+        } else {
+            stream.setString(&string, QIODevice::ReadOnly);
+        }
+        sum = 0;
+        int value;
+        while (!stream.atEnd()) {
+            stream >> value;
+            sum += value;
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
 QTEST_MAIN(tst_qtextstream)
 
 #include "main.moc"
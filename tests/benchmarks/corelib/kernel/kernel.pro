@@ -6,6 +6,7 @@ SUBDIRS = \
         qobject \
         qvariant \
         qcoreapplication \
+        qsharedmemorychannel \
         qtimer_vs_qmetaobject \
         qwineventnotifier
 
@@ -13,5 +14,8 @@ SUBDIRS = \
     qmetaobject \
     qobject
 
+!qtHaveModule(network): SUBDIRS -= \
+    qsharedmemorychannel
+
 # This test is only applicable on Windows
 !win32: SUBDIRS -= qwineventnotifier
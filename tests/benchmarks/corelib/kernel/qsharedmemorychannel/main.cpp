@@ -0,0 +1,283 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSemaphore>
+#include <QSharedMemoryChannel>
+#include <QTest>
+#include <QThread>
+
+#include <functional>
+#include <memory>
+
+// Compares moving data between two threads through a QSharedMemoryChannel
+// with doing the same through a QLocalSocket. The channel does not involve
+// the kernel unless one side has to sleep; in a real application the two
+// ends would be in different processes, with the same costs.
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+private slots:
+    void throughput_data();
+    void throughput();
+    void roundTrip_data();
+    void roundTrip();
+};
+
+static const qsizetype TransferSize = 16 * 1024 * 1024;
+
+static QString uniqueName(const char *what)
+{
+    static int counter = 0;
+    return QStringLiteral("tst_bench_qsharedmemorychannel_%1_%2_%3")
+            .arg(QCoreApplication::applicationPid()).arg(QLatin1String(what)).arg(++counter);
+}
+
+static bool readExactly(QIODevice *device, char *data, qint64 size)
+{
+    while (size > 0) {
+        if (!device->bytesAvailable() && !device->waitForReadyRead(5000))
+            return false;
+        const qint64 n = device->read(data, size);
+        if (n < 0)
+            return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool writeAll(QIODevice *device, const char *data, qint64 size)
+{
+    if (device->write(data, size) != size)
+        return false;
+    // QLocalSocket buffers; keep the amount of buffered data bounded
+    while (device->bytesToWrite() > 1024 * 1024) {
+        if (!device->waitForBytesWritten(5000))
+            return false;
+    }
+    return true;
+}
+
+static bool flush(QIODevice *device)
+{
+    while (device->bytesToWrite() > 0 && qobject_cast<QLocalSocket *>(device)) {
+        if (!device->waitForBytesWritten(5000))
+            return false;
+    }
+    return true;
+}
+
+// A connected pair of QLocalSockets, one end for another thread.
+struct LocalSocketPair
+{
+    QLocalServer server;
+    std::unique_ptr<QLocalSocket> local;
+    QString name = uniqueName("socket");
+
+    bool listen() { return server.listen(name); }
+    std::unique_ptr<QIODevice> connectRemote()
+    {
+        auto socket = std::make_unique<QLocalSocket>();
+        socket->connectToServer(name);
+        if (!socket->waitForConnected(5000))
+            return nullptr;
+        return socket;
+    }
+    bool accept()
+    {
+        if (!server.waitForNewConnection(5000))
+            return false;
+        local.reset(server.nextPendingConnection());
+        local->setParent(nullptr);
+        return local != nullptr;
+    }
+};
+
+void tst_QSharedMemoryChannel::throughput_data()
+{
+    QTest::addColumn<bool>("useLocalSocket");
+    QTest::addColumn<int>("chunkSize");
+
+    for (int chunkSize : { 64, 4096, 65536 }) {
+        QTest::addRow("channel-%d", chunkSize) << false << chunkSize;
+        QTest::addRow("localsocket-%d", chunkSize) << true << chunkSize;
+    }
+}
+
+void tst_QSharedMemoryChannel::throughput()
+{
+    QFETCH(bool, useLocalSocket);
+    QFETCH(int, chunkSize);
+
+    const QByteArray chunk(chunkSize, 'x');
+    QSemaphore go;
+    bool stop = false;
+    std::unique_ptr<QIODevice> reader;
+    std::function<std::unique_ptr<QIODevice>()> openWriter;
+    LocalSocketPair sockets;
+    const QString key = uniqueName("channel");
+
+    if (useLocalSocket) {
+        QVERIFY(sockets.listen());
+        openWriter = [&] { return sockets.connectRemote(); };
+    } else {
+        auto channel = std::make_unique<QSharedMemoryChannel>(key);
+        QVERIFY2(channel->create(1024 * 1024, QIODevice::ReadOnly),
+                 qPrintable(channel->errorString()));
+        reader = std::move(channel);
+        openWriter = [&]() -> std::unique_ptr<QIODevice> {
+            auto channel = std::make_unique<QSharedMemoryChannel>(key);
+            if (!channel->open(QIODevice::WriteOnly))
+                return nullptr;
+            return channel;
+        };
+    }
+
+    std::unique_ptr<QThread> writerThread(QThread::create([&] {
+        std::unique_ptr<QIODevice> writer = openWriter();
+        for (;;) {
+            go.acquire();
+            if (stop || !writer)
+                return;
+            for (qsizetype written = 0; written < TransferSize; written += chunkSize) {
+                if (!writeAll(writer.get(), chunk.constData(), chunkSize))
+                    return;
+            }
+            flush(writer.get());
+        }
+    }));
+    writerThread->start();
+    if (useLocalSocket) {
+        QVERIFY(sockets.accept());
+        reader = std::move(sockets.local);
+    }
+
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    QBENCHMARK {
+        go.release();
+        qsizetype received = 0;
+        while (received < TransferSize) {
+            if (!reader->bytesAvailable())
+                QVERIFY(reader->waitForReadyRead(5000));
+            const qint64 n = reader->read(buffer.data(), buffer.size());
+            QVERIFY(n >= 0);
+            received += n;
+        }
+        QCOMPARE(received, TransferSize);
+    }
+
+    stop = true;
+    go.release();
+    QVERIFY(writerThread->wait(5000));
+}
+
+void tst_QSharedMemoryChannel::roundTrip_data()
+{
+    QTest::addColumn<bool>("useLocalSocket");
+
+    QTest::newRow("channel") << false;
+    QTest::newRow("localsocket") << true;
+}
+
+void tst_QSharedMemoryChannel::roundTrip()
+{
+    QFETCH(bool, useLocalSocket);
+
+    const int MessageSize = 64;
+    const int RoundTrips = 1000;
+    std::unique_ptr<QIODevice> out;
+    std::unique_ptr<QIODevice> in;
+    std::function<void(std::unique_ptr<QIODevice> &, std::unique_ptr<QIODevice> &)> openEcho;
+    LocalSocketPair sockets;
+    const QString requestKey = uniqueName("request");
+    const QString replyKey = uniqueName("reply");
+
+    if (useLocalSocket) {
+        QVERIFY(sockets.listen());
+        openEcho = [&](std::unique_ptr<QIODevice> &echoIn, std::unique_ptr<QIODevice> &) {
+            echoIn = sockets.connectRemote();
+        };
+    } else {
+        // one channel per direction
+        auto request = std::make_unique<QSharedMemoryChannel>(requestKey);
+        QVERIFY(request->create(64 * 1024, QIODevice::WriteOnly));
+        auto reply = std::make_unique<QSharedMemoryChannel>(replyKey);
+        QVERIFY(reply->create(64 * 1024, QIODevice::ReadOnly));
+        out = std::move(request);
+        in = std::move(reply);
+        openEcho = [&](std::unique_ptr<QIODevice> &echoIn, std::unique_ptr<QIODevice> &echoOut) {
+            auto request = std::make_unique<QSharedMemoryChannel>(requestKey);
+            auto reply = std::make_unique<QSharedMemoryChannel>(replyKey);
+            if (request->open(QIODevice::ReadOnly) && reply->open(QIODevice::WriteOnly)) {
+                echoIn = std::move(request);
+                echoOut = std::move(reply);
+            }
+        };
+    }
+
+    std::unique_ptr<QThread> echoThread(QThread::create([&] {
+        std::unique_ptr<QIODevice> echoIn;
+        std::unique_ptr<QIODevice> echoOut;
+        openEcho(echoIn, echoOut);
+        if (!echoIn)
+            return;
+        QIODevice *echoWriter = echoOut ? echoOut.get() : echoIn.get();
+        char message[MessageSize];
+        while (readExactly(echoIn.get(), message, MessageSize)) {
+            if (!writeAll(echoWriter, message, MessageSize) || !flush(echoWriter))
+                return;
+        }
+    }));
+    echoThread->start();
+    if (useLocalSocket) {
+        QVERIFY(sockets.accept());
+        in = std::move(sockets.local);
+    }
+    QIODevice *writer = out ? out.get() : in.get();
+
+    char message[MessageSize] = {};
+    QBENCHMARK {
+        for (int i = 0; i < RoundTrips; ++i) {
+            QVERIFY(writeAll(writer, message, MessageSize));
+            QVERIFY(flush(writer));
+            QVERIFY(readExactly(in.get(), message, MessageSize));
+        }
+    }
+
+    // closing our end makes the echo thread's read fail
+    in.reset();
+    out.reset();
+    QVERIFY(echoThread->wait(10000));
+}
+
+QTEST_MAIN(tst_QSharedMemoryChannel)
+
+#include "main.moc"
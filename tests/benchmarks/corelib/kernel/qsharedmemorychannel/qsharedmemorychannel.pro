@@ -0,0 +1,6 @@
+TEMPLATE = app
+CONFIG += benchmark
+QT = core network testlib
+
+TARGET = tst_bench_qsharedmemorychannel
+SOURCES += main.cpp
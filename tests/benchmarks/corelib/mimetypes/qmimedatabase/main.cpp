@@ -28,6 +28,8 @@
 
 #include <QtTest/QtTest>
 
+static const char startupChildVariable[] = "QT_BENCH_MIMEDATABASE_STARTUP";
+
 class tst_QMimeDatabase: public QObject
 {
 
@@ -36,6 +38,8 @@ class tst_QMimeDatabase: public QObject
 private slots:
     void inheritsPerformance();
     void benchMimeTypeForName();
+    void benchStartup_data();
+    void benchStartup();
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -81,5 +85,63 @@ void tst_QMimeDatabase::benchMimeTypeForName()
     }
 }
 
-QTEST_MAIN(tst_QMimeDatabase)
+void tst_QMimeDatabase::benchStartup_data()
+{
+    QTest::addColumn<bool>("useCache");
+
+    QTest::newRow("xml") << false;
+    QTest::newRow("cache") << true;
+}
+
+void tst_QMimeDatabase::benchStartup()
+{
+    // Time a process doing a single lookup with the built-in database,
+    // either parsing its XML or using the cache compiled from it
+#if !QT_CONFIG(process)
+    QSKIP("This benchmark requires QProcess support");
+#else
+    QFETCH(bool, useCache);
+    // No XDG directories, so that the built-in database gets used
+    QTemporaryDir xdgDir;
+    QVERIFY2(xdgDir.isValid(), qPrintable(xdgDir.errorString()));
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(QLatin1String(startupChildVariable), QLatin1String("1"));
+    env.insert(QStringLiteral("XDG_DATA_HOME"), xdgDir.path());
+    env.insert(QStringLiteral("XDG_DATA_DIRS"), xdgDir.path());
+    env.insert(QStringLiteral("XDG_CACHE_HOME"), xdgDir.path());
+    if (useCache)
+        env.insert(QStringLiteral("QT_BUILTIN_MIME_CACHE"), QStringLiteral("1"));
+
+    QProcess process;
+    process.setProcessEnvironment(env);
+    process.setProgram(QCoreApplication::applicationFilePath());
+    const auto run = [&process]() {
+        process.start();
+        return process.waitForFinished() && process.exitStatus() == QProcess::NormalExit
+                && process.exitCode() == 0;
+    };
+    QVERIFY(run()); // writes the cache, if used
+    QBENCHMARK {
+        QVERIFY(run());
+    }
+#endif
+}
+
+static int runStartupChild()
+{
+    QMimeDatabase db;
+    const QMimeType mime = db.mimeTypeForFile(QStringLiteral("image.png"), QMimeDatabase::MatchExtension);
+    return mime.name() == QLatin1String("image/png") ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    if (qEnvironmentVariableIsSet(startupChildVariable))
+        return runStartupChild();
+    tst_QMimeDatabase tc;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&tc, argc, argv);
+}
+
 #include "main.moc"
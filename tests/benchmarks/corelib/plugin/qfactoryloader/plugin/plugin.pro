@@ -0,0 +1,7 @@
+TEMPLATE      = lib
+QT            = core
+CONFIG       += plugin
+HEADERS       = plugin.h
+SOURCES       = plugin.cpp
+TARGET        = $$qtLibraryTarget(benchplugin)
+DESTDIR       = ../bin
@@ -0,0 +1,3 @@
+TEMPLATE = subdirs
+test.depends = plugin
+SUBDIRS = plugin test
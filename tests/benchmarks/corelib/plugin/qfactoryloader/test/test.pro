@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core core-private testlib
+
+TARGET = ../tst_bench_qfactoryloader
+SOURCES += ../tst_bench_qfactoryloader.cpp
@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qtemporarydir.h>
+#include <private/qfactoryloader_p.h>
+#include <private/qpluginmetadatacache_p.h>
+
+#ifdef Q_OS_LINUX
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
+
+static const int PluginCount = 100;
+static const char interfaceId[] = "org.qt-project.Qt.benchmarks.qfactoryloader";
+
+class tst_bench_QFactoryLoader : public QObject
+{
+    Q_OBJECT
+
+    QTemporaryDir libraryPath;
+    QString pluginDir;
+    QStringList savedLibraryPaths;
+
+    void prepareCache(const QByteArray &mode);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void update_data();
+    void update();
+    void fileOpens_data() { update_data(); }
+    void fileOpens();
+};
+
+void tst_bench_QFactoryLoader::initTestCase()
+{
+    // keep the plugin metadata cache out of the user's cache directory
+    QStandardPaths::setTestModeEnabled(true);
+
+    const QDir binDir(QFINDTESTDATA("bin"));
+    QString plugin;
+    for (const QString &entry : binDir.entryList(QDir::Files)) {
+        if (QLibrary::isLibrary(entry))
+            plugin = binDir.absoluteFilePath(entry);
+    }
+    QVERIFY2(!plugin.isEmpty(), "Unable to locate the benchmark plugin");
+
+    // a directory with many plugins, as on a system with many Qt modules installed
+    QVERIFY(libraryPath.isValid());
+    pluginDir = libraryPath.path() + QLatin1String("/plugins");
+    QVERIFY(QDir().mkpath(pluginDir));
+    const QString suffix = QFileInfo(plugin).fileName();
+    for (int i = 0; i < PluginCount; ++i)
+        QVERIFY(QFile::copy(plugin, pluginDir + QString::fromLatin1("/lib%1-").arg(i) + suffix));
+
+    savedLibraryPaths = QCoreApplication::libraryPaths();
+    QCoreApplication::setLibraryPaths(QStringList(libraryPath.path()));
+}
+
+void tst_bench_QFactoryLoader::cleanupTestCase()
+{
+    QCoreApplication::setLibraryPaths(savedLibraryPaths);
+    QFile::remove(QPluginMetaDataCache::cacheFilePath(pluginDir));
+    qunsetenv("QT_NO_PLUGIN_CACHE");
+}
+
+void tst_bench_QFactoryLoader::update_data()
+{
+    QTest::addColumn<QByteArray>("mode");
+
+    QTest::newRow("no-cache") << QByteArray("no-cache");
+    QTest::newRow("cold-cache") << QByteArray("cold-cache");
+    QTest::newRow("warm-cache") << QByteArray("warm-cache");
+}
+
+void tst_bench_QFactoryLoader::prepareCache(const QByteArray &mode)
+{
+    if (mode == "no-cache") {
+        qputenv("QT_NO_PLUGIN_CACHE", "1");
+        return;
+    }
+    qunsetenv("QT_NO_PLUGIN_CACHE");
+    QFile::remove(QPluginMetaDataCache::cacheFilePath(pluginDir));
+    if (mode == "warm-cache")
+        QFactoryLoader primer(interfaceId, QLatin1String("/plugins"));
+}
+
+void tst_bench_QFactoryLoader::update()
+{
+    QFETCH(QByteArray, mode);
+
+    prepareCache(mode);
+    QBENCHMARK {
+        if (mode == "cold-cache")
+            QFile::remove(QPluginMetaDataCache::cacheFilePath(pluginDir));
+        QFactoryLoader loader(interfaceId, QLatin1String("/plugins"));
+        QCOMPARE(loader.metaData().size(), PluginCount);
+    }
+}
+
+void tst_bench_QFactoryLoader::fileOpens()
+{
+#ifdef Q_OS_LINUX
+    QFETCH(QByteArray, mode);
+
+    prepareCache(mode);
+
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    QVERIFY(fd >= 0);
+    auto closeFd = qScopeGuard([fd] { ::close(fd); });
+    QVERIFY(inotify_add_watch(fd, QFile::encodeName(pluginDir).constData(), IN_OPEN) >= 0);
+
+    {
+        QFactoryLoader loader(interfaceId, QLatin1String("/plugins"));
+        QCOMPARE(loader.metaData().size(), PluginCount);
+    }
+
+    // count the opens of the plugins, but not of the directory itself
+    int opens = 0;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + length; ) {
+            const auto event = reinterpret_cast<const inotify_event *>(p);
+            if ((event->mask & IN_OPEN) && event->len)
+                ++opens;
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+    QTest::setBenchmarkResult(opens, QTest::Events);
+#else
+    QSKIP("Counting file opens requires inotify");
+#endif
+}
+
+QTEST_MAIN(tst_bench_QFactoryLoader)
+
+#include "tst_bench_qfactoryloader.moc"
@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QBuffer>
+#include <QTest>
+#include <QXmlStreamReader>
+
+class tst_QXmlStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void read_data();
+    void read();
+};
+
+// Roughly 10 MB of XML, shaped after typical data files: either long runs
+// of character data, or many elements carrying attributes.
+static QByteArray makeDocument(bool attributeHeavy)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<catalog>\n";
+    for (int i = 0; xml.size() < 10 * 1024 * 1024; ++i) {
+        const QByteArray id = QByteArray::number(i);
+        if (attributeHeavy) {
+            xml += "  <item id=\"" + id + "\" name=\"Item number " + id
+                    + "\" category=\"hardware/tools/misc\" price=\"19.99\""
+                      " description=\"A perfectly ordinary item &amp; more\"/>\n";
+        } else {
+            xml += "  <item id=\"" + id + "\">\n    <title>Lorem ipsum dolor sit amet, "
+                   "consectetur adipiscing elit</title>\n    <body>Sed do eiusmod tempor "
+                   "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, "
+                   "quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo "
+                   "consequat &lt;" + id + "&gt;. Duis aute irure dolor in reprehenderit in "
+                   "voluptate velit esse cillum dolore eu fugiat nulla pariatur.</body>\n"
+                   "  </item>\n";
+        }
+    }
+    xml += "</catalog>\n";
+    return xml;
+}
+
+void tst_QXmlStream::read_data()
+{
+    QTest::addColumn<QByteArray>("document");
+    QTest::addColumn<bool>("fromDevice");
+
+    const QByteArray text = makeDocument(false);
+    const QByteArray attributes = makeDocument(true);
+    QTest::newRow("text-bytearray") << text << false;
+    QTest::newRow("text-device") << text << true;
+    QTest::newRow("attributes-bytearray") << attributes << false;
+    QTest::newRow("attributes-device") << attributes << true;
+}
+
+void tst_QXmlStream::read()
+{
+    QFETCH(QByteArray, document);
+    QFETCH(bool, fromDevice);
+
+    QBuffer buffer(&document);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    qint64 characters = 0;
+    QBENCHMARK {
+        QXmlStreamReader reader;
+        if (fromDevice) {
+            buffer.seek(0);
+            reader.setDevice(&buffer);
+        } else {
+            reader.addData(document);
+        }
+        characters = 0;
+        while (!reader.atEnd()) {
+            switch (reader.readNext()) {
+            case QXmlStreamReader::Characters:
+                characters += reader.text().size();
+                break;
+            case QXmlStreamReader::StartElement:
+                for (const QXmlStreamAttribute &attribute : reader.attributes())
+                    characters += attribute.value().size();
+                break;
+            default:
+                break;
+            }
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+    QVERIFY(characters > 0);
+}
+
+QTEST_MAIN(tst_QXmlStream)
+
+#include "main.moc"
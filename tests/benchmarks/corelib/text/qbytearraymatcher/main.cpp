@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QByteArrayMatcher>
+#include <QByteArrayList>
+#include <QTest>
+
+class tst_QByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexIn_data();
+    void indexIn();
+    void indexOf_data() { indexIn_data(); }
+    void indexOf();
+    void multiMatcher_data();
+    void multiMatcher();
+    void indexInEach_data() { multiMatcher_data(); }
+    void indexInEach();
+};
+
+static QByteArray text()
+{
+    static const QByteArray sample =
+            "The quick brown fox jumps over the lazy dog. Lorem ipsum dolor sit amet, "
+            "consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et "
+            "dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation "
+            "ullamco laboris nisi ut aliquip ex ea commodo consequat.\n";
+    QByteArray result;
+    while (result.size() < 1024 * 1024)
+        result += sample;
+    return result;
+}
+
+void tst_QByteArrayMatcher::indexIn_data()
+{
+    QTest::addColumn<QByteArray>("needle");
+
+    // not in the text, so that all of it gets searched
+    const QByteArray needles = "Duis aute irure dolor in reprehenderit in voluptate velit esse "
+                               "cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat "
+                               "cupidatat non proident, sunt in culpa qui officia deserunt mollit "
+                               "anim id est laborum. Sed ut perspiciatis unde omnis iste natus";
+    for (int length : { 2, 4, 8, 16, 32, 64, 128, 256 })
+        QTest::addRow("%d", length) << needles.left(length);
+}
+
+void tst_QByteArrayMatcher::indexIn()
+{
+    QFETCH(QByteArray, needle);
+    const QByteArray haystack = text();
+    const QByteArrayMatcher matcher(needle);
+
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QByteArrayMatcher::indexOf()
+{
+    QFETCH(QByteArray, needle);
+    const QByteArray haystack = text();
+
+    QBENCHMARK {
+        QCOMPARE(haystack.indexOf(needle), -1);
+    }
+}
+
+void tst_QByteArrayMatcher::multiMatcher_data()
+{
+    QTest::addColumn<QByteArrayList>("patterns");
+
+    const QByteArrayList words = QByteArray("reprehenderit voluptate cillum fugiat pariatur "
+                                            "Excepteur occaecat cupidatat proident officia "
+                                            "deserunt mollit laborum perspiciatis").split(' ');
+    for (int count : { 2, 4, 8, 16 })
+        QTest::addRow("%d", count) << words.mid(0, count);
+    QByteArrayList manyWords;
+    for (int i = 0; i < 64; ++i)
+        manyWords.append(words.at(i % words.size()) + QByteArray::number(i));
+    QTest::addRow("64") << manyWords;
+}
+
+void tst_QByteArrayMatcher::multiMatcher()
+{
+    QFETCH(QByteArrayList, patterns);
+    const QByteArray haystack = text();
+    const QMultiByteArrayMatcher matcher(patterns);
+
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QByteArrayMatcher::indexInEach()
+{
+    QFETCH(QByteArrayList, patterns);
+    const QByteArray haystack = text();
+    QList<QByteArrayMatcher> matchers;
+    for (const QByteArray &pattern : qAsConst(patterns))
+        matchers.append(QByteArrayMatcher(pattern));
+
+    QBENCHMARK {
+        qsizetype first = -1;
+        for (const QByteArrayMatcher &matcher : qAsConst(matchers)) {
+            const qsizetype pos = matcher.indexIn(haystack);
+            if (pos >= 0 && (first < 0 || pos < first))
+                first = pos;
+        }
+        QCOMPARE(first, -1);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
+
+#include "main.moc"
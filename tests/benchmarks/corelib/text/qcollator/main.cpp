@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCollator>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+
+class tst_QCollator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sort_data();
+    void compareSort();
+    void compareSort_data() { sort_data(); }
+    void sortKeySort();
+    void sortKeySort_data() { sort_data(); }
+    void sort();
+};
+
+// Words of lower- and upper-case letters, some accented, and digits:
+static QStringList words(int count)
+{
+    static const char16_t letters[] = u"abcdefghijklmnopqrstuvwxyzABCDEFGHIJäöüéå0123456789";
+    QRandomGenerator generator(4711);
+    QStringList result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QString word(3 + generator.bounded(10), Qt::Uninitialized);
+        for (QChar &ch : word)
+            ch = letters[generator.bounded(int(std::size(letters)) - 1)];
+        result << word;
+    }
+    return result;
+}
+
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QStringList>("strings");
+
+    QTest::newRow("10k") << words(10000);
+    QTest::newRow("200k") << words(200000);
+}
+
+void tst_QCollator::compareSort()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+    QBENCHMARK {
+        QStringList copy = strings;
+        std::sort(copy.begin(), copy.end(), collator);
+    }
+}
+
+void tst_QCollator::sortKeySort()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+    QBENCHMARK {
+        QList<std::pair<QCollatorSortKey, QString>> keyed;
+        keyed.reserve(strings.size());
+        for (const QString &string : qAsConst(strings))
+            keyed.append({ collator.sortKey(string), string });
+        std::sort(keyed.begin(), keyed.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.first < rhs.first;
+        });
+    }
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+    QBENCHMARK {
+        QStringList copy = strings;
+        collator.sort(copy);
+    }
+}
+
+QTEST_MAIN(tst_QCollator)
+
+#include "main.moc"
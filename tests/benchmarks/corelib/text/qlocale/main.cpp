@@ -54,6 +54,12 @@ private Q_SLOTS:
     void toUpper_QLocale_2();
     void toUpper_QString();
     void number_QString();
+    void toDouble_data();
+    void toDouble();
+    void toDouble_QByteArray_data();
+    void toDouble_QByteArray();
+    void number_QString_double_data();
+    void number_QString_double();
 };
 
 static QString data()
@@ -392,6 +398,67 @@ void tst_QLocale::number_QString()
     }
 }
 
+static void addDoubleRows()
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("integer") << QStringLiteral("123456");
+    QTest::newRow("negative") << QStringLiteral("-42.125");
+    QTest::newRow("decimal") << QStringLiteral("3.14159265");
+    QTest::newRow("exponent") << QStringLiteral("6.02214076e23");
+    QTest::newRow("small-exponent") << QStringLiteral("1.5e-7");
+    QTest::newRow("long") << QStringLiteral("0.1000000000000000055511151231257827");
+}
+
+void tst_QLocale::toDouble_data()
+{
+    addDoubleRows();
+}
+
+void tst_QLocale::toDouble()
+{
+    QFETCH(QString, text);
+    double d = 0;
+    QBENCHMARK { LOOP(d += text.toDouble()) }
+    QVERIFY(d != 0);
+}
+
+void tst_QLocale::toDouble_QByteArray_data()
+{
+    addDoubleRows();
+}
+
+void tst_QLocale::toDouble_QByteArray()
+{
+    QFETCH(QString, text);
+    const QByteArray latin1 = text.toLatin1();
+    double d = 0;
+    QBENCHMARK { LOOP(d += latin1.toDouble()) }
+    QVERIFY(d != 0);
+}
+
+void tst_QLocale::number_QString_double_data()
+{
+    QTest::addColumn<double>("value");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+
+    QTest::newRow("shortest-g") << 3.14159265 << 'g' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("g6") << 3.14159265 << 'g' << 6;
+    QTest::newRow("f2") << 123456.789 << 'f' << 2;
+    QTest::newRow("e6") << 6.02214076e23 << 'e' << 6;
+}
+
+void tst_QLocale::number_QString_double()
+{
+    QFETCH(double, value);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    QString s;
+    QBENCHMARK { LOOP(s = QString::number(value, format, precision)) }
+    QVERIFY(!s.isEmpty());
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "main.moc"
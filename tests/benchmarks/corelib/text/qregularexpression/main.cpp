@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTest>
+
+class tst_QRegularExpression : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct();
+    void match_data();
+    void match();
+    void classify_data();
+    void classify();
+};
+
+static QStringList logLines()
+{
+    static const char *const templates[] = {
+        "2020-06-01 12:00:%1 INFO request served in %1 ms",
+        "2020-06-01 12:00:%1 DEBUG cache hit for key user/%1",
+        "2020-06-01 12:00:%1 WARNING slow query took %1 ms",
+        "2020-06-01 12:00:%1 ERROR connection to db%1 timed out",
+    };
+    QStringList lines;
+    for (int i = 0; i < 4000; ++i)
+        lines << QString::fromLatin1(templates[i % 4]).arg(i % 60);
+    return lines;
+}
+
+static QStringList classificationRules()
+{
+    return {
+        QStringLiteral("\\bERROR\\b.*timed out"),
+        QStringLiteral("\\bERROR\\b"),
+        QStringLiteral("\\bWARNING\\b.*slow query"),
+        QStringLiteral("\\bWARNING\\b"),
+        QStringLiteral("cache (hit|miss)"),
+        QStringLiteral("served in \\d+ ms"),
+        QStringLiteral("\\bFATAL\\b"),
+        QStringLiteral("out of memory"),
+    };
+}
+
+void tst_QRegularExpression::construct()
+{
+    // Constructing the same pattern over and over again, as happens
+    // in loops and when patterns are copied across threads.
+    const QString pattern = QStringLiteral("^(\\d{4})-(\\d{2})-(\\d{2}) (\\d{2}):(\\d{2}):(\\d{2})");
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            QRegularExpression re(pattern);
+            re.optimize();
+        }
+    }
+}
+
+void tst_QRegularExpression::match_data()
+{
+    QTest::addColumn<QString>("pattern");
+
+    QTest::newRow("literal") << QStringLiteral("timed out");
+    QTest::newRow("captures") << QStringLiteral("^(\\S+) (\\S+) (\\w+) (.*)$");
+}
+
+void tst_QRegularExpression::match()
+{
+    QFETCH(QString, pattern);
+    const QStringList lines = logLines();
+    const QRegularExpression re(pattern);
+    re.optimize();
+
+    int matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &line : lines)
+            matches += re.match(line).hasMatch();
+    }
+    QVERIFY(matches > 0);
+}
+
+void tst_QRegularExpression::classify_data()
+{
+    QTest::addColumn<bool>("useSet");
+
+    QTest::newRow("one-by-one") << false;
+    QTest::newRow("QRegularExpressionSet") << true;
+}
+
+void tst_QRegularExpression::classify()
+{
+    QFETCH(bool, useSet);
+    const QStringList lines = logLines();
+    const QStringList rules = classificationRules();
+
+    QList<QRegularExpression> expressions;
+    for (const QString &rule : rules) {
+        expressions << QRegularExpression(rule);
+        expressions.last().optimize();
+    }
+    const QRegularExpressionSet set(rules);
+
+    qsizetype classified = 0;
+    QBENCHMARK {
+        classified = 0;
+        for (const QString &line : lines) {
+            if (useSet) {
+                classified += set.matchingPattern(line) >= 0;
+                continue;
+            }
+            // earliest match wins, as with QRegularExpressionSet
+            qsizetype bestStart = -1;
+            for (const QRegularExpression &re : qAsConst(expressions)) {
+                const QRegularExpressionMatch m = re.match(line);
+                if (m.hasMatch() && (bestStart < 0 || m.capturedStart() < bestStart))
+                    bestStart = m.capturedStart();
+            }
+            classified += bestStart >= 0;
+        }
+    }
+    QCOMPARE(classified, lines.size());
+}
+
+QTEST_MAIN(tst_QRegularExpression)
+
+#include "main.moc"
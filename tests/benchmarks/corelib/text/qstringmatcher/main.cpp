@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QStringMatcher>
+#include <QStringList>
+#include <QTest>
+
+class tst_QStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexIn_data();
+    void indexIn();
+    void indexOf_data() { indexIn_data(); }
+    void indexOf();
+    void multiMatcher_data();
+    void multiMatcher();
+    void indexInEach_data() { multiMatcher_data(); }
+    void indexInEach();
+};
+
+static QString text()
+{
+    static const QString sample = QStringLiteral(
+            "The quick brown fox jumps over the lazy dog. Lorem ipsum dolor sit amet, "
+            "consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et "
+            "dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation "
+            "ullamco laboris nisi ut aliquip ex ea commodo consequat.\n");
+    QString result;
+    while (result.size() < 1024 * 1024)
+        result += sample;
+    return result;
+}
+
+void tst_QStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    // not in the text, so that all of it gets searched
+    const QString needles = QStringLiteral(
+            "Duis aute irure dolor in reprehenderit in voluptate velit esse "
+            "cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat "
+            "cupidatat non proident, sunt in culpa qui officia deserunt mollit "
+            "anim id est laborum. Sed ut perspiciatis unde omnis iste natus");
+    for (int length : { 2, 4, 8, 16, 32, 64, 128, 256 })
+        QTest::addRow("%d", length) << needles.left(length) << Qt::CaseSensitive;
+    for (int length : { 4, 32 })
+        QTest::addRow("%d-insensitive", length) << needles.left(length) << Qt::CaseInsensitive;
+}
+
+void tst_QStringMatcher::indexIn()
+{
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QString haystack = text();
+    const QStringMatcher matcher(needle, cs);
+
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QStringMatcher::indexOf()
+{
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QString haystack = text();
+
+    QBENCHMARK {
+        QCOMPARE(haystack.indexOf(needle, 0, cs), -1);
+    }
+}
+
+void tst_QStringMatcher::multiMatcher_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QStringList words = QStringLiteral("reprehenderit voluptate cillum fugiat pariatur "
+                                             "Excepteur occaecat cupidatat proident officia "
+                                             "deserunt mollit laborum perspiciatis").split(u' ');
+    for (int count : { 2, 4, 8, 16 })
+        QTest::addRow("%d", count) << words.mid(0, count) << Qt::CaseSensitive;
+    QTest::addRow("16-insensitive") << words << Qt::CaseInsensitive;
+    QStringList manyWords;
+    for (int i = 0; i < 64; ++i)
+        manyWords.append(words.at(i % words.size()) + QString::number(i));
+    QTest::addRow("64") << manyWords << Qt::CaseSensitive;
+}
+
+void tst_QStringMatcher::multiMatcher()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QString haystack = text();
+    const QMultiStringMatcher matcher(patterns, cs);
+
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QStringMatcher::indexInEach()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QString haystack = text();
+    QList<QStringMatcher> matchers;
+    for (const QString &pattern : qAsConst(patterns))
+        matchers.append(QStringMatcher(pattern, cs));
+
+    QBENCHMARK {
+        qsizetype first = -1;
+        for (const QStringMatcher &matcher : qAsConst(matchers)) {
+            const qsizetype pos = matcher.indexIn(haystack);
+            if (pos >= 0 && (first < 0 || pos < first))
+                first = pos;
+        }
+        QCOMPARE(first, -1);
+    }
+}
+
+QTEST_MAIN(tst_QStringMatcher)
+
+#include "main.moc"
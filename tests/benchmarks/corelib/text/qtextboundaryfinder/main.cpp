@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTextBoundaryFinder>
+#include <QTest>
+
+class tst_QTextBoundaryFinder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void segment_data();
+    void segment();
+};
+
+static QString repeated(QStringView text, int size)
+{
+    QString result;
+    result.reserve(size + text.size());
+    while (result.size() < size)
+        result += text;
+    return result;
+}
+
+void tst_QTextBoundaryFinder::segment_data()
+{
+    QTest::addColumn<QTextBoundaryFinder::BoundaryType>("type");
+    QTest::addColumn<QString>("text");
+
+    const struct {
+        const char *name;
+        QStringView text;
+    } samples[] = {
+        { "english", u"The quick brown fox jumps over the lazy dog. It's 10:45, and 3.5% of "
+                     "the \"users\" (about 1,200) replied: e-mail me at fox@example.com!\n" },
+        { "latin1", u"Der Bär läuft über die Straße. Où est la crème brûlée? "
+                    "Ångström, façade, naïve, señor, Ærø; 12½ €? No: £3.\n" },
+        { "cjk", u"日本語のテキストは単語の間に空白を置きません。中文也是如此。한국어 문장은 띄어쓰기를 합니다.\n" },
+        { "devanagari", u"हिन्दी भारत की राजभाषा है। यह देवनागरी लिपि में लिखी जाती है।\n" },
+        { "emoji", u"Hi 👋🏽 family: 👨‍👩‍👧 flags 🇩🇪🇳🇴 done ✔️\n" },
+    };
+    const struct {
+        const char *name;
+        QTextBoundaryFinder::BoundaryType type;
+    } types[] = {
+        { "grapheme", QTextBoundaryFinder::Grapheme },
+        { "word", QTextBoundaryFinder::Word },
+        { "sentence", QTextBoundaryFinder::Sentence },
+        { "line", QTextBoundaryFinder::Line },
+    };
+
+    for (const auto &sample : samples) {
+        const QString text = repeated(sample.text, 64 * 1024);
+        for (const auto &type : types)
+            QTest::addRow("%s-%s", sample.name, type.name) << type.type << text;
+    }
+}
+
+void tst_QTextBoundaryFinder::segment()
+{
+    QFETCH(QTextBoundaryFinder::BoundaryType, type);
+    QFETCH(QString, text);
+
+    QBENCHMARK {
+        QTextBoundaryFinder finder(type, text);
+        int boundaries = 0;
+        while (finder.toNextBoundary() != -1)
+            ++boundaries;
+        QVERIFY(boundaries > 0);
+    }
+}
+
+QTEST_MAIN(tst_QTextBoundaryFinder)
+
+#include "main.moc"
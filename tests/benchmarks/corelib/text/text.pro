@@ -1,9 +1,14 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         qbytearray \
+        qbytearraymatcher \
         qchar \
+        qcollator \
         qlocale \
+        qregularexpression \
         qstringbuilder \
-        qstringlist
+        qstringlist \
+        qstringmatcher \
+        qtextboundaryfinder
 
 *g++*: SUBDIRS += qstring
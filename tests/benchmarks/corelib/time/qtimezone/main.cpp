@@ -49,6 +49,10 @@ private Q_SLOTS:
     void transitionsForward();
     void transitionsReverse_data() { transitionList_data(); }
     void transitionsReverse();
+    void offsetFromUtc_data() { transitionList_data(); }
+    void offsetFromUtc();
+    void offsetsFromUtc_data() { transitionList_data(); }
+    void offsetsFromUtc();
 };
 
 static QList<QByteArray> enoughZones()
@@ -161,6 +165,38 @@ void tst_QTimeZone::transitionsReverse()
     }
 }
 
+// Ascending times, a few minutes apart, as found in a log spanning a year:
+static QList<qint64> logTimes()
+{
+    QList<qint64> result;
+    const qint64 start = QDate(2020, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    for (qint64 i = 0; i < 100000; ++i)
+        result << start + i * 315 * 1000 + i % 997;
+    return result;
+}
+
+void tst_QTimeZone::offsetFromUtc()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<qint64> times = logTimes();
+    QBENCHMARK {
+        for (qint64 msecs : times)
+            zone.offsetFromUtc(QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC));
+    }
+}
+
+void tst_QTimeZone::offsetsFromUtc()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<qint64> times = logTimes();
+    QList<int> offsets(times.size());
+    QBENCHMARK {
+        zone.offsetsFromUtc(times.constData(), offsets.data(), times.size());
+    }
+}
+
 QTEST_MAIN(tst_QTimeZone)
 
 #include "main.moc"
@@ -0,0 +1,141 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QBitArray>
+#include <QRandomGenerator>
+#include <QTest>
+
+class tst_QBitArray : public QObject
+{
+    Q_OBJECT
+private slots:
+    void logicalOperators_data();
+    void logicalOperators();
+    void invert_data() { logicalOperators_data(); }
+    void invert();
+    void countBits_data() { logicalOperators_data(); }
+    void countBits();
+    void fill_data() { logicalOperators_data(); }
+    void fill();
+    void iterateSetBits_data();
+    void iterateSetBits();
+};
+
+static QBitArray randomBitArray(qsizetype size, int oneIn = 2)
+{
+    QRandomGenerator rng(size);
+    QBitArray ba(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        if (rng.bounded(oneIn) == 0)
+            ba.setBit(i);
+    }
+    return ba;
+}
+
+void tst_QBitArray::logicalOperators_data()
+{
+    QTest::addColumn<qsizetype>("size");
+
+    QTest::newRow("100") << qsizetype(100);
+    QTest::newRow("10k") << qsizetype(10'000);
+    QTest::newRow("1M") << qsizetype(1'000'000);
+    QTest::newRow("64M") << qsizetype(64'000'000);
+}
+
+void tst_QBitArray::logicalOperators()
+{
+    QFETCH(qsizetype, size);
+    QBitArray a = randomBitArray(size);
+    const QBitArray b = randomBitArray(size + 1);
+
+    QBENCHMARK {
+        a &= b;
+        a |= b;
+        a ^= b;
+    }
+}
+
+void tst_QBitArray::invert()
+{
+    QFETCH(qsizetype, size);
+    const QBitArray a = randomBitArray(size);
+
+    QBENCHMARK {
+        const QBitArray inverted = ~a;
+        Q_UNUSED(inverted);
+    }
+}
+
+void tst_QBitArray::countBits()
+{
+    QFETCH(qsizetype, size);
+    const QBitArray a = randomBitArray(size);
+
+    qsizetype count = 0;
+    QBENCHMARK {
+        count += a.count(true);
+    }
+    QVERIFY(count > 0);
+}
+
+void tst_QBitArray::fill()
+{
+    QFETCH(qsizetype, size);
+    QBitArray a(size);
+
+    QBENCHMARK {
+        a.fill(true, 3, size - 3);
+        a.fill(false, 5, size - 5);
+    }
+}
+
+void tst_QBitArray::iterateSetBits_data()
+{
+    QTest::addColumn<int>("oneIn");
+
+    QTest::newRow("dense") << 2;
+    QTest::newRow("1/100") << 100;
+    QTest::newRow("1/10000") << 10'000;
+}
+
+void tst_QBitArray::iterateSetBits()
+{
+    QFETCH(int, oneIn);
+    const QBitArray a = randomBitArray(10'000'000, oneIn);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (qsizetype i = a.findNextSetBit(); i != -1; i = a.findNextSetBit(i + 1))
+            ++found;
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QBitArray)
+
+#include "main.moc"
@@ -28,9 +28,12 @@
 
 #include <QByteArray>
 #include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QtTest>
 
 #include <time.h>
@@ -50,9 +53,15 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void throughput_data();
+    void throughput();
+    void hashMany_data();
+    void hashMany();
+    void parallel_data();
+    void parallel();
 };
 
-const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
+const int MaxCryptoAlgorithm = QCryptographicHash::Blake2sp_256;
 const int MaxBlockSize = 65536;
 
 const char *algoname(int i)
@@ -88,6 +97,26 @@ const char *algoname(int i)
         return "keccak_384-";
     case QCryptographicHash::Keccak_512:
         return "keccak_512-";
+    case QCryptographicHash::Blake2b_160:
+        return "blake2b_160-";
+    case QCryptographicHash::Blake2b_256:
+        return "blake2b_256-";
+    case QCryptographicHash::Blake2b_384:
+        return "blake2b_384-";
+    case QCryptographicHash::Blake2b_512:
+        return "blake2b_512-";
+    case QCryptographicHash::Blake2s_128:
+        return "blake2s_128-";
+    case QCryptographicHash::Blake2s_160:
+        return "blake2s_160-";
+    case QCryptographicHash::Blake2s_224:
+        return "blake2s_224-";
+    case QCryptographicHash::Blake2s_256:
+        return "blake2s_256-";
+    case QCryptographicHash::Blake2bp_512:
+        return "blake2bp_512-";
+    case QCryptographicHash::Blake2sp_256:
+        return "blake2sp_256-";
     }
     Q_UNREACHABLE();
     return 0;
@@ -167,6 +196,130 @@ void tst_bench_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_bench_QCryptographicHash::throughput_data()
+{
+    QTest::addColumn<int>("algorithm");
+
+    for (int algo = QCryptographicHash::Md4; algo <= MaxCryptoAlgorithm; ++algo) {
+        QByteArray name = algoname(algo);
+        name.chop(1);
+        QTest::newRow(name) << algo;
+    }
+}
+
+void tst_bench_QCryptographicHash::throughput()
+{
+    QFETCH(int, algorithm);
+
+    // feed whole blocks for a while and report the sustained hashing speed
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QCryptographicHash hash(algo);
+    qint64 bytes = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        for (int i = 0; i < 16; ++i)
+            hash.addData(blockOfData);
+        bytes += 16 * blockOfData.size();
+    } while (timer.elapsed() < 500);
+    hash.result();
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QTest::setBenchmarkResult(bytes * 1e9 / elapsed, QTest::BytesPerSecond);
+}
+
+void tst_bench_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("batch");
+
+    for (int algo : { QCryptographicHash::Sha1, QCryptographicHash::Sha256 }) {
+        for (int size : { 16, 64, 256 }) {
+            const QByteArray name = algoname(algo) + QByteArray::number(size);
+            QTest::newRow(name + "-loop") << algo << size << false;
+            QTest::newRow(name + "-hashMany") << algo << size << true;
+        }
+    }
+}
+
+void tst_bench_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(int, size);
+    QFETCH(bool, batch);
+
+    // many short messages, e.g. keys or records
+    QByteArrayList data;
+    for (int i = 0; i < 1000; ++i)
+        data.append(QByteArray::fromRawData(blockOfData.constData() + (i * 61) % (MaxBlockSize - size), size));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    if (batch) {
+        QBENCHMARK {
+            QCryptographicHash::hashMany(data, algo);
+        }
+    } else {
+        QBENCHMARK {
+            for (const QByteArray &message : data)
+                QCryptographicHash::hash(message, algo);
+        }
+    }
+}
+
+void tst_bench_QCryptographicHash::parallel_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<bool>("merkleTree");
+    QTest::addColumn<int>("threads");
+
+    const struct {
+        QCryptographicHash::Algorithm algorithm;
+        bool merkleTree;
+    } modes[] = {
+        { QCryptographicHash::Blake2b_512, false }, // sequential, for comparison
+        { QCryptographicHash::Blake2bp_512, false },
+        { QCryptographicHash::Blake2sp_256, false },
+        { QCryptographicHash::Sha256, true },
+    };
+    for (const auto &mode : modes) {
+        for (int threads : { 1, 2, 4, 8 }) {
+            QByteArray name = algoname(mode.algorithm);
+            if (mode.merkleTree)
+                name.prepend("merkle-");
+            QTest::newRow(name + "pool" + QByteArray::number(threads))
+                    << int(mode.algorithm) << mode.merkleTree << threads;
+        }
+    }
+}
+
+void tst_bench_QCryptographicHash::parallel()
+{
+    QFETCH(int, algorithm);
+    QFETCH(bool, merkleTree);
+    QFETCH(int, threads);
+
+    // a 64 MB file, hashed from a memory mapping
+    static QTemporaryFile file;
+    if (!file.isOpen()) {
+        QVERIFY(file.open());
+        for (int i = 0; i < 1024; ++i)
+            QCOMPARE(file.write(blockOfData), qint64(blockOfData.size()));
+        QVERIFY(file.flush());
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        if (merkleTree)
+            QCryptographicHash::merkleTreeHash(&file, algo, 1024 * 1024, &pool);
+        else
+            QCryptographicHash::hashParallel(&file, algo, &pool);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_bench_QCryptographicHash)
 
 #include "main.moc"
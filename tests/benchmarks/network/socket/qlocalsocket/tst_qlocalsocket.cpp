@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qglobal.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtNetwork/qlocalserver.h>
+#include <QtNetwork/qlocalsocket.h>
+
+class tst_QLocalSocket : public QObject
+{
+    Q_OBJECT
+public:
+    tst_QLocalSocket();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void writeByteArrays_data();
+    void writeByteArrays();
+    void handOverPayload_data();
+    void handOverPayload();
+
+private:
+    QLocalServer server;
+    QLocalSocket client;
+    QLocalSocket *serverSocket = nullptr;
+};
+
+tst_QLocalSocket::tst_QLocalSocket()
+{
+}
+
+void tst_QLocalSocket::init()
+{
+    QLocalServer::removeServer("tst_bench_qlocalsocket");
+    QVERIFY(server.listen("tst_bench_qlocalsocket"));
+    client.connectToServer(server.serverName());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection());
+    serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+    serverSocket->setDescriptorReceivingEnabled(true);
+}
+
+void tst_QLocalSocket::cleanup()
+{
+    client.abort();
+    delete serverSocket;
+    serverSocket = nullptr;
+    server.close();
+}
+
+// Consecutive write() calls leave one chunk per byte array in the write
+// buffer; how many system calls it takes to send them is what is measured.
+void tst_QLocalSocket::writeByteArrays_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<int>("blockCount");
+    QTest::addRow("16x4K") << 4096 << 16;
+    QTest::addRow("16x16K") << 16 * 1024 << 16;
+    QTest::addRow("64x16K") << 16 * 1024 << 64;
+    QTest::addRow("16x64K") << 64 * 1024 << 16;
+}
+
+void tst_QLocalSocket::writeByteArrays()
+{
+    QFETCH(int, blockSize);
+    QFETCH(int, blockCount);
+
+    QList<QByteArray> blocks;
+    for (int i = 0; i < blockCount; ++i)
+        blocks.append(QByteArray(blockSize, char('a' + i % 26)));
+    const qint64 total = qint64(blockSize) * blockCount;
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+
+    QBENCHMARK {
+        for (const QByteArray &block : qAsConst(blocks))
+            client.write(block);
+        qint64 received = 0;
+        while (received < total) {
+            client.flush();
+            if (!serverSocket->bytesAvailable())
+                QVERIFY(serverSocket->waitForReadyRead());
+            qint64 r;
+            while ((r = serverSocket->read(buffer.data(), buffer.size())) > 0)
+                received += r;
+        }
+    }
+}
+
+// Getting a large payload to the other side: copying it through the
+// socket, or passing the descriptor of a file holding it and mapping that.
+void tst_QLocalSocket::handOverPayload_data()
+{
+    QTest::addColumn<bool>("passDescriptor");
+    QTest::addColumn<int>("size");
+    for (int size : {64 * 1024, 1024 * 1024, 16 * 1024 * 1024}) {
+        QTest::addRow("copy-%dK", size / 1024) << false << size;
+        QTest::addRow("descriptor-%dK", size / 1024) << true << size;
+    }
+}
+
+void tst_QLocalSocket::handOverPayload()
+{
+    QFETCH(bool, passDescriptor);
+    QFETCH(int, size);
+
+    const QByteArray payload(size, 'p');
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(payload), qint64(size));
+    QVERIFY(file.flush());
+
+    if (passDescriptor) {
+        // This only checks for support; the descriptor received is dropped.
+        if (client.writeDescriptors("x", { file.handle() }) < 0)
+            QSKIP("Passing descriptors is not supported on this platform");
+        QVERIFY(serverSocket->waitForReadyRead());
+        serverSocket->readAll();
+        const QList<qintptr> descriptors = serverSocket->readDescriptors();
+        QCOMPARE(descriptors.size(), 1);
+        QFile received;
+        QVERIFY(received.open(int(descriptors.at(0)), QIODevice::ReadOnly,
+                              QFile::AutoCloseHandle));
+    }
+
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    qint64 checksum = 0;
+    QBENCHMARK {
+        if (passDescriptor) {
+            client.writeDescriptors("x", { file.handle() });
+            if (!serverSocket->bytesAvailable())
+                QVERIFY(serverSocket->waitForReadyRead());
+            char c;
+            QVERIFY(serverSocket->getChar(&c));
+            const QList<qintptr> descriptors = serverSocket->readDescriptors();
+            QCOMPARE(descriptors.size(), 1);
+
+            QFile received;
+            QVERIFY(received.open(int(descriptors.at(0)), QIODevice::ReadOnly,
+                                  QFile::AutoCloseHandle));
+            const uchar *data = received.map(0, size);
+            QVERIFY(data);
+            checksum += data[0] + data[size - 1];
+            received.unmap(const_cast<uchar *>(data));
+        } else {
+            client.write(payload);
+            qint64 received = 0;
+            while (received < size) {
+                client.flush();
+                if (!serverSocket->bytesAvailable())
+                    QVERIFY(serverSocket->waitForReadyRead());
+                qint64 r;
+                while ((r = serverSocket->read(buffer.data(), buffer.size())) > 0) {
+                    checksum += buffer.at(0) + buffer.at(r - 1);
+                    received += r;
+                }
+            }
+        }
+    }
+    QVERIFY(checksum != 0);
+}
+
+QTEST_MAIN(tst_QLocalSocket)
+
+#include "tst_qlocalsocket.moc"
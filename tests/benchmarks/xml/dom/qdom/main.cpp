@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QDomDocument>
+#include <QTest>
+
+#ifdef __GLIBC__
+#  if __GLIBC_PREREQ(2, 33)
+#    include <malloc.h>
+#    define HAVE_MALLINFO2
+#  endif
+#endif
+
+class tst_QDom : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void setContent_data();
+    void setContent();
+    void traverse_data();
+    void traverse();
+    void memoryUsage_data();
+    void memoryUsage();
+
+private:
+    static QByteArray makeDocument(int records);
+    static int countNodes(const QDomNode &node);
+};
+
+// A record-oriented document with the same few element and attribute
+// names repeated over and over, as found in typical data exports.
+QByteArray tst_QDom::makeDocument(int records)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<db:records xmlns:db=\"urn:example:db\">\n";
+    for (int i = 0; i < records; ++i) {
+        const QByteArray id = QByteArray::number(i);
+        xml += "  <db:record db:id=\"" + id + "\" kind=\"entry\" state=\"active\">\n"
+               "    <db:name>Record " + id + "</db:name>\n"
+               "    <db:value unit=\"ms\">" + QByteArray::number(i * 7 % 1000) + "</db:value>\n"
+               "  </db:record>\n";
+    }
+    xml += "</db:records>\n";
+    return xml;
+}
+
+void tst_QDom::setContent_data()
+{
+    QTest::addColumn<QByteArray>("document");
+    QTest::addColumn<bool>("namespaceProcessing");
+
+    const QByteArray small = makeDocument(1000);
+    const QByteArray large = makeDocument(100000);
+    QTest::newRow("small") << small << false;
+    QTest::newRow("small-namespaces") << small << true;
+    QTest::newRow("large") << large << false;
+    QTest::newRow("large-namespaces") << large << true;
+}
+
+void tst_QDom::setContent()
+{
+    QFETCH(QByteArray, document);
+    QFETCH(bool, namespaceProcessing);
+
+    QBENCHMARK {
+        QDomDocument doc;
+        QString error;
+        QVERIFY2(doc.setContent(document, namespaceProcessing, &error), qPrintable(error));
+    }
+}
+
+void tst_QDom::traverse_data()
+{
+    setContent_data();
+}
+
+void tst_QDom::traverse()
+{
+    QFETCH(QByteArray, document);
+    QFETCH(bool, namespaceProcessing);
+
+    QDomDocument doc;
+    QString error;
+    QVERIFY2(doc.setContent(document, namespaceProcessing, &error), qPrintable(error));
+
+    int elements = 0;
+    QBENCHMARK {
+        elements = 0;
+        QDomElement record = doc.documentElement().firstChildElement();
+        while (!record.isNull()) {
+            for (QDomElement child = record.firstChildElement(); !child.isNull();
+                 child = child.nextSiblingElement()) {
+                if (!child.text().isEmpty())
+                    ++elements;
+            }
+            record = record.nextSiblingElement();
+        }
+    }
+    QVERIFY(elements > 0);
+}
+
+int tst_QDom::countNodes(const QDomNode &node)
+{
+    int count = 1;
+    const QDomNamedNodeMap attributes = node.attributes();
+    for (int i = 0; i < attributes.length(); ++i)
+        count += countNodes(attributes.item(i));
+    for (QDomNode child = node.firstChild(); !child.isNull(); child = child.nextSibling())
+        count += countNodes(child);
+    return count;
+}
+
+void tst_QDom::memoryUsage_data()
+{
+    setContent_data();
+}
+
+// Reports the heap a loaded document keeps, per node, counting attributes
+// and text nodes. The source buffer and the parser are gone by then.
+void tst_QDom::memoryUsage()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(QByteArray, document);
+    QFETCH(bool, namespaceProcessing);
+
+    const size_t before = mallinfo2().uordblks;
+    QDomDocument doc;
+    QString error;
+    QVERIFY2(doc.setContent(document, namespaceProcessing, &error), qPrintable(error));
+    const size_t after = mallinfo2().uordblks;
+
+    const int nodes = countNodes(doc);
+    QTest::setBenchmarkResult(qreal(after - before) / nodes, QTest::BytesAllocated);
+#else
+    QSKIP("This test needs mallinfo2() to measure the heap");
+#endif
+}
+
+QTEST_MAIN(tst_QDom)
+
+#include "main.moc"
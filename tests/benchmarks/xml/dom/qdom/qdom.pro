@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core xml testlib
+
+TARGET = tst_bench_qdom
+SOURCES += main.cpp